@@ -0,0 +1,29 @@
+# FFT is performed in single precision, find the single precision FFTW library
+find_library(FFTW_LIBRARY fftw3f
+             HINTS ENV FFTW_LINK)
+
+get_filename_component(_fftw_lib_dir ${FFTW_LIBRARY} DIRECTORY)
+
+# the threaded library is optional
+find_library(FFTW_THREADS_LIBRARY fftw3f_threads
+             HINTS ENV FFTW_LINK
+             HINTS ${_fftw_lib_dir})
+
+find_path(FFTW_INCLUDE_DIR fftw3.h
+          HINTS ENV FFTW_INC
+          HINTS ${_fftw_lib_dir}/../include)
+
+# handle the QUIETLY and REQUIRED arguments and set FFTW_FOUND to TRUE if
+# all listed variables are TRUE
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(FFTW
+                                  REQUIRED_VARS FFTW_LIBRARY FFTW_INCLUDE_DIR)
+
+if(FFTW_FOUND)
+  set(FFTW_LIBRARIES ${FFTW_LIBRARY})
+  if (FFTW_THREADS_LIBRARY)
+    set(FFTW_LIBRARIES ${FFTW_THREADS_LIBRARY} ${FFTW_LIBRARIES})
+  endif()
+endif()
+
+mark_as_advanced(FFTW_LIBRARY FFTW_THREADS_LIBRARY FFTW_INCLUDE_DIR)
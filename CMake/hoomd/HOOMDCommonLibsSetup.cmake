@@ -25,12 +25,28 @@ if (TBB_USE_GLIBCXX_VERSION)
    add_definitions(-DTBB_USE_GLIBCXX_VERSION=${TBB_USE_GLIBCXX_VERSION})
 endif()
 
+# MKL provides the FFTW3 interface too, point FFTW_LINK and FFTW_INC at it to use MKL
+option(ENABLE_FFTW "Use FFTW3 (or the FFTW3 interface of MKL) for FFTs on the CPU" off)
+
+if(ENABLE_FFTW)
+    find_package(FFTW REQUIRED)
+    include_directories(${FFTW_INCLUDE_DIR})
+endif()
+
 set(HOOMD_COMMON_LIBS ${ADDITIONAL_LIBS})
 
+# std::thread is used for background file output
+find_package(Threads REQUIRED)
+list(APPEND HOOMD_COMMON_LIBS ${CMAKE_THREAD_LIBS_INIT})
+
 if (ENABLE_TBB)
     list(APPEND HOOMD_COMMON_LIBS ${TBB_LIBRARY})
 endif()
 
+if (ENABLE_FFTW)
+    list(APPEND HOOMD_COMMON_LIBS ${FFTW_LIBRARIES})
+endif()
+
 if (APPLE)
     list(APPEND HOOMD_COMMON_LIBS "-undefined dynamic_lookup")
 endif()
@@ -6,3 +6,22 @@ add_custom_command(TARGET $<TARGET_FILE:${target}> POST_BUILD
                           COMMAND install_name_tool ARGS -change @rpath/libcufft.dylib ${CUDA_cufft_LIBRARY} ${_target_exe})
 endif (ENABLE_CUDA AND APPLE)
 endmacro(fix_cudart_rpath)
+
+# add a microbenchmark executable built from target.cc and linked to the remaining arguments
+# benchmarks are not run by ctest, they are built with make benchmark_all
+macro(add_benchmark target)
+add_executable(${target} EXCLUDE_FROM_ALL ${target}.cc)
+add_dependencies(benchmark_all ${target})
+target_link_libraries(${target} ${ARGN})
+fix_cudart_rpath(${target})
+
+if (ENABLE_MPI)
+    # set appropriate compiler/linker flags
+    if(MPI_COMPILE_FLAGS)
+        set_target_properties(${target} PROPERTIES COMPILE_FLAGS "${MPI_COMPILE_FLAGS}")
+    endif(MPI_COMPILE_FLAGS)
+    if(MPI_LINK_FLAGS)
+        set_target_properties(${target} PROPERTIES LINK_FLAGS "${MPI_LINK_FLAGS}")
+    endif(MPI_LINK_FLAGS)
+endif (ENABLE_MPI)
+endmacro(add_benchmark)
@@ -44,3 +44,11 @@ endif()
 if (ENABLE_TBB)
     add_definitions(-DENABLE_TBB)
 endif()
+
+# export FFTW compile flags
+if (ENABLE_FFTW)
+    add_definitions(-DENABLE_FFTW)
+    if (FFTW_THREADS_LIBRARY)
+        add_definitions(-DENABLE_FFTW_THREADS)
+    endif()
+endif()
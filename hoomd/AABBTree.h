@@ -8,6 +8,14 @@
 #include "VectorMath.h"
 #include <vector>
 #include <stack>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
 
 #include "AABB.h"
 
@@ -38,6 +46,8 @@ namespace detail
 
 const unsigned int NODE_CAPACITY = 16;           //!< Maximum number of particles in a node
 const unsigned int INVALID_NODE = 0xffffffff;   //!< Invalid node index sentinel
+const unsigned int SAH_BINS = 16;                //!< Number of candidate split bins per node in AABBTree::buildTree
+const unsigned int PARALLEL_BUILD_THRESHOLD = 4096; //!< Minimum subtree size partitioned concurrently in AABBTree::buildTree
 
 #ifndef NVCC
 
@@ -65,6 +75,13 @@ struct PYBIND11_EXPORT AABBNode
     unsigned int num_particles;                 //!< Number of particles contained in the node
     } __attribute__((aligned(32)));
 
+//! Compute the surface area of an AABB
+inline Scalar surfaceArea(const AABB& aabb)
+    {
+    vec3<Scalar> extent = aabb.getUpper() - aabb.getLower();
+    return Scalar(2.0)*(extent.x*extent.y + extent.y*extent.z + extent.z*extent.x);
+    }
+
 //! AABB Tree
 /*! An AABBTree stores a binary tree of AABBs. A leaf node stores up to NODE_CAPACITY particles by index. The bounding
     box of a leaf node surrounds all the bounding boxes of its contained particles. Internal nodes have AABBs that
@@ -76,7 +93,12 @@ struct PYBIND11_EXPORT AABBNode
                topology is left unchanged. Runs in O(log N) time. AABBs are not saved for all particles, so
                an update will only increase the volume of nodes. The tree should be rebuilt periodically instead of
                continually updated.
-    - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle.
+    - Refit  : Recompute the AABBs of all nodes from a complete set of particle AABBs, keeping the tree topology.
+               Runs in O(N) time. Unlike update(), nodes may shrink. The tree quality degrades as particles diffuse
+               away from their original neighbors, which getSurfaceArea() can be used to detect.
+    - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle. Nodes are
+               split with the binned surface area heuristic, and large subtrees are built concurrently when TBB is
+               enabled.
 
     **Implementation details**
 
@@ -167,6 +189,12 @@ class PYBIND11_EXPORT AABBTree
         //! Update the AABB of a particle
         inline void update(unsigned int idx, const AABB& aabb);
 
+        //! Recompute the AABBs of all nodes without changing the tree topology
+        inline void refit(const AABB *aabbs);
+
+        //! Get the total surface area of all nodes
+        inline Scalar getSurfaceArea() const;
+
         //! Get the height of a given particle's leaf node
         inline unsigned int height(unsigned int idx);
 
@@ -176,6 +204,12 @@ class PYBIND11_EXPORT AABBTree
             return m_num_nodes;
             }
 
+        //! Get the number of particles the tree was built for
+        inline unsigned int getNumParticles() const
+            {
+            return m_mapping.size();
+            }
+
         //! Test if a given index is a leaf node
         /*! \param node Index of the node (not the particle) to query
         */
@@ -250,8 +284,23 @@ class PYBIND11_EXPORT AABBTree
         //! Initialize the tree to hold N particles
         inline void init(unsigned int N);
 
+        //! Subtree produced by the partitioning pass of buildTree()
+        struct BuildRecord
+            {
+            unsigned int start;                  //!< First index of the subtree in the aabbs and idx lists
+            unsigned int len;                    //!< Number of particles in the subtree
+            std::unique_ptr<BuildRecord> left;   //!< Left child (NULL for a leaf)
+            std::unique_ptr<BuildRecord> right;  //!< Right child (NULL for a leaf)
+            };
+
+        //! Partition a range of AABBs recursively into subtrees
+        inline std::unique_ptr<BuildRecord> partitionNode(AABB *aabbs, std::vector<unsigned int>& idx, unsigned int start, unsigned int len);
+
+        //! Split a range of AABBs in two with the surface area heuristic
+        inline unsigned int splitSAH(AABB *aabbs, std::vector<unsigned int>& idx, unsigned int start, unsigned int len);
+
         //! Build a node of the tree recursively
-        inline unsigned int buildNode(AABB *aabbs, std::vector<unsigned int>& idx, unsigned int start, unsigned int len, unsigned int parent);
+        inline unsigned int buildNode(AABB *aabbs, std::vector<unsigned int>& idx, const BuildRecord& record, unsigned int parent);
 
         //! Allocate a new node
         inline unsigned int allocateNode();
@@ -350,6 +399,53 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
         }
     }
 
+/*! \param aabbs List of AABBs for each particle, indexed by particle (must hold getNumParticles() entries)
+
+    Recompute the AABB of every node to tightly enclose the given particle AABBs. The tree topology is not changed,
+    so the result is a valid tree for any particle positions, but queries slow down as particles move away from the
+    neighbors they were grouped with at build time. buildNode() allocates every node before its children, so a reverse
+    sweep over the node array visits children before their parents.
+*/
+inline void AABBTree::refit(const AABB *aabbs)
+    {
+    for (unsigned int node_idx = m_num_nodes; node_idx-- > 0; )
+        {
+        AABBNode& node = m_nodes[node_idx];
+
+        if (node.left == INVALID_NODE)
+            {
+            if (node.num_particles == 0)
+                continue;
+
+            // merge the particle AABBs into the leaf
+            AABB leaf_aabb = aabbs[node.particles[0]];
+            for (unsigned int i = 1; i < node.num_particles; i++)
+                leaf_aabb = merge(leaf_aabb, aabbs[node.particles[i]]);
+
+            node.aabb = leaf_aabb;
+            }
+        else
+            {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+            }
+        }
+    }
+
+/*! \returns The sum of the surface areas of all node AABBs
+
+    The total surface area is proportional to the expected cost of a query and serves as a measure of tree quality.
+*/
+inline Scalar AABBTree::getSurfaceArea() const
+    {
+    Scalar area = 0.0;
+    for (unsigned int node_idx = 0; node_idx < m_num_nodes; node_idx++)
+        {
+        area += surfaceArea(m_nodes[node_idx].aabb);
+        }
+
+    return area;
+    }
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -381,8 +477,13 @@ inline unsigned int AABBTree::height(unsigned int idx)
 /*! \param aabbs List of AABBs for each particle (must be 32-byte aligned)
     \param N Number of AABBs in the list
 
-    Builds a balanced tree from a given list of AABBs for each particle. Data in \a aabbs will be modified during
-    the construction process.
+    Builds a tree from a given list of AABBs for each particle. Data in \a aabbs will be modified during the
+    construction process.
+
+    The build runs in two passes. partitionNode() recursively splits the AABBs with the surface area heuristic, which
+    is where nearly all of the work is done. Sibling subtrees own disjoint ranges of \a aabbs, so in builds with TBB
+    large subtrees are partitioned concurrently. buildNode() then walks the resulting partition serially and emits the
+    nodes in depth first order, as required by the stackless traversal and by refit().
 */
 inline void AABBTree::buildTree(AABB *aabbs, unsigned int N)
     {
@@ -392,7 +493,8 @@ inline void AABBTree::buildTree(AABB *aabbs, unsigned int N)
     for (unsigned int i = 0; i < N; i++)
         idx.push_back(i);
 
-    m_root = buildNode(aabbs, idx, 0, N, INVALID_NODE);
+    std::unique_ptr<BuildRecord> root = partitionNode(aabbs, idx, 0, N);
+    m_root = buildNode(aabbs, idx, *root, INVALID_NODE);
     updateSkip(m_root);
     }
 
@@ -400,32 +502,202 @@ inline void AABBTree::buildTree(AABB *aabbs, unsigned int N)
     \param idx List of indices
     \param start Start point in aabbs and idx to examine
     \param len Number of aabbs to examine
-    \param parent Index of the parent node
+    \returns The partition of the range into subtrees
 
-    buildNode is the main driver of the smart AABB tree build algorithm. Each call produces a node, given a set of
-    AABBs. If there are fewer AABBs than fit in a leaf, a leaf is generated. If there are too many, the total AABB
-    is computed and split on the largest length axis. The total tree is built by recursive splitting.
+    partitionNode is the main driver of the smart AABB tree build algorithm. If there are fewer AABBs than fit in a
+    leaf, the range becomes a leaf. If there are too many, it is split in two with splitSAH() and each side is
+    partitioned recursively.
 
-    The aabbs and idx lists are passed in by reference. Each node is given a subrange of the list to own (start to
-    start + len). When building the node, it partitions its subrange into two sides (like quick sort).
+    The aabbs and idx lists are passed in by reference. Each call is given a subrange of the list to own (start to
+    start + len) and reorders it in place (like quick sort). Calls on sibling subranges never touch the same entries,
+    so they may run concurrently.
 */
-inline unsigned int AABBTree::buildNode(AABB *aabbs,
-                                        std::vector<unsigned int>& idx,
-                                        unsigned int start,
-                                        unsigned int len,
-                                        unsigned int parent)
+inline std::unique_ptr<AABBTree::BuildRecord> AABBTree::partitionNode(AABB *aabbs,
+                                                                      std::vector<unsigned int>& idx,
+                                                                      unsigned int start,
+                                                                      unsigned int len)
     {
-    // merge all the AABBs into one
-    AABB my_aabb = aabbs[start];
+    std::unique_ptr<BuildRecord> record(new BuildRecord);
+    record->start = start;
+    record->len = len;
+
+    // leaf nodes are not split further
+    if (len <= NODE_CAPACITY)
+        return record;
+
+    unsigned int len_left = splitSAH(aabbs, idx, start, len);
+
+    #ifdef ENABLE_TBB
+    if (len >= PARALLEL_BUILD_THRESHOLD)
+        {
+        tbb::parallel_invoke(
+            [&] { record->left = partitionNode(aabbs, idx, start, len_left); },
+            [&] { record->right = partitionNode(aabbs, idx, start+len_left, len-len_left); });
+        }
+    else
+    #endif
+        {
+        record->left = partitionNode(aabbs, idx, start, len_left);
+        record->right = partitionNode(aabbs, idx, start+len_left, len-len_left);
+        }
+
+    return record;
+    }
+
+/*! \param aabbs List of AABBs
+    \param idx List of indices
+    \param start Start point in aabbs and idx to examine
+    \param len Number of aabbs to examine (at least 2)
+    \returns The number of AABBs placed on the left side, between 1 and len-1
+
+    The AABB centers are sorted into SAH_BINS equal width bins along the longest axis of their bounding box. Of the
+    SAH_BINS-1 candidate planes between the bins, the one that minimizes the surface area heuristic
+    A_left*N_left + A_right*N_right is chosen, and the range is partitioned in place on that plane. This groups
+    particles into tight nodes even when the density is not uniform, where a split at the midpoint of the node would
+    produce large, mostly empty siblings.
+
+    When all centers coincide (to within rounding) no plane separates them, and the range is simply split in half.
+*/
+inline unsigned int AABBTree::splitSAH(AABB *aabbs,
+                                       std::vector<unsigned int>& idx,
+                                       unsigned int start,
+                                       unsigned int len)
+    {
+    // bound the centers of the AABBs
+    vec3<Scalar> lower = aabbs[start].getPosition();
+    vec3<Scalar> upper = lower;
     for (unsigned int i = 1; i < len; i++)
         {
-        my_aabb = merge(my_aabb, aabbs[start+i]);
+        vec3<Scalar> pos = aabbs[start+i].getPosition();
+        lower.x = std::min(lower.x, pos.x); upper.x = std::max(upper.x, pos.x);
+        lower.y = std::min(lower.y, pos.y); upper.y = std::max(upper.y, pos.y);
+        lower.z = std::min(lower.z, pos.z); upper.z = std::max(upper.z, pos.z);
+        }
+
+    // bin along the longest axis
+    vec3<Scalar> extent = upper - lower;
+    unsigned int axis = 2;
+    if (extent.x >= extent.y && extent.x >= extent.z)
+        axis = 0;
+    else if (extent.y >= extent.z)
+        axis = 1;
+
+    Scalar axis_lower = (axis == 0) ? lower.x : ((axis == 1) ? lower.y : lower.z);
+    Scalar axis_extent = (axis == 0) ? extent.x : ((axis == 1) ? extent.y : extent.z);
+
+    // centers that differ only by rounding can not be binned, and a subnormal extent would overflow bin_scale
+    Scalar axis_scale = std::max(std::abs(axis_lower), std::abs(axis_lower + axis_extent));
+    if (!(axis_extent > Scalar(SAH_BINS)*std::numeric_limits<Scalar>::epsilon()*axis_scale))
+        return len/2;
+
+    Scalar bin_scale = Scalar(SAH_BINS)/axis_extent;
+    if (!std::isfinite(bin_scale))
+        return len/2;
+    auto get_bin = [axis, axis_lower, bin_scale](const AABB& aabb) -> unsigned int
+        {
+        vec3<Scalar> pos = aabb.getPosition();
+        Scalar x = (axis == 0) ? pos.x : ((axis == 1) ? pos.y : pos.z);
+        unsigned int bin = (unsigned int)((x - axis_lower)*bin_scale);
+        return (bin < SAH_BINS) ? bin : SAH_BINS-1;
+        };
+
+    AABB bin_aabb[SAH_BINS];
+    unsigned int bin_count[SAH_BINS];
+    for (unsigned int b = 0; b < SAH_BINS; b++)
+        bin_count[b] = 0;
+
+    for (unsigned int i = 0; i < len; i++)
+        {
+        unsigned int b = get_bin(aabbs[start+i]);
+        bin_aabb[b] = (bin_count[b] == 0) ? aabbs[start+i] : merge(bin_aabb[b], aabbs[start+i]);
+        bin_count[b]++;
         }
-    vec3<Scalar> my_radius = my_aabb.getUpper() - my_aabb.getLower();
+
+    // sweep from the right to get the area and count to the right of each plane
+    Scalar right_area[SAH_BINS];
+    unsigned int right_count[SAH_BINS];
+    AABB right_aabb;
+    unsigned int count = 0;
+    for (unsigned int b = SAH_BINS; b-- > 1; )
+        {
+        if (bin_count[b] > 0)
+            {
+            right_aabb = (count == 0) ? bin_aabb[b] : merge(right_aabb, bin_aabb[b]);
+            count += bin_count[b];
+            }
+        right_count[b] = count;
+        right_area[b] = (count > 0) ? surfaceArea(right_aabb) : Scalar(0.0);
+        }
+
+    // sweep from the left and pick the cheapest plane. The lowest and highest centers fall into the first and last
+    // bins, so at least one plane has particles on both sides.
+    unsigned int best_bin = 0;
+    Scalar best_cost = Scalar(0.0);
+    bool found = false;
+    AABB left_aabb;
+    count = 0;
+    for (unsigned int b = 0; b < SAH_BINS-1; b++)
+        {
+        if (bin_count[b] > 0)
+            {
+            left_aabb = (count == 0) ? bin_aabb[b] : merge(left_aabb, bin_aabb[b]);
+            count += bin_count[b];
+            }
+
+        if (count == 0 || right_count[b+1] == 0)
+            continue;
+
+        Scalar cost = surfaceArea(left_aabb)*Scalar(count) + right_area[b+1]*Scalar(right_count[b+1]);
+        if (!found || cost < best_cost)
+            {
+            best_bin = b;
+            best_cost = cost;
+            found = true;
+            }
+        }
+
+    // partition the range on the chosen plane
+    unsigned int start_right = len;
+    for (unsigned int i = 0; i < start_right; i++)
+        {
+        if (get_bin(aabbs[start+i]) > best_bin)
+            {
+            // move to the right side and look at the swapped in aabb next
+            std::swap(aabbs[start+i], aabbs[start+start_right-1]);
+            std::swap(idx[start+i], idx[start+start_right-1]);
+            start_right--;
+            i--;
+            }
+        }
+
+    return start_right;
+    }
+
+/*! \param aabbs List of AABBs, as partitioned by partitionNode()
+    \param idx List of indices, as partitioned by partitionNode()
+    \param record Partition of the subtree to build
+    \param parent Index of the parent node
+
+    Each call produces a node for the given build record. Nodes are allocated before their children and the left
+    subtree is built before the right, so every subtree occupies a contiguous range of the node array.
+*/
+inline unsigned int AABBTree::buildNode(AABB *aabbs,
+                                        std::vector<unsigned int>& idx,
+                                        const BuildRecord& record,
+                                        unsigned int parent)
+    {
+    unsigned int start = record.start;
+    unsigned int len = record.len;
 
     // handle the case of a leaf node creation
-    if (len <= NODE_CAPACITY)
+    if (!record.left)
         {
+        AABB my_aabb = aabbs[start];
+        for (unsigned int i = 1; i < len; i++)
+            {
+            my_aabb = merge(my_aabb, aabbs[start+i]);
+            }
+
         unsigned int new_node = allocateNode();
         m_nodes[new_node].aabb = my_aabb;
         m_nodes[new_node].parent = parent;
@@ -447,99 +719,13 @@ inline unsigned int AABBTree::buildNode(AABB *aabbs,
     // otherwise, we are creating an internal node - allocate an index
     unsigned int my_idx = allocateNode();
 
-    // need to split the list of aabbs into two sets for left and right
-    unsigned int start_left = 0;
-    unsigned int start_right = len;
-
-    // if there are only 2 aabbs, put one on each side
-    if (len == 2)
-        {
-        // nothing to do, already partitioned
-        }
-    else
-        {
-        // otherwise, we need to split them based on a heuristic. split the longest dimension in half
-        if (my_radius.x > my_radius.y && my_radius.x > my_radius.z)
-            {
-            // split on x direction
-            for (unsigned int i = 0; i < start_right; i++)
-                {
-                if (aabbs[start+i].getPosition().x < my_aabb.getPosition().x)
-                    {
-                    // if on the left side, everything is happy, just continue on
-                    }
-                else
-                    {
-                    // if on the right side, need to swap the current aabb with the one at start_right-1, subtract
-                    // one off of start_right to indicate the addition of one to the right side and subtract 1
-                    // from i to look at the current index (new aabb). This is quick and easy to write, but will
-                    // randomize indices - might need to look into a stable partitioning algorithm!
-                    std::swap(aabbs[start+i], aabbs[start+start_right-1]);
-                    std::swap(idx[start+i], idx[start+start_right-1]);
-                    start_right--;
-                    i--;
-                    }
-                }
-            }
-        else if (my_radius.y > my_radius.z)
-            {
-            // split on y direction
-            for (unsigned int i = 0; i < start_right; i++)
-                {
-                if (aabbs[start+i].getPosition().y < my_aabb.getPosition().y)
-                    {
-                    // if on the left side, everything is happy, just continue on
-                    }
-                else
-                    {
-                    // if on the right side, need to swap the current aabb with the one at start_right-1, subtract
-                    // one off of start_right to indicate the addition of one to the right side and subtract 1
-                    // from i to look at the current index (new aabb). This is quick and easy to write, but will
-                    // randomize indices - might need to look into a stable partitioning algorithm!
-                    std::swap(aabbs[start+i], aabbs[start+start_right-1]);
-                    std::swap(idx[start+i], idx[start+start_right-1]);
-                    start_right--;
-                    i--;
-                    }
-                }
-            }
-        else
-            {
-            // split on z direction
-            for (unsigned int i = 0; i < start_right; i++)
-                {
-                if (aabbs[start+i].getPosition().z < my_aabb.getPosition().z)
-                    {
-                    // if on the left side, everything is happy, just continue on
-                    }
-                else
-                    {
-                    // if on the right side, need to swap the current aabb with the one at start_right-1, subtract
-                    // one off of start_right to indicate the addition of one to the right side and subtract 1
-                    // from i to look at the current index (new aabb). This is quick and easy to write, but will
-                    // randomize indices - might need to look into a stable partitioning algorithm!
-                    std::swap(aabbs[start+i], aabbs[start+start_right-1]);
-                    std::swap(idx[start+i], idx[start+start_right-1]);
-                    start_right--;
-                    i--;
-                    }
-                }
-            }
-        }
-
-    // sanity check. The left or right tree may have ended up empty. If so, just borrow one particle from it
-    if (start_right == len)
-        start_right = len-1;
-    if (start_right == 0)
-        start_right = 1;
-
     // note: calling buildNode has side effects, the m_nodes array may be reallocated. So we need to determine the left
     // and right children, then build our node (can't say m_nodes[my_idx].left = buildNode(...))
-    unsigned int new_left = buildNode(aabbs, idx, start+start_left, start_right-start_left, my_idx);
-    unsigned int new_right = buildNode(aabbs, idx, start+start_right, len-start_right, my_idx);
+    unsigned int new_left = buildNode(aabbs, idx, *record.left, my_idx);
+    unsigned int new_right = buildNode(aabbs, idx, *record.right, my_idx);
 
     // now, create the children and connect them up
-    m_nodes[my_idx].aabb = my_aabb;
+    m_nodes[my_idx].aabb = merge(m_nodes[new_left].aabb, m_nodes[new_right].aabb);
     m_nodes[my_idx].parent = parent;
     m_nodes[my_idx].left = new_left;
     m_nodes[my_idx].right = new_right;
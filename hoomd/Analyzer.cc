@@ -23,6 +23,8 @@ Analyzer::Analyzer(std::shared_ptr<SystemDefinition> sysdef) : m_sysdef(sysdef),
     // sanity check
     assert(m_sysdef);
     assert(m_pdata);
+
+    m_call_timer = std::shared_ptr<CallTimer>(new CallTimer(m_exec_conf));
     }
 
 /*! It is useful for the user to know where computation time is spent, so all Analyzers
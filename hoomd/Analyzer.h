@@ -18,6 +18,7 @@
 #define __ANALYZER_H__
 
 #include "Profiler.h"
+#include "CallTimer.h"
 #include "SystemDefinition.h"
 #include "SharedSignal.h"
 
@@ -70,6 +71,14 @@ class PYBIND11_EXPORT Analyzer
         //! Sets the profiler for the analyzer to use
         void setProfiler(std::shared_ptr<Profiler> prof);
 
+        //! Get the timer of the calls to analyze()
+        /*! The timer is registered with loggers when it has a name (see CallTimer).
+        */
+        std::shared_ptr<CallTimer> getCallTimer() const
+            {
+            return m_call_timer;
+            }
+
         //! Set autotuner parameters
         /*! \param enable Enable/disable autotuning
             \param period period (approximate) in time steps when returning occurs
@@ -92,6 +101,13 @@ class PYBIND11_EXPORT Analyzer
         */
         virtual void resetStats(){}
 
+        //! Complete any output that is still in progress
+        /*! Derived classes that write output in the background must implement flush() to block until all output
+            is complete. System calls flush() on all Analyzers at the end of a run, including runs interrupted by
+            SIGINT.
+        */
+        virtual void flush(){}
+
         //! Get needed pdata flags
         /*! Not all fields in ParticleData are computed by default. When derived classes need one of these optional
             fields, they must return the requested fields in getRequestedPDataFlags().
@@ -139,6 +155,7 @@ class PYBIND11_EXPORT Analyzer
         const std::shared_ptr<SystemDefinition> m_sysdef; //!< The system definition this analyzer is associated with
         const std::shared_ptr<ParticleData> m_pdata;      //!< The particle data this analyzer is associated with
         std::shared_ptr<Profiler> m_prof;                 //!< The profiler this analyzer is to use
+        std::shared_ptr<CallTimer> m_call_timer;          //!< Timer of the calls to analyze()
 
 #ifdef ENABLE_MPI
         std::shared_ptr<Communicator> m_comm;             //!< The communicator to use
@@ -234,46 +234,45 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
-        // broadcast to all processors (temporarily)
-        std::vector<members_t> all_groups;
-        std::vector<typeval_t> all_typeval;
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        bool is_root = m_exec_conf->getRank() == 0;
 
-        if (m_exec_conf->getRank() == 0)
+        if (is_root)
+            m_type_mapping = snapshot.type_mapping;
+        bcast(m_type_mapping, 0, mpi_comm);
+
+        unsigned int n_groups = snapshot.groups.size();
+        MPI_Bcast(&n_groups, 1, MPI_UNSIGNED, 0, mpi_comm);
+
+        // every rank keeps the global tag table, but only stores the groups with local members. Broadcast the
+        // groups in chunks so that no rank needs a copy of all groups at once.
+        std::vector<members_t> groups;
+        std::vector<typeval_t> typevals;
+        for (unsigned int start = 0; start < n_groups; start += MPI_SNAPSHOT_CHUNK_SIZE)
             {
-            all_groups = snapshot.groups;
-            if (has_type_mapping)
-                {
-                all_typeval.resize(snapshot.type_id.size());
-                // fill in types
-                for (unsigned int i = 0; i < snapshot.type_id.size(); ++i)
-                    {
-                    typeval_t t;
-                    t.type = snapshot.type_id[i];
-                    all_typeval[i] = t;
-                    }
-                }
-            else
+            unsigned int n = std::min(MPI_SNAPSHOT_CHUNK_SIZE, n_groups - start);
+            groups.resize(n);
+            typevals.resize(n);
+
+            if (is_root)
                 {
-                all_typeval.resize(snapshot.val.size());
-                // fill in constraint values
-                for (unsigned int i = 0; i < snapshot.val.size(); ++i)
+                for (unsigned int i = 0; i < n; ++i)
                     {
-                    typeval_t t;
-                    t.val = snapshot.val[i];
-                    all_typeval[i] = t;
+                    groups[i] = snapshot.groups[start + i];
+                    if (has_type_mapping)
+                        typevals[i].type = snapshot.type_id[start + i];
+                    else
+                        typevals[i].val = snapshot.val[start + i];
                     }
                 }
 
-            m_type_mapping = snapshot.type_mapping;
-            }
+            MPI_Bcast(groups.data(), n*sizeof(members_t), MPI_BYTE, 0, mpi_comm);
+            MPI_Bcast(typevals.data(), n*sizeof(typeval_t), MPI_BYTE, 0, mpi_comm);
 
-        bcast(all_groups, 0, m_exec_conf->getMPICommunicator());
-        bcast(all_typeval, 0, m_exec_conf->getMPICommunicator());
-        bcast(m_type_mapping, 0, m_exec_conf->getMPICommunicator());
-
-        // iterate over groups and add those that have local particles
-        for (unsigned int group_tag = 0; group_tag < all_groups.size(); ++group_tag)
-            addBondedGroup(Group(all_typeval[group_tag], all_groups[group_tag]));
+            // add those that have local particles
+            for (unsigned int i = 0; i < n; ++i)
+                addBondedGroup(Group(typevals[i], groups[i]));
+            }
         }
     else
     #endif
@@ -0,0 +1,100 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file CallTimer.cc
+    \brief Defines the CallTimer class
+*/
+
+#include "CallTimer.h"
+
+#ifdef ENABLE_CUDA
+#include <cuda_runtime.h>
+#endif
+
+using namespace std;
+
+thread_local CallTimer *CallTimer::s_current = NULL;
+
+/*! \param exec_conf Execution configuration
+    \param name Name of the log quantity, the timer is not registered with loggers when empty
+*/
+CallTimer::CallTimer(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& name)
+    : m_exec_conf(exec_conf), m_name(name), m_enabled(false), m_depth(0), m_start_time(0), m_child_time(0),
+      m_parent(NULL), m_total_time(0), m_n_calls(0), m_has_value(false), m_value_timestep(0), m_value(0.0)
+    {
+    }
+
+void CallTimer::synchronize()
+    {
+#ifdef ENABLE_CUDA
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->multiGPUBarrier();
+        cudaDeviceSynchronize();
+        }
+#endif
+    }
+
+void CallTimer::start()
+    {
+    if (!m_enabled)
+        return;
+
+    // recursive calls are part of the outermost one
+    if (m_depth++ > 0)
+        return;
+
+    synchronize();
+
+    m_parent = s_current;
+    s_current = this;
+    m_child_time = 0;
+    m_start_time = m_clk.getTime();
+    }
+
+void CallTimer::stop()
+    {
+    // the timer may have been enabled during the call
+    if (m_depth == 0)
+        return;
+
+    if (--m_depth > 0)
+        return;
+
+    synchronize();
+
+    int64_t elapsed = m_clk.getTime() - m_start_time;
+    m_total_time += elapsed - m_child_time;
+    m_n_calls++;
+
+    if (m_parent)
+        m_parent->m_child_time += elapsed;
+    s_current = m_parent;
+    m_parent = NULL;
+    }
+
+/*! \param timestep Current time step
+    \returns The average time per call since the previous read, 0 if there were no calls
+
+    Repeated reads at the same time step return the same value, so that several loggers may log the quantity. In
+    MPI runs, the maximum over the ranks is returned and this method must be called on all ranks.
+*/
+double CallTimer::getTimePerCall(unsigned int timestep)
+    {
+    if (m_has_value && timestep == m_value_timestep)
+        return m_value;
+
+    m_value = m_n_calls > 0 ? double(m_total_time) / double(m_n_calls) / 1e9 : 0.0;
+    m_total_time = 0;
+    m_n_calls = 0;
+
+#ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        MPI_Allreduce(MPI_IN_PLACE, &m_value, 1, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+#endif
+
+    m_has_value = true;
+    m_value_timestep = timestep;
+    return m_value;
+    }
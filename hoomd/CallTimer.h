@@ -0,0 +1,120 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file CallTimer.h
+    \brief Declares the CallTimer class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __CALL_TIMER_H__
+#define __CALL_TIMER_H__
+
+#include "ExecutionConfiguration.h"
+#include "ClockSource.h"
+
+#include <memory>
+#include <string>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Measures the wall time per call of a compute, updater, or analyzer for logging
+/*! Computes, updaters, analyzers, and the Communicator own a CallTimer. Whoever calls them brackets the call with
+    start() and stop() (or a CallTimer::Scope). Timers with a name are registered with the Logger, which provides the
+    average time per call since the previous logged step as the log quantity of that name (e.g. time_pair_lj).
+
+    Timers are disabled until their quantity is logged, then start() and stop() return immediately. Enabled timers
+    synchronize the GPU at the start and end of each call, so that the time of asynchronous kernels is attributed to
+    the right call.
+
+    Timed calls nest: the time of a call excludes the time of the enabled timers that run inside it on the same
+    thread. For example, time_pair_lj does not include the neighbor list build when time_nlist is also logged.
+    \ingroup utils
+*/
+class PYBIND11_EXPORT CallTimer
+    {
+    public:
+        //! Construct a disabled timer
+        CallTimer(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& name = "");
+
+        //! Get the name of the log quantity
+        const std::string& getName() const
+            {
+            return m_name;
+            }
+
+        //! Set the name of the log quantity
+        void setName(const std::string& name)
+            {
+            m_name = name;
+            }
+
+        //! Enable or disable the timer
+        void enable(bool enable)
+            {
+            m_enabled = enable;
+            }
+
+        //! Test if the timer is enabled
+        bool isEnabled() const
+            {
+            return m_enabled;
+            }
+
+        //! Start a call
+        void start();
+
+        //! End a call
+        void stop();
+
+        //! Get the average time per call since the previous time step this was called (in seconds)
+        double getTimePerCall(unsigned int timestep);
+
+        //! Times the lifetime of a scope
+        class Scope
+            {
+            public:
+                //! Start the call
+                Scope(CallTimer& timer) : m_timer(timer)
+                    {
+                    m_timer.start();
+                    }
+
+                //! End the call
+                ~Scope()
+                    {
+                    m_timer.stop();
+                    }
+
+            private:
+                CallTimer& m_timer;     //!< The timer
+            };
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+        std::string m_name;         //!< Name of the log quantity
+        bool m_enabled;             //!< True if calls are timed
+        ClockSource m_clk;          //!< Clock to time the calls
+
+        unsigned int m_depth;       //!< Number of nested start() calls of this timer
+        int64_t m_start_time;       //!< Start time of the current call
+        int64_t m_child_time;       //!< Time of nested timers in the current call
+        CallTimer *m_parent;        //!< Timer that was running when the current call started
+
+        int64_t m_total_time;       //!< Total time of the calls since the last read
+        unsigned int m_n_calls;     //!< Number of calls since the last read
+
+        bool m_has_value;           //!< True if m_value is valid
+        unsigned int m_value_timestep;  //!< Time step of the last read
+        double m_value;             //!< Value of the last read
+
+        static thread_local CallTimer *s_current;   //!< Innermost running timer of this thread
+
+        //! Wait for the GPU to complete queued work
+        void synchronize();
+    };
+
+#endif
@@ -13,6 +13,10 @@
 
 #include <algorithm>
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
@@ -25,6 +29,7 @@ CellList::CellList(std::shared_ptr<SystemDefinition> sysdef)
       m_compute_adj_list(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing CellList" << endl;
+    m_call_timer->setName("time_cell");
 
     // allocation is deferred until the first compute() call - initialize values to dummy variables
     m_dim = make_uint3(0,0,0);
@@ -118,6 +123,7 @@ uint3 CellList::computeDimensions()
 
 void CellList::compute(unsigned int timestep)
     {
+    CallTimer::Scope timer(*m_call_timer);
     bool force = false;
 
     if (m_prof)
@@ -470,14 +476,19 @@ void CellList::computeCellList()
 
     // for each particle
     unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int n_local = m_pdata->getN();
+
+    // sentinel for particles that are not placed in any cell
+    const unsigned int no_bin = 0xffffffff;
 
-    for (unsigned int n = 0; n < n_tot_particles; n++)
+    // determines the bin of particle n, or no_bin (and sets the error conditions) if it cannot be binned
+    auto find_bin = [&](unsigned int n, uint3& cond) -> unsigned int
         {
         Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
         if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
             {
-            conditions.y = n+1;
-            continue;
+            cond.y = n+1;
+            return no_bin;
             }
 
 
@@ -493,9 +504,9 @@ void CellList::computeCellList()
             (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)) )
             {
             // if a ghost particle is out of bounds, silently ignore it
-            if (n < m_pdata->getN())
-                conditions.z = n+1;
-            continue;
+            if (n < n_local)
+                cond.z = n+1;
+            return no_bin;
             }
 
         // need to handle the case where the particle is exactly at the box hi
@@ -507,10 +518,7 @@ void CellList::computeCellList()
             kb = 0;
 
         // sanity check
-        assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z)) || n>=m_pdata->getN());
-
-        // record its bin
-        unsigned int bin = ci(ib, jb, kb);
+        assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z)) || n>=n_local);
 
         // all particles should be in a valid cell
         if (ib < 0 || ib >= (int)m_dim.x ||
@@ -518,11 +526,18 @@ void CellList::computeCellList()
             kb < 0 || kb >= (int)m_dim.z)
             {
             // but ghost particles that are out of range should not produce an error
-            if (n < m_pdata->getN())
-                conditions.z = n+1;
-            continue;
+            if (n < n_local)
+                cond.z = n+1;
+            return no_bin;
             }
 
+        // record its bin
+        return ci(ib, jb, kb);
+        };
+
+    // stores the entries of particle n at the given offset in a bin
+    auto store_entry = [&](unsigned int n, unsigned int bin, unsigned int offset)
+        {
         // setup the flag value to store
         Scalar flag;
         if (m_flag_charge)
@@ -532,41 +547,125 @@ void CellList::computeCellList()
         else
             flag = __int_as_scalar(n);
 
-        // store the bin entries
-        unsigned int offset = h_cell_size.data[bin];
+        if (m_compute_xyzf)
+            {
+            h_xyzf.data[cli(offset, bin)] = make_scalar4(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z, flag);
+            }
+
+        if (m_compute_tdb)
+            {
+            h_tdb.data[cli(offset, bin)] = make_scalar4(h_pos.data[n].w,
+                                                        h_diameter.data[n],
+                                                        __int_as_scalar(h_body.data[n]),
+                                                        Scalar(0.0));
+            }
 
-        if (offset < m_Nmax)
+        if (m_compute_orientation)
             {
-            if (m_compute_xyzf)
-                {
-                h_xyzf.data[cli(offset, bin)] = make_scalar4(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z, flag);
-                }
+            h_cell_orientation.data[cli(offset, bin)] = h_orientation.data[n];
+            }
 
-            if (m_compute_tdb)
+        if (m_compute_idx)
+            {
+            h_cell_idx.data[cli(offset, bin)] = n;
+            }
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1 && n_tot_particles > 0)
+        {
+        // Split the particles into one contiguous chunk per thread. Each chunk counts its members per cell, an
+        // exclusive scan over the chunks gives each chunk its starting offset in every cell, and the chunks then scatter
+        // their particles independently. Particles end up in the same order as in the serial loop.
+        const unsigned int n_cells = m_cell_indexer.getNumElements();
+        const unsigned int n_chunks = std::min(m_exec_conf->getNumThreads(), n_tot_particles);
+        const unsigned int chunk_size = (n_tot_particles + n_chunks - 1) / n_chunks;
+
+        m_bin_scratch.resize(n_tot_particles);
+        m_chunk_offset.resize(n_chunks * n_cells);
+        std::vector<uint3> chunk_conditions(n_chunks, make_uint3(0,0,0));
+
+        // count the number of particles per cell in each chunk
+        tbb::parallel_for((unsigned int)0, n_chunks, [&](unsigned int chunk)
+            {
+            unsigned int *count = &m_chunk_offset[chunk * n_cells];
+            std::fill(count, count + n_cells, 0);
+
+            const unsigned int last = std::min(n_tot_particles, (chunk+1)*chunk_size);
+            for (unsigned int n = chunk*chunk_size; n < last; n++)
                 {
-                h_tdb.data[cli(offset, bin)] = make_scalar4(h_pos.data[n].w,
-                                                            h_diameter.data[n],
-                                                            __int_as_scalar(h_body.data[n]),
-                                                            Scalar(0.0));
+                unsigned int bin = find_bin(n, chunk_conditions[chunk]);
+                m_bin_scratch[n] = bin;
+                if (bin != no_bin)
+                    count[bin]++;
                 }
+            });
 
-            if (m_compute_orientation)
+        // exclusive scan over the chunks for every cell
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_cells),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int bin = r.begin(); bin != r.end(); ++bin)
                 {
-                h_cell_orientation.data[cli(offset, bin)] = h_orientation.data[n];
+                unsigned int sum = 0;
+                for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
+                    {
+                    unsigned int count = m_chunk_offset[chunk * n_cells + bin];
+                    m_chunk_offset[chunk * n_cells + bin] = sum;
+                    sum += count;
+                    }
+                h_cell_size.data[bin] = sum;
                 }
+            });
 
-            if (m_compute_idx)
+        // scatter the particles into their cells
+        tbb::parallel_for((unsigned int)0, n_chunks, [&](unsigned int chunk)
+            {
+            unsigned int *offsets = &m_chunk_offset[chunk * n_cells];
+
+            const unsigned int last = std::min(n_tot_particles, (chunk+1)*chunk_size);
+            for (unsigned int n = chunk*chunk_size; n < last; n++)
                 {
-                h_cell_idx.data[cli(offset, bin)] = n;
+                unsigned int bin = m_bin_scratch[n];
+                if (bin == no_bin)
+                    continue;
+
+                unsigned int offset = offsets[bin]++;
+                if (offset < m_Nmax)
+                    store_entry(n, bin, offset);
+                else
+                    chunk_conditions[chunk].x = max(chunk_conditions[chunk].x, offset+1);
                 }
-            }
-        else
+            });
+
+        // chunks are ordered by particle index, so the maximum reproduces the serial conditions
+        for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
             {
-            conditions.x = max(conditions.x, offset+1);
+            conditions.x = max(conditions.x, chunk_conditions[chunk].x);
+            conditions.y = max(conditions.y, chunk_conditions[chunk].y);
+            conditions.z = max(conditions.z, chunk_conditions[chunk].z);
             }
+        }
+    else
+    #endif
+        {
+        for (unsigned int n = 0; n < n_tot_particles; n++)
+            {
+            unsigned int bin = find_bin(n, conditions);
+            if (bin == no_bin)
+                continue;
+
+            // store the bin entries
+            unsigned int offset = h_cell_size.data[bin];
 
-        // increment the cell occupancy counter
-        h_cell_size.data[bin]++;
+            if (offset < m_Nmax)
+                store_entry(n, bin, offset);
+            else
+                conditions.x = max(conditions.x, offset+1);
+
+            // increment the cell occupancy counter
+            h_cell_size.data[bin]++;
+            }
         }
 
         {
@@ -251,7 +251,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                 recv_bytes += sizeof(unsigned int);
                 } // end neighbor loop
 
-            MPI_Waitall(nreq, req, stat);
+            m_comm.waitAll(nreq, req, stat);
 
             // sum up receive counts
             for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
@@ -318,7 +318,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                 }
 
             std::vector<MPI_Status> stats(reqs.size());
-            MPI_Waitall(reqs.size(), &reqs.front(), &stats.front());
+            m_comm.waitAll(reqs.size(), &reqs.front(), &stats.front());
 
             if (m_comm.m_prof) m_comm.m_prof->pop(0,send_bytes+recv_bytes);
             }
@@ -534,7 +534,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                 recv_bytes += sizeof(unsigned int);
                 } // end neighbor loop
 
-            MPI_Waitall(nreq, req, stat);
+            m_comm.waitAll(nreq, req, stat);
 
             // sum up receive counts
             for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
@@ -601,7 +601,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                 }
 
             std::vector<MPI_Status> stats(reqs.size());
-            MPI_Waitall(reqs.size(), &reqs.front(), &stats.front());
+            m_comm.waitAll(reqs.size(), &reqs.front(), &stats.front());
 
             if (m_comm.m_prof) m_comm.m_prof->pop(0,send_bytes+recv_bytes);
             }
@@ -931,7 +931,7 @@ void Communicator::GroupCommunicator<group_data>::exchangeGhostGroups(
                 0,
                 m_comm.m_mpi_comm,
                 &reqs[1]);
-            MPI_Waitall(2, reqs, status);
+            m_comm.waitAll(2, reqs, status);
 
             if (m_comm.m_prof)
                 m_comm.m_prof->pop();
@@ -981,7 +981,7 @@ void Communicator::GroupCommunicator<group_data>::exchangeGhostGroups(
                     2,
                     m_comm.m_mpi_comm,
                     &reqs[3]);
-                MPI_Waitall(4, reqs, status);
+                m_comm.waitAll(4, reqs, status);
                 }
 
             if (m_comm.m_prof)
@@ -1090,6 +1090,7 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
             m_has_ghost_particles(false),
             m_last_flags(0),
             m_comm_pending(false),
+            m_overlap_ghost_update(false),
             m_bond_comm(*this, m_sysdef->getBondData()),
             m_angle_comm(*this, m_sysdef->getAngleData()),
             m_dihedral_comm(*this, m_sysdef->getDihedralData()),
@@ -1102,6 +1103,7 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
     assert(m_decomposition);
 
     m_exec_conf->msg->notice(5) << "Constructing Communicator" << endl;
+    m_call_timer = std::shared_ptr<CallTimer>(new CallTimer(m_exec_conf, "time_comm"));
 
     for (unsigned int dir = 0; dir < 6; dir ++)
         {
@@ -1333,6 +1335,8 @@ void Communicator::initializeNeighborArrays()
 //! Interface to the communication methods.
 void Communicator::communicate(unsigned int timestep)
     {
+    CallTimer::Scope timer(*m_call_timer);
+
     // Guard to prevent recursive triggering of migration
     m_is_communicating = true;
 
@@ -1348,6 +1352,11 @@ void Communicator::communicate(unsigned int timestep)
         {
         // do an obligatory update before determining whether to migrate
         beginUpdateGhosts(timestep);
+
+        // compute what does not depend on ghosts while the update is in flight
+        if (m_overlap_ghost_update)
+            m_interior_compute_callbacks.emit(timestep);
+
         finishUpdateGhosts(timestep);
 
         // call subscribers after ghost update, but before distance check
@@ -1357,17 +1366,9 @@ void Communicator::communicate(unsigned int timestep)
         // we will make sure that they are inside by doing a second migrate if necessary
         }
 
-    bool migrate_request = false;
-    if (! m_force_migrate)
-        {
-        // distance check, may not be called directly after particle reorder (such as
-        // due to SFCPackUpdater running before)
-        m_migrate_requests.emit_accumulate( [&](bool r)
-                                                {
-                                                migrate_request = migrate_request || r;
-                                                },
-                                            timestep);
-        }
+    // distance check, may not be called directly after particle reorder (such as
+    // due to SFCPackUpdater running before)
+    bool migrate_request = !m_force_migrate && peekMigrate(timestep);
 
     bool migrate = migrate_request || m_force_migrate || !m_has_ghost_particles;
 
@@ -1376,6 +1377,10 @@ void Communicator::communicate(unsigned int timestep)
         {
         beginUpdateGhosts(timestep);
 
+        // compute what does not depend on ghosts while the update is in flight
+        if (m_overlap_ghost_update)
+            m_interior_compute_callbacks.emit(timestep);
+
         finishUpdateGhosts(timestep);
         }
 
@@ -1399,6 +1404,17 @@ void Communicator::communicate(unsigned int timestep)
     m_is_communicating = false;
     }
 
+bool Communicator::peekMigrate(unsigned int timestep)
+    {
+    bool migrate_request = false;
+    m_migrate_requests.emit_accumulate( [&](bool r)
+                                            {
+                                            migrate_request = migrate_request || r;
+                                            },
+                                        timestep);
+    return migrate_request;
+    }
+
 //! Transfer particles between neighboring domains
 void Communicator::migrateParticles()
     {
@@ -1502,7 +1518,7 @@ void Communicator::migrateParticles()
 
         MPI_Isend(&n_send_ptls, 1, MPI_UNSIGNED, send_neighbor, 0, m_mpi_comm, & m_reqs[0]);
         MPI_Irecv(&n_recv_ptls, 1, MPI_UNSIGNED, recv_neighbor, 0, m_mpi_comm, & m_reqs[1]);
-        MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+        waitAll(2, &m_reqs.front(), &m_stats.front());
 
         // Resize receive buffer
         m_recvbuf.resize(n_recv_ptls);
@@ -1512,7 +1528,7 @@ void Communicator::migrateParticles()
         m_stats.resize(2);
         MPI_Isend(&m_sendbuf.front(), n_send_ptls, m_mpi_pdata_element, send_neighbor, 1, m_mpi_comm, & m_reqs[0]);
         MPI_Irecv(&m_recvbuf.front(), n_recv_ptls, m_mpi_pdata_element, recv_neighbor, 1, m_mpi_comm, & m_reqs[1]);
-        MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+        waitAll(2, &m_reqs.front(), &m_stats.front());
 
         if (m_prof)
             m_prof->pop();
@@ -1820,7 +1836,7 @@ void Communicator::exchangeGhosts()
         m_reqs.push_back(req);
 
         m_stats.resize(2);
-        MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+        waitAll(m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
         if (m_prof)
             m_prof->pop();
@@ -2041,7 +2057,7 @@ void Communicator::exchangeGhosts()
                 }
 
             m_stats.resize(m_reqs.size());
-            MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+            waitAll(m_reqs.size(), &m_reqs.front(), &m_stats.front());
             }
 
         if (m_prof)
@@ -2248,7 +2264,7 @@ void Communicator::exchangeGhosts()
             m_reqs.push_back(req);
 
             m_stats.resize(m_reqs.size());
-            MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+            waitAll(m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
             if (m_prof)
                 m_prof->pop();
@@ -2315,7 +2331,7 @@ void Communicator::exchangeGhosts()
                 m_reqs.push_back(req);
 
                 m_stats.resize(m_reqs.size());
-                MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+                waitAll(m_reqs.size(), &m_reqs.front(), &m_stats.front());
             }
 
             if (m_prof)
@@ -2329,6 +2345,10 @@ void Communicator::exchangeGhosts()
     }
 
 //! update positions of ghost particles
+/*! Messages are posted without waiting for their completion, so that computation can proceed while they are in
+    flight. Ghosts received in one direction may have to be forwarded in a later one (e.g. to a corner domain). In
+    that case, the pending messages are completed before the later direction is packed.
+*/
 void Communicator::beginUpdateGhosts(unsigned int timestep)
     {
     // we have a current m_copy_ghosts liss which contain the indices of particles
@@ -2338,20 +2358,71 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
 
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
+    CommFlags flags = getFlags();
+
+    // every direction packs into its own section of the send buffers, as sends may be in flight concurrently
+    unsigned int copy_offset[6];
+    unsigned int num_tot_copy_ghosts = 0;
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        copy_offset[dir] = num_tot_copy_ghosts;
+        if (isCommunicating(dir))
+            num_tot_copy_ghosts += m_num_copy_ghosts[dir];
+        }
+
+    if (flags[comm_flag::position] && m_pos_copybuf.size() < num_tot_copy_ghosts)
+        m_pos_copybuf.resize(num_tot_copy_ghosts);
+
+    if (flags[comm_flag::velocity] && m_velocity_copybuf.size() < num_tot_copy_ghosts)
+        m_velocity_copybuf.resize(num_tot_copy_ghosts);
+
+    if (flags[comm_flag::orientation] && m_orientation_copybuf.size() < num_tot_copy_ghosts)
+        m_orientation_copybuf.resize(num_tot_copy_ghosts);
+
+    m_reqs.clear();
+    m_pending_ghost_recv.clear();
+
     // update data in these arrays
 
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
+    unsigned int num_done_recv_ghosts = 0; // number of received ghosts whose update has completed
 
     for (unsigned int dir = 0; dir < 6; dir ++)
         {
         if (! isCommunicating(dir) ) continue;
 
-        CommFlags flags = getFlags();
+        // complete the pending messages if this direction forwards any of the ghosts they update
+        if (num_done_recv_ghosts < num_tot_recv_ghosts)
+            {
+            bool forward = false;
+
+                {
+                ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+                ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+                for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                    {
+                    if (h_rtag.data[h_copy_ghosts.data[ghost_idx]] >= m_pdata->getN() + num_done_recv_ghosts)
+                        {
+                        forward = true;
+                        break;
+                        }
+                    }
+                }
+
+            if (forward)
+                {
+                waitGhostUpdate();
+                num_done_recv_ghosts = num_tot_recv_ghosts;
+                }
+            }
+
+        const unsigned int offset = copy_offset[dir];
 
         if (flags[comm_flag::position])
             {
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::overwrite);
+            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::readwrite);
             ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
@@ -2360,17 +2431,17 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
                 {
                 unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+                assert(idx < m_pdata->getN() + num_done_recv_ghosts);
 
                 // copy position into send buffer
-                h_pos_copybuf.data[ghost_idx] = h_pos.data[idx];
+                h_pos_copybuf.data[offset + ghost_idx] = h_pos.data[idx];
                 }
             }
 
         if (flags[comm_flag::velocity])
             {
             ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::overwrite);
+            ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::readwrite);
             ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
@@ -2379,17 +2450,17 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
                 {
                 unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+                assert(idx < m_pdata->getN() + num_done_recv_ghosts);
 
                 // copy velocity into send buffer
-                h_velocity_copybuf.data[ghost_idx] = h_vel.data[idx];
+                h_velocity_copybuf.data[offset + ghost_idx] = h_vel.data[idx];
                 }
             }
 
         if (flags[comm_flag::orientation])
             {
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
+            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::readwrite);
             ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
@@ -2398,10 +2469,10 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
                 {
                 unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+                assert(idx < m_pdata->getN() + num_done_recv_ghosts);
 
                 // copy orientation into send buffer
-                h_orientation_copybuf.data[ghost_idx] = h_orientation.data[idx];
+                h_orientation_copybuf.data[offset + ghost_idx] = h_orientation.data[idx];
                 }
             }
 
@@ -2428,50 +2499,43 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
         size_t sz = 0;
         // only non-permanent fields (position, velocity, orientation) need to be considered here
         // charge, body, image and diameter are not updated between neighbor list builds
+        // the receive buffers point directly into the particle data arrays, which are not reallocated
+        // before the messages complete in waitGhostUpdate()
         if (flags[comm_flag::position])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
-
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_pos_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_pos.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            m_reqs.resize(m_reqs.size()+2);
+            MPI_Isend(h_pos_copybuf.data + offset, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &m_reqs[m_reqs.size()-2]);
+            MPI_Irecv(h_pos.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &m_reqs[m_reqs.size()-1]);
 
             sz += sizeof(Scalar4);
             }
 
         if (flags[comm_flag::velocity])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
-
             ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_vel_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_vel_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_vel.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            m_reqs.resize(m_reqs.size()+2);
+            MPI_Isend(h_vel_copybuf.data + offset, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &m_reqs[m_reqs.size()-2]);
+            MPI_Irecv(h_vel.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &m_reqs[m_reqs.size()-1]);
 
             sz += sizeof(Scalar4);
             }
 
         if (flags[comm_flag::orientation])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
-
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
 
             // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_orientation_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(h_orientation.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            m_reqs.resize(m_reqs.size()+2);
+            MPI_Isend(h_orientation_copybuf.data + offset, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &m_reqs[m_reqs.size()-2]);
+            MPI_Irecv(h_orientation.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &m_reqs[m_reqs.size()-1]);
 
             sz += sizeof(Scalar4);
             }
@@ -2479,14 +2543,59 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
         if (m_prof)
             m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sz);
 
+        // the received positions are wrapped when the messages complete
+        m_pending_ghost_recv.push_back(make_uint2(start_idx, m_num_recv_ghosts[dir]));
+        } // end dir loop
 
-        // wrap particle positions (only if copying positions)
-        if (flags[comm_flag::position])
-            {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    m_comm_pending = true;
 
-            const BoxDim shifted_box = getShiftedBox();
-            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! Finish ghost update
+ *
+ * \param timestep The time step
+ */
+void Communicator::finishUpdateGhosts(unsigned int timestep)
+    {
+    if (! m_comm_pending)
+        return;
+
+    if (m_prof)
+        m_prof->push("comm_ghost_update");
+
+    waitGhostUpdate();
+    m_comm_pending = false;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void Communicator::waitGhostUpdate()
+    {
+    if (m_reqs.size())
+        {
+        if (m_prof)
+            m_prof->push("MPI wait");
+
+        m_stats.resize(m_reqs.size());
+        MPI_Waitall(m_reqs.size(), &m_reqs.front(), &m_stats.front());
+        m_reqs.clear();
+
+        if (m_prof)
+            m_prof->pop();
+        }
+
+    // wrap particle positions (only if copying positions)
+    if (getFlags()[comm_flag::position])
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+
+        const BoxDim shifted_box = getShiftedBox();
+        for (auto it = m_pending_ghost_recv.begin(); it != m_pending_ghost_recv.end(); ++it)
+            {
+            for (unsigned int idx = it->x; idx < it->x + it->y; idx++)
                 {
                 Scalar4& pos = h_pos.data[idx];
 
@@ -2495,11 +2604,9 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
                 shifted_box.wrap(pos, img);
                 }
             }
+        }
 
-        } // end dir loop
-
-        if (m_prof)
-            m_prof->pop();
+    m_pending_ghost_recv.clear();
     }
 
 void Communicator::updateNetForce(unsigned int timestep)
@@ -2711,7 +2818,7 @@ void Communicator::updateNetForce(unsigned int timestep)
             // exchange particle data, write directly to the particle data arrays
             MPI_Isend(h_netforce_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &m_reqs[0]);
             MPI_Irecv(h_netforce.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            waitAll(2, &m_reqs.front(), &m_stats.front());
 
             sz += sizeof(Scalar4);
             }
@@ -2734,7 +2841,7 @@ void Communicator::updateNetForce(unsigned int timestep)
 
                 MPI_Isend(h_netforce_reverse_copybuf.data, (m_num_copy_local_ghosts_reverse[dir] + m_num_forward_ghosts_reverse[dir])*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &m_reqs[0]);
                 MPI_Irecv(h_netforce_reverse_recvbuf.data + start_idx_reverse, (m_num_recv_local_ghosts_reverse[dir] + m_num_recv_forward_ghosts_reverse[dir])*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &m_reqs[1]);
-                MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+                waitAll(2, &m_reqs.front(), &m_stats.front());
 
                 sz += sizeof(Scalar4);
                 }
@@ -2774,7 +2881,7 @@ void Communicator::updateNetForce(unsigned int timestep)
 
             MPI_Isend(h_nettorque_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &m_reqs[0]);
             MPI_Irecv(h_nettorque.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            waitAll(2, &m_reqs.front(), &m_stats.front());
 
             sz += sizeof(Scalar4);
             }
@@ -2790,7 +2897,7 @@ void Communicator::updateNetForce(unsigned int timestep)
 
             MPI_Isend(h_netvirial_copybuf.data, 6*m_num_copy_ghosts[dir]*sizeof(Scalar), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &m_reqs[0]);
             MPI_Irecv(h_netvirial_recvbuf.data, 6*m_num_recv_ghosts[dir]*sizeof(Scalar), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            waitAll(2, &m_reqs.front(), &m_stats.front());
 
             sz += 6*sizeof(Scalar);
             }
@@ -2925,6 +3032,8 @@ const BoxDim Communicator::getShiftedBox() const
 void export_Communicator(py::module& m)
     {
     py::class_<Communicator, std::shared_ptr<Communicator> >(m,"Communicator")
-    .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >());
+    .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >())
+    .def("setOverlapGhostUpdate", &Communicator::setOverlapGhostUpdate)
+    .def("getOverlapGhostUpdate", &Communicator::getOverlapGhostUpdate);
     }
 #endif // ENABLE_MPI
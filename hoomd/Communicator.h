@@ -23,6 +23,7 @@
 #include "ParticleData.h"
 #include "BondedGroupData.h"
 #include "DomainDecomposition.h"
+#include "CallTimer.h"
 
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
@@ -172,6 +173,12 @@ class PYBIND11_EXPORT Communicator
             m_prof = prof;
             }
 
+        //! Get the timer of the calls to communicate()
+        std::shared_ptr<CallTimer> getCallTimer() const
+            {
+            return m_call_timer;
+            }
+
         //! Subscribe to list of functions that determine when the particles are migrated
         /*! This method keeps track of all functions that may request particle migration.
          * \return A Nano::Signal object reference to be used for connect and disconnect calls.
@@ -181,6 +188,15 @@ class PYBIND11_EXPORT Communicator
             return m_migrate_requests;
             }
 
+        //! Check whether any subscriber to getMigrateSignal() requests particle migration
+        /*! \param timestep Current time step
+         * \return true if the particles will be migrated in communicate() (unless a migration is forced anyway)
+         *
+         * The neighbor lists cache their check for the time step, so this may be called ahead of the migration check
+         * in communicate() as long as the local particles do not move in between.
+         */
+        bool peekMigrate(unsigned int timestep);
+
         //! Subscribe to list of functions that request a minimum ghost layer width
         /*! This method keeps track of all functions that request a minimum ghost layer width
          * The actual ghost layer width is chosen from the max over the inputs
@@ -238,6 +254,33 @@ class PYBIND11_EXPORT Communicator
             return m_compute_callbacks;
             }
 
+        //! Subscribe to list of *optional* call-backs for computation that does not involve ghost particles
+        /*!
+         * When the ghost update is overlapped with computation (see setOverlapGhostUpdate()), these call-backs are
+         * called between beginUpdateGhosts() and finishUpdateGhosts(), before the particle migration check. They may
+         * only read local particle data, and their results are invalid if particles migrate afterwards.
+         *
+         * \return A Nano::Signal object reference to be used for connect and disconnect calls.
+         */
+        Nano::Signal<void (unsigned int timestep)>& getInteriorComputeCallbackSignal()
+            {
+            return m_interior_compute_callbacks;
+            }
+
+        //! Set whether to overlap the ghost update with computation
+        /*! \param overlap True if the interior compute call-backs are called while the ghost update is in flight
+         */
+        void setOverlapGhostUpdate(bool overlap)
+            {
+            m_overlap_ghost_update = overlap;
+            }
+
+        //! Get whether the ghost update is overlapped with computation
+        bool getOverlapGhostUpdate() const
+            {
+            return m_overlap_ghost_update;
+            }
+
         //! Get the ghost communication flags
         CommFlags getFlags() { return m_flags; }
 
@@ -310,11 +353,7 @@ class PYBIND11_EXPORT Communicator
          *
          * \param timestep The time step
          */
-        virtual void finishUpdateGhosts(unsigned int timestep)
-            {
-            // the base class implementation is currently empty
-            m_comm_pending = false;
-            }
+        virtual void finishUpdateGhosts(unsigned int timestep);
 
         /*! Communicate the net particle force
          * \parm timestep The time step
@@ -462,6 +501,7 @@ class PYBIND11_EXPORT Communicator
         const MPI_Comm m_mpi_comm; //!< MPI communicator
         std::shared_ptr<DomainDecomposition> m_decomposition;       //!< Domain decomposition information
         std::shared_ptr<Profiler> m_prof;                           //!< Profiler
+        std::shared_ptr<CallTimer> m_call_timer;                    //!< Timer of the calls to communicate()
 
         bool m_is_communicating;               //!< Whether we are currently communicating
         bool m_force_migrate;                  //!< True if particle migration is forced
@@ -542,6 +582,9 @@ class PYBIND11_EXPORT Communicator
         Nano::Signal<void (unsigned int timestep)>
             m_compute_callbacks;   //!< List of functions that are called after ghost communication
 
+        Nano::Signal<void (unsigned int timestep)>
+            m_interior_compute_callbacks;   //!< List of functions that are called while ghost communication is pending
+
         Nano::Signal<void (const GlobalArray<unsigned int>& )>
             m_comm_callbacks;   //!< List of functions that are called after the compute callbacks
 
@@ -552,6 +595,20 @@ class PYBIND11_EXPORT Communicator
         std::vector<MPI_Request> m_reqs; //!< Container for all MPI communication requests
         std::vector<MPI_Status> m_stats; //!< Container for all MPI communication statuses
 
+        bool m_overlap_ghost_update;             //!< True if computation is overlapped with the ghost update
+        std::vector<uint2> m_pending_ghost_recv; //!< First index and number of ghosts with a pending update
+
+        //! Wait for all pending ghost update messages and wrap the received positions
+        void waitGhostUpdate();
+
+        //! Wait for MPI requests to complete, profiling the time spent waiting
+        void waitAll(unsigned int n, MPI_Request *reqs, MPI_Status *stats)
+            {
+            if (m_prof) m_prof->push("MPI wait");
+            MPI_Waitall(n, reqs, stats);
+            if (m_prof) m_prof->pop();
+            }
+
         /* Bonds communication */
         bool m_bonds_changed;                          //!< True if bond information needs to be refreshed
         void setBondsChanged()
@@ -29,6 +29,8 @@ Compute::Compute(std::shared_ptr<SystemDefinition> sysdef) : m_sysdef(sysdef), m
     assert(m_sysdef);
     assert(m_pdata);
     assert(m_exec_conf);
+
+    m_call_timer = std::shared_ptr<CallTimer>(new CallTimer(m_exec_conf));
     }
 
 /*! \param num_iters Number of iterations to average for the benchmark
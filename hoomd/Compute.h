@@ -6,6 +6,7 @@
 
 #include "SystemDefinition.h"
 #include "Profiler.h"
+#include "CallTimer.h"
 #include "SharedSignal.h"
 
 #include <memory>
@@ -91,6 +92,14 @@ class PYBIND11_EXPORT Compute
         //! Sets the profiler for the compute to use
         virtual void setProfiler(std::shared_ptr<Profiler> prof);
 
+        //! Get the timer of the calls to compute()
+        /*! The timer is registered with loggers when it has a name (see CallTimer).
+        */
+        std::shared_ptr<CallTimer> getCallTimer() const
+            {
+            return m_call_timer;
+            }
+
         //! Set autotuner parameters
         /*! \param enable Enable/disable autotuning
             \param period period (approximate) in time steps when returning occurs
@@ -196,6 +205,7 @@ class PYBIND11_EXPORT Compute
         const std::shared_ptr<SystemDefinition> m_sysdef; //!< The system definition this compute is associated with
         const std::shared_ptr<ParticleData> m_pdata;      //!< The particle data this compute is associated with
         std::shared_ptr<Profiler> m_prof;                 //!< The profiler this compute is to use
+        std::shared_ptr<CallTimer> m_call_timer;          //!< Timer of the calls to compute()
 #ifdef ENABLE_MPI
         std::shared_ptr<Communicator> m_comm;             //!< The communicator this compute is to use
 #endif
@@ -612,6 +612,42 @@ unsigned int DomainDecomposition::placeParticle(const BoxDim& global_box, Scalar
     return rank;
     }
 
+/*!
+ * \param global_box Global simulation box
+ * \param pos Particle position (wrapped if it is exactly on the upper boundary)
+ * \param img Particle image (updated with the wrap)
+ * \param cart_ranks Cartesian rank lookup table
+ * \returns the rank of the processor that should receive the particle
+ *
+ * Places a particle read from a snapshot. Unlike placeParticle(), particles on the upper boundary of the global box
+ * are wrapped into the lowest domain.
+ */
+unsigned int DomainDecomposition::placeSnapshotParticle(const BoxDim& global_box, Scalar3& pos, int3& img,
+    const unsigned int *cart_ranks)
+    {
+    Scalar3 f = global_box.makeFraction(pos);
+    int i = f.x * ((Scalar)m_index.getW());
+    int j = f.y * ((Scalar)m_index.getH());
+    int k = f.z * ((Scalar)m_index.getD());
+
+    // we only need to wrap in the negative direction, since processor ids are rounded toward zero
+    char3 flags = make_char3(0,0,0);
+    if (i == (int) m_index.getW())
+        flags.x = 1;
+    if (j == (int) m_index.getH())
+        flags.y = 1;
+    if (k == (int) m_index.getD())
+        flags.z = 1;
+
+    // only wrap if the particles is on one of the boundaries
+    BoxDim box = global_box;
+    box.setPeriodic(make_uchar3(flags.x,flags.y,flags.z));
+    box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    return placeParticle(global_box, pos, cart_ranks);
+    }
+
 void DomainDecomposition::findCommonNodes()
     {
     // get MPI node name
@@ -158,6 +158,10 @@ class PYBIND11_EXPORT DomainDecomposition
         //! Get the rank for a particle to be placed
         unsigned int placeParticle(const BoxDim& global_box, Scalar3 pos, const unsigned int *cart_ranks);
 
+        //! Get the rank for a snapshot particle to be placed, wrapping it on the upper boundary
+        unsigned int placeSnapshotParticle(const BoxDim& global_box, Scalar3& pos, int3& img,
+            const unsigned int *cart_ranks);
+
         //! Get the number of grid cells in each dimension.
         uint3 getGridSize(void)const{return make_uint3(m_nx,m_ny,m_nz);}
     private:
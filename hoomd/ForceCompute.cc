@@ -17,6 +17,7 @@
 #endif
 
 #include <iostream>
+#include <stdexcept>
 using namespace std;
 
 namespace py = pybind11;
@@ -29,7 +30,7 @@ namespace py = pybind11;
     \post All forces are initialized to 0
 */
 ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
-     : Compute(sysdef), m_particles_sorted(false)
+     : Compute(sysdef), m_particles_sorted(false), m_mts_period(1), m_mts_energy(0.0)
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
@@ -85,6 +86,9 @@ ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
 
     m_external_energy = Scalar(0.0);
 
+    for (unsigned int i = 0; i < 6; ++i)
+        m_mts_virial[i] = Scalar(0.0);
+
     // initialize GPU memory hints
     updateGPUAdvice();
     }
@@ -279,6 +283,7 @@ void ForceCompute::compute(unsigned int timestep)
     if (!m_particles_sorted && !shouldCompute(timestep))
         return;
 
+    CallTimer::Scope timer(*m_call_timer);
     computeForces(timestep);
     m_particles_sorted = false;
     }
@@ -411,6 +416,23 @@ Scalar ForceCompute::getEnergy(unsigned int tag)
     return result;
     }
 
+/*! \param period Number of time steps between applications of this force by the integrator
+
+    With a period larger than one, the Integrator evaluates this force only on time steps that are a multiple of
+    \a period and applies it as an impulse \a period times larger (impulse r-RESPA). Slowly varying, expensive
+    forces can then be evaluated less often than the fast forces that limit the time step.
+*/
+void ForceCompute::setMTSPeriod(unsigned int period)
+    {
+    if (period == 0)
+        {
+        m_exec_conf->msg->error() << "force: The multiple time step period must be positive" << endl;
+        throw runtime_error("Error setting multiple time step period");
+        }
+
+    m_mts_period = period;
+    }
+
 void export_ForceCompute(py::module& m)
     {
     py::class_< ForceCompute, std::shared_ptr<ForceCompute> >(m,"ForceCompute",py::base<Compute>())
@@ -422,5 +444,7 @@ void export_ForceCompute(py::module& m)
     .def("calcEnergyGroup", &ForceCompute::calcEnergyGroup)
     .def("calcForceGroup", &ForceCompute::calcForceGroup)
     .def("calcVirialGroup", &ForceCompute::calcVirialGroup)
+    .def("setMTSPeriod", &ForceCompute::setMTSPeriod)
+    .def("getMTSPeriod", &ForceCompute::getMTSPeriod)
     ;
     }
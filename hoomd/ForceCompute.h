@@ -63,12 +63,55 @@ class PYBIND11_EXPORT ForceCompute : public Compute
             m_deltaT = dt;
             }
 
+        //! Set the multiple time step period
+        void setMTSPeriod(unsigned int period);
+
+        //! Get the multiple time step period
+        unsigned int getMTSPeriod() const
+            {
+            return m_mts_period;
+            }
+
+        //! Test if the integrator applies this force on the given timestep
+        bool isMTSStep(unsigned int timestep) const
+            {
+            return timestep % m_mts_period == 0;
+            }
+
+        //! Store the local energy and virial of the last applied evaluation
+        void setMTSTotals(Scalar energy, const Scalar *virial)
+            {
+            m_mts_energy = energy;
+            for (unsigned int k = 0; k < 6; ++k)
+                m_mts_virial[k] = virial[k];
+            }
+
+        //! Get the local energy of the last applied evaluation
+        Scalar getMTSEnergy() const
+            {
+            return m_mts_energy;
+            }
+
+        //! Get the local virial of the last applied evaluation
+        Scalar getMTSVirial(unsigned int dir) const
+            {
+            assert(dir<6);
+            return m_mts_virial[dir];
+            }
+
         #ifdef ENABLE_MPI
         //! Pre-compute the forces
         /*! This method is called in MPI simulations BEFORE the particles are migrated
          * and can be used to overlap computation with communication
          */
         virtual void preCompute(unsigned int timestep){}
+
+        //! Compute the forces that do not depend on ghost particles
+        /*! This method is called in MPI simulations while the ghost positions are being updated,
+         * when the overlap is enabled in the Communicator. A subsequent call to compute() must
+         * complete the forces.
+         */
+        virtual void computeInterior(unsigned int timestep){}
         #endif
 
         //! Computes the forces
@@ -189,6 +232,10 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         Scalar m_external_virial[6]; //!< Stores external contribution to virial
         Scalar m_external_energy;    //!< Stores external contribution to potential energy
 
+        unsigned int m_mts_period;   //!< The integrator applies this force every m_mts_period steps
+        Scalar m_mts_energy;         //!< Local energy of the last applied evaluation (including external)
+        Scalar m_mts_virial[6];      //!< Local virial of the last applied evaluation (including external)
+
         //! Actually perform the computation of the forces
         /*! This is pure virtual here. Sub-classes must implement this function. It will be called by
             the base class compute() when the forces need to be computed.
@@ -243,7 +243,18 @@ class GPUArrayBase
             static_cast<Derived&>(*this).resize(width,height);
             }
 
+        //! Get the number of times the data has been acquired for writing or resized
+        /*! Together with the data pointer, this identifies the contents of the array, so that classes can cache values
+            derived from it. The count moves with the data in swap().
+        */
+        unsigned int getWriteCount() const
+            {
+            return m_write_count;
+            }
+
     protected:
+        mutable unsigned int m_write_count = 0;     //!< Number of acquisitions for writing and resizes
+
         //! Acquires the data pointer for use
         inline ArrayHandleDispatch<T> acquire(const access_location::Enum location, const access_mode::Enum mode
         #ifdef ENABLE_CUDA
@@ -251,6 +262,9 @@ class GPUArrayBase
         #endif
                         ) const
             {
+            if (mode != access_mode::read)
+                m_write_count++;
+
             return static_cast<Derived const&>(*this).acquire(location, mode
             #ifdef ENABLE_CUDA
                 , async
@@ -783,6 +797,7 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(const GPUArray& rhs) noexc
 #endif
         // initialize state variables
         m_data_location = data_location::host;
+        this->m_write_count++;
 
         // copy over the data to the new GPUArray
         if (rhs.h_data)
@@ -820,7 +835,9 @@ template<class T> GPUArray<T>::GPUArray(GPUArray&& from) noexcept
 #endif
     h_data(std::move(from.h_data)),
     m_exec_conf(std::move(from.m_exec_conf))
-    { }
+    {
+    this->m_write_count = from.m_write_count;
+    }
 
 //! Move assignment operator
 template<class T> GPUArray<T>& GPUArray<T>::operator=(GPUArray&& rhs) noexcept
@@ -838,6 +855,7 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(GPUArray&& rhs) noexcept
         h_data = std::move(rhs.h_data);
         m_data_location = std::move(rhs.m_data_location);
         m_acquired = std::move(rhs.m_acquired);
+        this->m_write_count = rhs.m_write_count;
         }
 
     return *this;
@@ -872,6 +890,7 @@ template<class T> void GPUArray<T>::swap(GPUArray& from)
     std::swap(m_mapped, from.m_mapped);
 #endif
     std::swap(h_data, from.h_data);
+    std::swap(this->m_write_count, from.m_write_count);
     }
 
 /*! \pre m_num_elements is set
@@ -1417,6 +1436,8 @@ template<class T> void GPUArray<T>::resize(unsigned int num_elements)
     assert(! m_acquired);
     assert(num_elements > 0);
 
+    this->m_write_count++;
+
     // if not allocated, simply allocate
     if (isNull())
         {
@@ -1454,6 +1475,8 @@ template<class T> void GPUArray<T>::resize(unsigned int width, unsigned int heig
     {
     assert(! m_acquired);
 
+    this->m_write_count++;
+
     // make m_pitch the next multiple of 16 larger or equal to the given width
     unsigned int new_pitch = (width + (16 - (width & 15)));
 
@@ -14,6 +14,10 @@
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
+#include "HOOMDMPI.h"
+
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 #include "hoomd/extern/pybind/include/pybind11/stl_bind.h"
@@ -22,6 +26,8 @@
 #include <string.h>
 #include <stdexcept>
 #include <list>
+#include <algorithm>
+#include <cstddef>
 using namespace std;
 namespace py = pybind11;
 
@@ -44,7 +50,13 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     : Analyzer(sysdef), m_fname(fname), m_overwrite(overwrite),
                         m_truncate(truncate),
                         m_is_initialized(false),
-                        m_group(group)
+                        m_parallel_write(false),
+                        m_async_write(false),
+                        #ifdef ENABLE_MPI
+                        m_fd(-1),
+                        #endif
+                        m_group(group),
+                        m_writer_exit(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing GSDDumpWriter: " << m_fname << " " << overwrite << " " << truncate << endl;
     }
@@ -52,16 +64,21 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
 void GSDDumpWriter::checkError(int retval)
     {
     // checkError prints errors and then throws exceptions for common gsd error codes
+    if (retval == 0)
+        return;
+
+    ostringstream message;
     if (retval == -1)
-        {
-        m_exec_conf->msg->error() << "dump.gsd: " << strerror(errno) << " - " << m_fname << endl;
-        throw runtime_error("Error writing GSD file");
-        }
-    else if (retval != 0)
-        {
-        m_exec_conf->msg->error() << "dump.gsd: " << "Unknown error " << retval << " writing: " << m_fname << endl;
-        throw runtime_error("Error writing GSD file");
-        }
+        message << strerror(errno) << " - " << m_fname;
+    else
+        message << "Unknown error " << retval << " writing: " << m_fname;
+
+    // the writer thread must not access the messenger, waitForWriter() prints its errors
+    if (std::this_thread::get_id() == m_writer_thread.get_id())
+        throw runtime_error(message.str());
+
+    m_exec_conf->msg->error() << "dump.gsd: " << message.str() << endl;
+    throw runtime_error("Error writing GSD file");
     }
 
 //! Initializes the output file for writing
@@ -76,10 +93,13 @@ void GSDDumpWriter::initFileIO()
         o << "HOOMD-blue " << HOOMD_VERSION_LONG;
 
         m_exec_conf->msg->notice(3) << "dump.gsd: create gsd file " << m_fname << endl;
+        // only files with encoded chunks need the new schema version, keep the others readable by older readers
+        uint32_t schema_version = m_precision.empty() ? gsd_make_version(1,3)
+                                                      : hoomd::detail::gsd_encoded_schema_version();
         retval = gsd_create(m_fname.c_str(),
                             o.str().c_str(),
                             "hoomd",
-                            gsd_make_version(1,3));
+                            schema_version);
         if (retval != 0)
             {
             m_exec_conf->msg->error() << "dump.gsd: " << strerror(errno) << " - " << m_fname << endl;
@@ -130,12 +150,19 @@ void GSDDumpWriter::initFileIO()
         m_exec_conf->msg->error() << "dump.gsd: " << "Invalid schema in " << m_fname << endl;
         throw runtime_error("Error opening GSD file");
         }
-    if (m_handle.header.schema_version >= gsd_make_version(2,0))
+    if (m_handle.header.schema_version >= gsd_make_version(3,0))
         {
         m_exec_conf->msg->error() << "dump.gsd: " << "Invalid schema version in " << m_fname << endl;
         throw runtime_error("Error opening GSD file");
         }
 
+    if (!m_precision.empty() && m_handle.header.schema_version < hoomd::detail::gsd_encoded_schema_version())
+        {
+        m_exec_conf->msg->error() << "dump.gsd: " << "Cannot append quantized frames to " << m_fname
+                                  << ", it was written without quantization" << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+
     m_is_initialized = true;
     }
 
@@ -143,6 +170,25 @@ GSDDumpWriter::~GSDDumpWriter()
     {
     m_exec_conf->msg->notice(5) << "Destroying GSDDumpWriter" << endl;
 
+    if (m_writer_thread.joinable())
+        {
+        // complete the last frame, but do not throw from the destructor
+        try
+            {
+            waitForWriter();
+            }
+        catch (const std::exception&)
+            {
+            }
+
+            {
+            std::lock_guard<std::mutex> lock(m_writer_mutex);
+            m_writer_exit = true;
+            }
+        m_writer_cv.notify_all();
+        m_writer_thread.join();
+        }
+
     bool root=true;
     #ifdef ENABLE_MPI
     root = m_exec_conf->isRoot();
@@ -153,12 +199,19 @@ GSDDumpWriter::~GSDDumpWriter()
         m_exec_conf->msg->notice(5) << "dump.gsd: close gsd file " << m_fname << endl;
         gsd_close(&m_handle);
         }
+
+    #ifdef ENABLE_MPI
+    if (m_fd != -1)
+        ::close(m_fd);
+    #endif
     }
 
 /*! \param timestep Current time step of the simulation
 
     The first call to analyze() will create or overwrite the file and write out the current system configuration
     as frame 0. Subsequent calls will append frames to the file, or keep overwriting frame 0 if m_truncate is true.
+
+    In asynchronous mode, analyze() returns after capturing the frame and the writer thread writes it to the file.
 */
 void GSDDumpWriter::analyze(unsigned int timestep)
     {
@@ -168,16 +221,19 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     if (m_prof)
         m_prof->push("Dump GSD");
 
-    // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
-    SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
-
+    bool parallel = false;
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
     root = m_exec_conf->isRoot();
+
+    // in parallel mode, the ranks write the particle data without gathering it first
+    parallel = m_parallel_write && m_exec_conf->getNRanks() > 1;
 #endif
 
+    // the file handle is only accessed by one thread at a time
+    if (root)
+        waitForWriter();
+
     // open the file if it is not yet opened
     if (! m_is_initialized && root)
         initFileIO();
@@ -230,61 +286,164 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     bcast(nframes, 0, m_exec_conf->getMPICommunicator());
     #endif
 
-    if (root)
+    // capture everything the frame needs, so that it can be written while the simulation continues
+    std::shared_ptr<GSDFrame> frame(new GSDFrame);
+    frame->timestep = timestep;
+    frame->nframes = nframes;
+    frame->box = m_pdata->getGlobalBox();
+    frame->dimensions = m_sysdef->getNDimensions();
+    frame->N = m_group->getNumMembersGlobal();
+    frame->write_particles = !parallel;
+    frame->prof = m_prof;
+
+    if (!parallel)
         {
-        // write out the frame header on all frames
-        writeFrameHeader(timestep);
+        // take particle data snapshot
+        m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
+        frame->map = m_pdata->takeSnapshot<float>(frame->snapshot);
 
-        // only write out data chunk categories if requested, or if on frame 0
-        if (m_write_attribute || nframes == 0)
-            writeAttributes(snapshot, map);
-        if (m_write_property || nframes == 0)
-            writeProperties(snapshot, map);
-        if (m_write_momentum || nframes == 0)
-            writeMomenta(snapshot, map);
+        if (root)
+            {
+            ArrayHandle<unsigned int> h_member_tags(m_group->getMemberTagArray(), access_location::host, access_mode::read);
+            frame->tags.assign(h_member_tags.data, h_member_tags.data + frame->N);
+            }
         }
 
+    #ifdef ENABLE_MPI
+    if (parallel)
+        writeParticlesParallel(nframes, root);
+    #endif
+
     // topology is only meaningful if this is the all group
-    if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal() && (m_write_topology || nframes == 0))
+    frame->write_topology = m_group->getNumMembersGlobal() == m_pdata->getNGlobal() && (m_write_topology || nframes == 0);
+    if (frame->write_topology)
         {
-        BondData::Snapshot bdata_snapshot;
-        m_sysdef->getBondData()->takeSnapshot(bdata_snapshot);
-
-        AngleData::Snapshot adata_snapshot;
-        m_sysdef->getAngleData()->takeSnapshot(adata_snapshot);
-
-        DihedralData::Snapshot ddata_snapshot;
-        m_sysdef->getDihedralData()->takeSnapshot(ddata_snapshot);
-
-        ImproperData::Snapshot idata_snapshot;
-        m_sysdef->getImproperData()->takeSnapshot(idata_snapshot);
-
-        ConstraintData::Snapshot cdata_snapshot;
-        m_sysdef->getConstraintData()->takeSnapshot(cdata_snapshot);
-
-        PairData::Snapshot pdata_snapshot;
-        m_sysdef->getPairData()->takeSnapshot(pdata_snapshot);
-
-        if (root)
-            writeTopology(bdata_snapshot, adata_snapshot, ddata_snapshot, idata_snapshot, cdata_snapshot, pdata_snapshot);
+        m_sysdef->getBondData()->takeSnapshot(frame->bond);
+        m_sysdef->getAngleData()->takeSnapshot(frame->angle);
+        m_sysdef->getDihedralData()->takeSnapshot(frame->dihedral);
+        m_sysdef->getImproperData()->takeSnapshot(frame->improper);
+        m_sysdef->getConstraintData()->takeSnapshot(frame->constraint);
+        m_sysdef->getPairData()->takeSnapshot(frame->pair);
         }
 
     // emit on all ranks, the slot needs to handle the mpi logic.
     m_write_signal.emit(m_handle);
 
-    writeUser(timestep, root);
+    evaluateUser(timestep, root, frame->user);
 
     if (root)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: ending frame" << endl;
-        retval = gsd_end_frame(&m_handle);
-        checkError(retval);
+        // the writer thread cannot print the per-chunk notices
+        if (m_async_write && m_exec_conf->msg->getNoticeLevel() < 10)
+            {
+                {
+                std::lock_guard<std::mutex> lock(m_writer_mutex);
+                m_writer_frame = frame;
+                if (!m_writer_thread.joinable())
+                    m_writer_thread = std::thread(&GSDDumpWriter::writerLoop, this);
+                }
+            m_writer_cv.notify_all();
+            }
+        else
+            {
+            writeFrame(*frame);
+            }
         }
 
     if (m_prof)
         m_prof->pop();
     }
 
+/*! \param frame Frame to write
+
+    Writes all chunks of the frame that were not written by analyze() and ends the frame.
+*/
+void GSDDumpWriter::writeFrame(const GSDFrame& frame)
+    {
+    // write out the frame header on all frames
+    writeFrameHeader(frame);
+
+    // only write out data chunk categories if requested, or if on frame 0
+    if (frame.write_particles && (m_write_attribute || frame.nframes == 0))
+        writeAttributes(frame);
+    if (frame.write_particles && (m_write_property || frame.nframes == 0))
+        writeProperties(frame);
+    if (frame.write_particles && (m_write_momentum || frame.nframes == 0))
+        writeMomenta(frame);
+
+    if (frame.write_topology)
+        writeTopology(frame.bond, frame.angle, frame.dihedral, frame.improper, frame.constraint, frame.pair);
+
+    writeUser(frame.user);
+
+    m_exec_conf->msg->notice(10) << "dump.gsd: ending frame" << endl;
+    int retval = gsd_end_frame(&m_handle);
+    checkError(retval);
+    }
+
+/*! The writer thread waits for analyze() to hand it a frame, writes it, and then notifies waitForWriter().
+*/
+void GSDDumpWriter::writerLoop()
+    {
+    std::unique_lock<std::mutex> lock(m_writer_mutex);
+    while (true)
+        {
+        m_writer_cv.wait(lock, [this] { return m_writer_frame || m_writer_exit; });
+        if (!m_writer_frame)
+            return;
+
+        std::shared_ptr<GSDFrame> frame = m_writer_frame;
+        lock.unlock();
+
+        std::string error;
+        try
+            {
+            int64_t start_time = frame->prof ? frame->prof->getTime() : 0;
+            writeFrame(*frame);
+            if (frame->prof)
+                frame->prof->traceEvent("Write GSD", start_time, frame->prof->getTime());
+            }
+        catch (const std::exception& e)
+            {
+            error = e.what();
+            }
+
+        lock.lock();
+        m_writer_error = error;
+        m_writer_frame.reset();
+        m_writer_cv.notify_all();
+        }
+    }
+
+void GSDDumpWriter::waitForWriter()
+    {
+    std::string error;
+        {
+        std::unique_lock<std::mutex> lock(m_writer_mutex);
+        m_writer_cv.wait(lock, [this] { return !m_writer_frame; });
+        error.swap(m_writer_error);
+        }
+
+    if (error != "")
+        {
+        m_exec_conf->msg->error() << "dump.gsd: " << error << endl;
+        throw runtime_error("Error writing GSD file");
+        }
+    }
+
+/*! Blocks until the frame being written in the background (if any) is in the file.
+*/
+void GSDDumpWriter::flush()
+    {
+    bool root=true;
+    #ifdef ENABLE_MPI
+    root = m_exec_conf->isRoot();
+    #endif
+
+    if (root)
+        waitForWriter();
+    }
+
 
 void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping)
     {
@@ -306,7 +465,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
 
     }
 
-/*! \param timestep
+/*! \param frame Frame to write
 
     Write the data chunks configuration/step, configuration/box, and particles/N. If this is frame 0, also write
     configuration/dimensions.
@@ -314,24 +473,24 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
     N is not strictly necessary for constant N data, but is always written in case the user fails to select
     dynamic attributes with a variable N file.
 */
-void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
+void GSDDumpWriter::writeFrameHeader(const GSDFrame& frame)
     {
     int retval;
     m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/step" << endl;
-    uint64_t step = timestep;
+    uint64_t step = frame.timestep;
     retval = gsd_write_chunk(&m_handle, "configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void *)&step);
     checkError(retval);
 
-    if (gsd_get_nframes(&m_handle) == 0)
+    if (frame.nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/dimensions" << endl;
-        uint8_t dimensions = m_sysdef->getNDimensions();
+        uint8_t dimensions = frame.dimensions;
         retval = gsd_write_chunk(&m_handle, "configuration/dimensions", GSD_TYPE_UINT8, 1, 1, 0, (void *)&dimensions);
         checkError(retval);
         }
 
     m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/box" << endl;
-    BoxDim box = m_pdata->getGlobalBox();
+    const BoxDim& box = frame.box;
     float box_a[6];
     box_a[0] = box.getL().x;
     box_a[1] = box.getL().y;
@@ -343,20 +502,22 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
     checkError(retval);
 
     m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/N" << endl;
-    uint32_t N = m_group->getNumMembersGlobal();
+    uint32_t N = frame.N;
     retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
     checkError(retval);
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
+/*! \param frame Frame to write
 
     Writes the data chunks types, typeid, mass, charge, diameter, body, moment_inertia in particles/.
 */
-void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
+void GSDDumpWriter::writeAttributes(const GSDFrame& frame)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
+    const SnapshotParticleData<float>& snapshot = frame.snapshot;
+    const std::map<unsigned int, unsigned int>& map = frame.map;
+    uint32_t N = frame.N;
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = frame.nframes;
 
     writeTypeMapping("particles/types", snapshot.type_mapping);
 
@@ -367,7 +528,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -396,7 +557,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -421,7 +582,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -445,7 +606,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -474,7 +635,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -503,7 +664,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -532,15 +693,44 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         }
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
+/*! \param name Name of the chunk
+    \param N Number of rows
+    \param M Number of columns
+    \param data Values to write (N*M)
+
+    Writes the chunk quantized when a precision is set for it, otherwise writes the raw floats.
+*/
+void GSDDumpWriter::writeFloatChunk(const char *name, uint32_t N, uint32_t M, const std::vector<float>& data)
+    {
+    int retval;
+    auto precision = m_precision.find(name);
+    if (precision != m_precision.end() && N > 0)
+        {
+        std::vector<uint8_t> encoded;
+        if (hoomd::detail::gsd_encode_quantized(encoded, &data[0], N, M, precision->second))
+            {
+            retval = gsd_write_chunk(&m_handle, name, GSD_TYPE_UINT8, encoded.size(), 1, 0, (void *)&encoded[0]);
+            checkError(retval);
+            return;
+            }
+        // values that cannot be quantized are written exactly
+        }
+
+    retval = gsd_write_chunk(&m_handle, name, GSD_TYPE_FLOAT, N, M, 0, (void *)&data[0]);
+    checkError(retval);
+    }
+
+/*! \param frame Frame to write
 
     Writes the data chunks position and orientation in particles/.
 */
-void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
+void GSDDumpWriter::writeProperties(const GSDFrame& frame)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
+    const SnapshotParticleData<float>& snapshot = frame.snapshot;
+    const std::map<unsigned int, unsigned int>& map = frame.map;
+    uint32_t N = frame.N;
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = frame.nframes;
 
         {
         std::vector<float> data(uint64_t(N)*3);
@@ -548,7 +738,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -560,8 +750,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
             }
 
         m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle, "particles/position", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
-        checkError(retval);
+        writeFloatChunk("particles/position", N, 3, data);
         }
 
         {
@@ -571,7 +760,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -594,23 +783,24 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
         if (!all_default || (nframes > 0 && m_nondefault["particles/orientation"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/orientation" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/orientation", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
-            checkError(retval);
+            writeFloatChunk("particles/orientation", N, 4, data);
             if (nframes == 0)
                 m_nondefault["particles/orientation"] = true;
             }
         }
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
+/*! \param frame Frame to write
 
     Writes the data chunks velocity, angmom, and image in particles/.
 */
-void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
+void GSDDumpWriter::writeMomenta(const GSDFrame& frame)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
+    const SnapshotParticleData<float>& snapshot = frame.snapshot;
+    const std::map<unsigned int, unsigned int>& map = frame.map;
+    uint32_t N = frame.N;
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = frame.nframes;
 
         {
         std::vector<float> data(uint64_t(N)*3);
@@ -619,7 +809,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -640,8 +830,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         if (!all_default || (nframes > 0 && m_nondefault["particles/velocity"]))
             {
             m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/velocity" << endl;
-            retval = gsd_write_chunk(&m_handle, "particles/velocity", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
-            checkError(retval);
+            writeFloatChunk("particles/velocity", N, 3, data);
             if (nframes == 0)
                 m_nondefault["particles/velocity"] = true;
             }
@@ -654,7 +843,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -691,7 +880,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -720,6 +909,307 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
         }
     }
 
+#ifdef ENABLE_MPI
+namespace
+{
+//! Per-particle data of one group member, exchanged between ranks for a parallel write
+/*! All fields are 4 bytes wide and stored in the same layout as the rows of the corresponding gsd chunks.
+*/
+struct gsd_particle_record
+    {
+    uint32_t group_idx;     //!< Index of the particle in the group (the row in the chunks)
+    uint32_t typeid_;       //!< particles/typeid
+    float mass;             //!< particles/mass
+    float charge;           //!< particles/charge
+    float diameter;         //!< particles/diameter
+    int32_t body;           //!< particles/body
+    float inertia[3];       //!< particles/moment_inertia
+    float position[3];      //!< particles/position
+    float orientation[4];   //!< particles/orientation
+    float velocity[3];      //!< particles/velocity
+    float angmom[4];        //!< particles/angmom
+    int32_t image[3];       //!< particles/image
+    };
+
+//! Description of a per-particle chunk written in parallel
+struct gsd_parallel_chunk
+    {
+    const char *name;       //!< Name of the chunk
+    gsd_type type;          //!< Data type of the chunk
+    uint32_t M;             //!< Number of columns
+    size_t offset;          //!< Offset of the row in gsd_particle_record
+    int category;           //!< 0: attribute, 1: property, 2: momentum
+    bool always;            //!< True if the chunk is written even when all values are default
+    };
+}
+
+/*! \param nframes Number of frames in the file before this one
+    \param root True on the root rank
+
+    Writes the same per-particle chunks as writeAttributes(), writeProperties(), and writeMomenta() without gathering
+    a snapshot on the root rank. The ranks exchange their local group members so that every rank holds a contiguous
+    slice of the group in ascending tag order. The root rank reserves space for each chunk in the file and broadcasts
+    its location, then every rank writes its slice at the corresponding offset. The root rank only writes the
+    particle type names and, in gsd_end_frame(), the index.
+*/
+void GSDDumpWriter::writeParticlesParallel(uint64_t nframes, bool root)
+    {
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+    unsigned int rank = m_exec_conf->getRank();
+    uint32_t N = m_group->getNumMembersGlobal();
+
+    // first group index of the slice written by each rank
+    std::vector<unsigned int> slice_begin(n_ranks+1);
+    for (unsigned int i = 0; i <= n_ranks; i++)
+        slice_begin[i] = (unsigned int)((uint64_t(N)*i)/n_ranks);
+
+    // pack the local group members
+    unsigned int n_local = m_group->getNumMembers();
+    std::vector<gsd_particle_record> send_buf(n_local);
+
+        {
+        const GlobalArray<unsigned int>& member_idx = m_group->getIndexArray();
+        const GlobalArray<unsigned int>& member_tags = m_group->getMemberTagArray();
+
+        ArrayHandle<unsigned int> h_member_idx(member_idx, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_member_tags(member_tags, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+
+        const BoxDim& global_box = m_pdata->getGlobalBox();
+        Scalar3 origin = m_pdata->getOrigin();
+        int3 o_image = m_pdata->getOriginImage();
+
+        for (unsigned int j = 0; j < n_local; j++)
+            {
+            unsigned int idx = h_member_idx.data[j];
+            unsigned int tag = h_tag.data[idx];
+            gsd_particle_record& r = send_buf[j];
+
+            // the member tags are sorted, the position of the tag is the row in the file
+            r.group_idx = (uint32_t)(std::lower_bound(h_member_tags.data, h_member_tags.data + N, tag)
+                - h_member_tags.data);
+            assert(r.group_idx < N && h_member_tags.data[r.group_idx] == tag);
+
+            // unwrap the origin shift the same way takeSnapshot() does
+            Scalar3 pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - origin;
+            int3 image = h_image.data[idx];
+            image.x -= o_image.x;
+            image.y -= o_image.y;
+            image.z -= o_image.z;
+            global_box.wrap(pos, image);
+
+            r.typeid_ = __scalar_as_int(h_pos.data[idx].w);
+            r.mass = float(h_vel.data[idx].w);
+            r.charge = float(h_charge.data[idx]);
+            r.diameter = float(h_diameter.data[idx]);
+            r.body = int32_t(h_body.data[idx]);
+            r.inertia[0] = float(h_inertia.data[idx].x);
+            r.inertia[1] = float(h_inertia.data[idx].y);
+            r.inertia[2] = float(h_inertia.data[idx].z);
+            r.position[0] = float(pos.x);
+            r.position[1] = float(pos.y);
+            r.position[2] = float(pos.z);
+            r.orientation[0] = float(h_orientation.data[idx].x);
+            r.orientation[1] = float(h_orientation.data[idx].y);
+            r.orientation[2] = float(h_orientation.data[idx].z);
+            r.orientation[3] = float(h_orientation.data[idx].w);
+            r.velocity[0] = float(h_vel.data[idx].x);
+            r.velocity[1] = float(h_vel.data[idx].y);
+            r.velocity[2] = float(h_vel.data[idx].z);
+            r.angmom[0] = float(h_angmom.data[idx].x);
+            r.angmom[1] = float(h_angmom.data[idx].y);
+            r.angmom[2] = float(h_angmom.data[idx].z);
+            r.angmom[3] = float(h_angmom.data[idx].w);
+            r.image[0] = image.x;
+            r.image[1] = image.y;
+            r.image[2] = image.z;
+            }
+        }
+
+    // sort by row, so that the records are ordered by destination rank
+    std::sort(send_buf.begin(), send_buf.end(),
+        [](const gsd_particle_record& a, const gsd_particle_record& b) { return a.group_idx < b.group_idx; });
+
+    std::vector<int> send_bytes(n_ranks, 0);
+    std::vector<int> send_displs(n_ranks, 0);
+    for (unsigned int j = 0; j < n_local; j++)
+        {
+        unsigned int dest = std::upper_bound(slice_begin.begin(), slice_begin.end(), send_buf[j].group_idx)
+            - slice_begin.begin() - 1;
+        send_bytes[dest] += sizeof(gsd_particle_record);
+        }
+    for (unsigned int i = 1; i < n_ranks; i++)
+        send_displs[i] = send_displs[i-1] + send_bytes[i-1];
+
+    // exchange the records
+    std::vector<int> recv_bytes(n_ranks, 0);
+    std::vector<int> recv_displs(n_ranks, 0);
+    MPI_Alltoall(&send_bytes[0], 1, MPI_INT, &recv_bytes[0], 1, MPI_INT, mpi_comm);
+    for (unsigned int i = 1; i < n_ranks; i++)
+        recv_displs[i] = recv_displs[i-1] + recv_bytes[i-1];
+
+    // errors are only raised once all ranks know about them, so that no rank is left waiting in a collective call
+    int status = 0;
+
+    unsigned int n_slice = slice_begin[rank+1] - slice_begin[rank];
+    unsigned int n_recv = (recv_displs[n_ranks-1] + recv_bytes[n_ranks-1]) / sizeof(gsd_particle_record);
+    if (n_recv != n_slice)
+        {
+        m_exec_conf->msg->error() << "dump.gsd: Received " << n_recv << " particles for a slice of " << n_slice
+                                  << " particles." << endl;
+        status = 1;
+        }
+
+    std::vector<gsd_particle_record> recv_buf(n_recv);
+    MPI_Alltoallv(send_buf.size() ? &send_buf[0] : NULL, &send_bytes[0], &send_displs[0], MPI_BYTE,
+                  recv_buf.size() ? &recv_buf[0] : NULL, &recv_bytes[0], &recv_displs[0], MPI_BYTE, mpi_comm);
+
+    // the records come from several ranks, put them in row order
+    std::sort(recv_buf.begin(), recv_buf.end(),
+        [](const gsd_particle_record& a, const gsd_particle_record& b) { return a.group_idx < b.group_idx; });
+
+    // values that are not written when they apply to all particles
+    gsd_particle_record default_record;
+    memset(&default_record, 0, sizeof(default_record));
+    default_record.mass = 1.0f;
+    default_record.diameter = 1.0f;
+    default_record.body = int32_t(NO_BODY);
+    default_record.orientation[0] = 1.0f;
+
+    const gsd_parallel_chunk chunks[] = {
+        {"particles/typeid", GSD_TYPE_UINT32, 1, offsetof(gsd_particle_record, typeid_), 0, false},
+        {"particles/mass", GSD_TYPE_FLOAT, 1, offsetof(gsd_particle_record, mass), 0, false},
+        {"particles/charge", GSD_TYPE_FLOAT, 1, offsetof(gsd_particle_record, charge), 0, false},
+        {"particles/diameter", GSD_TYPE_FLOAT, 1, offsetof(gsd_particle_record, diameter), 0, false},
+        {"particles/body", GSD_TYPE_INT32, 1, offsetof(gsd_particle_record, body), 0, false},
+        {"particles/moment_inertia", GSD_TYPE_FLOAT, 3, offsetof(gsd_particle_record, inertia), 0, false},
+        {"particles/position", GSD_TYPE_FLOAT, 3, offsetof(gsd_particle_record, position), 1, true},
+        {"particles/orientation", GSD_TYPE_FLOAT, 4, offsetof(gsd_particle_record, orientation), 1, false},
+        {"particles/velocity", GSD_TYPE_FLOAT, 3, offsetof(gsd_particle_record, velocity), 2, false},
+        {"particles/angmom", GSD_TYPE_FLOAT, 4, offsetof(gsd_particle_record, angmom), 2, false},
+        {"particles/image", GSD_TYPE_INT32, 3, offsetof(gsd_particle_record, image), 2, false}};
+    const unsigned int n_chunks = sizeof(chunks)/sizeof(gsd_parallel_chunk);
+    bool write_category[3] = {m_write_attribute || nframes == 0,
+                              m_write_property || nframes == 0,
+                              m_write_momentum || nframes == 0};
+
+    // determine which chunks have only default values on all ranks
+    std::vector<int> all_default(n_chunks, 1);
+    for (unsigned int c = 0; c < n_chunks; c++)
+        {
+        const char *default_row = (const char *)&default_record + chunks[c].offset;
+        for (unsigned int i = 0; i < n_recv; i++)
+            {
+            if (memcmp((const char *)&recv_buf[i] + chunks[c].offset, default_row, chunks[c].M*sizeof(uint32_t)) != 0)
+                {
+                all_default[c] = 0;
+                break;
+                }
+            }
+        }
+    MPI_Allreduce(MPI_IN_PLACE, &all_default[0], n_chunks, MPI_INT, MPI_LAND, mpi_comm);
+
+    // the root rank reserves space for the chunks, -1 marks chunks that are not written
+    std::vector<int64_t> location(n_chunks, -1);
+    if (root && !status)
+        {
+        try
+            {
+            if (write_category[0])
+                {
+                std::vector<std::string> type_mapping;
+                for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+                    type_mapping.push_back(m_pdata->getNameByType(i));
+                writeTypeMapping("particles/types", type_mapping);
+                }
+
+            for (unsigned int c = 0; c < n_chunks; c++)
+                {
+                std::string name(chunks[c].name);
+                if (!write_category[chunks[c].category])
+                    continue;
+                if (!chunks[c].always && all_default[c] && !(nframes > 0 && m_nondefault[name]))
+                    continue;
+
+                m_exec_conf->msg->notice(10) << "dump.gsd: reserving " << name << endl;
+                int retval = gsd_reserve_chunk(&m_handle, chunks[c].name, chunks[c].type, N, chunks[c].M, 0, &location[c]);
+                checkError(retval);
+                if (nframes == 0 && !chunks[c].always)
+                    m_nondefault[name] = true;
+                }
+            }
+        catch (const std::exception&)
+            {
+            // checkError() has printed the error message
+            status = 1;
+            }
+        }
+    MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MAX, mpi_comm);
+    if (status)
+        throw runtime_error("Error writing GSD file");
+    MPI_Bcast(&location[0], n_chunks, MPI_INT64_T, 0, mpi_comm);
+
+    // the file was created by the root rank before nframes was broadcast, the other ranks may not know its name
+    if (m_fd == -1)
+        {
+        std::string fname = m_fname;
+        bcast(fname, 0, mpi_comm);
+
+        m_fd = ::open(fname.c_str(), O_WRONLY);
+        if (m_fd == -1)
+            {
+            m_exec_conf->msg->error() << "dump.gsd: " << strerror(errno) << " - " << fname << endl;
+            status = 1;
+            }
+        }
+
+    // write this rank's slice of every chunk
+    std::vector<char> data;
+    for (unsigned int c = 0; c < n_chunks; c++)
+        {
+        if (status || location[c] == -1 || n_slice == 0)
+            continue;
+
+        m_exec_conf->msg->notice(10) << "dump.gsd: writing " << chunks[c].name << " in parallel" << endl;
+        size_t row_size = chunks[c].M*sizeof(uint32_t);
+        data.resize(n_slice*row_size);
+        for (unsigned int i = 0; i < n_slice; i++)
+            memcpy(&data[i*row_size], (const char *)&recv_buf[i] + chunks[c].offset, row_size);
+
+        size_t total_bytes = 0;
+        off_t offset = location[c] + off_t(slice_begin[rank])*row_size;
+        while (total_bytes < data.size())
+            {
+            ssize_t bytes = ::pwrite(m_fd, &data[total_bytes], data.size() - total_bytes, offset + total_bytes);
+            if (bytes == -1 && errno == EINTR)
+                continue;
+            if (bytes <= 0)
+                {
+                m_exec_conf->msg->error() << "dump.gsd: " << strerror(errno) << " - " << m_fname << endl;
+                status = 1;
+                break;
+                }
+            total_bytes += bytes;
+            }
+        }
+
+    // all slices must be in the file before the root rank writes the index
+    MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MAX, mpi_comm);
+    if (status)
+        throw runtime_error("Error writing GSD file");
+    }
+#endif
+
 /*! \param bond Bond data snapshot
     \param angle Angle data snapshot
     \param dihedral Dihedral data snapshot
@@ -729,12 +1219,12 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
     Write out all the snapshot data to the GSD file
 */
-void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
-                                  AngleData::Snapshot& angle,
-                                  DihedralData::Snapshot& dihedral,
-                                  ImproperData::Snapshot& improper,
-                                  ConstraintData::Snapshot& constraint,
-                                  PairData::Snapshot& pair)
+void GSDDumpWriter::writeTopology(const BondData::Snapshot& bond,
+                                  const AngleData::Snapshot& angle,
+                                  const DihedralData::Snapshot& dihedral,
+                                  const ImproperData::Snapshot& improper,
+                                  const ConstraintData::Snapshot& constraint,
+                                  const PairData::Snapshot& pair)
     {
     if (bond.size > 0)
         {
@@ -847,14 +1337,18 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         }
     }
 
-/*! Perform the user-provided callbacks and write out the resulting data
+/*! \param timestep Current time step
+    \param root True on the root rank
+    \param user Output: copies of the data to write
+
+    Perform the user-provided callbacks and copy the resulting data, so that it can be written without the GIL
 */
-void GSDDumpWriter::writeUser(unsigned int timestep, bool root)
+void GSDDumpWriter::evaluateUser(unsigned int timestep, bool root, std::vector<UserChunk>& user)
     {
     for (std::pair<std::string, pybind11::function> item : m_user_log)
         {
         string name = string("log/") + item.first;
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing " << name << endl;
+        m_exec_conf->msg->notice(10) << "dump.gsd: evaluating " << name << endl;
 
         // call the callback collectively on all ranks
         pybind11::object obj = item.second(timestep);
@@ -920,12 +1414,30 @@ void GSDDumpWriter::writeUser(unsigned int timestep, bool root)
                 throw runtime_error("Invalid numpy dimension in gsd user-defined log data [" + item.first + "]");
                 }
 
-            int retval = gsd_write_chunk(&m_handle, name.c_str(), type, arr.shape(0), M, 0, (void *)arr.data());
-            checkError(retval);
+            UserChunk chunk;
+            chunk.name = name;
+            chunk.type = type;
+            chunk.N = arr.shape(0);
+            chunk.M = M;
+            chunk.data.assign((const char *)arr.data(), (const char *)arr.data() + arr.nbytes());
+            user.push_back(chunk);
             }
         }
     }
 
+/*! \param user Data of the user-provided callbacks
+*/
+void GSDDumpWriter::writeUser(const std::vector<UserChunk>& user)
+    {
+    for (const UserChunk& chunk : user)
+        {
+        m_exec_conf->msg->notice(10) << "dump.gsd: writing " << chunk.name << endl;
+        int retval = gsd_write_chunk(&m_handle, chunk.name.c_str(), chunk.type, chunk.N, chunk.M, 0,
+                                     chunk.data.size() ? (const void *)&chunk.data[0] : (const void *)"");
+        checkError(retval);
+        }
+    }
+
 /*! Populate the m_nondefault map.
     Set entries to true when they exist in frame 0 of the file, otherwise, set them to false.
 */
@@ -973,7 +1485,7 @@ void GSDDumpWriter::populateNonDefault()
         m_exec_conf->msg->error() << "dump.gsd: " << "Invalid schema in " << m_fname << endl;
         throw runtime_error("Error opening GSD file");
         }
-    if (m_handle.header.schema_version >= gsd_make_version(2,0))
+    if (m_handle.header.schema_version >= gsd_make_version(3,0))
         {
         m_exec_conf->msg->error() << "dump.gsd: " << "Invalid schema version in " << m_fname << endl;
         throw runtime_error("Error opening GSD file");
@@ -1010,6 +1522,10 @@ void export_GSDDumpWriter(py::module& m)
         .def("setWriteProperty", &GSDDumpWriter::setWriteProperty)
         .def("setWriteMomentum", &GSDDumpWriter::setWriteMomentum)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
+        .def("setParallelWrite", &GSDDumpWriter::setParallelWrite)
+        .def("setAsyncWrite", &GSDDumpWriter::setAsyncWrite)
+        .def("setPrecision", &GSDDumpWriter::setPrecision)
+        .def("flush", &GSDDumpWriter::flush)
         .def_readwrite("user_log", &GSDDumpWriter::m_user_log)
     ;
     }
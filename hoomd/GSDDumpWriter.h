@@ -11,7 +11,11 @@
 
 #include <string>
 #include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "hoomd/extern/gsd.h"
+#include "GSDEncoding.h"
 
 /*! \file GSDDumpWriter.h
     \brief Declares the GSDDumpWriter class
@@ -31,6 +35,10 @@
     On the first call to analyze() \a fname is created with a dcd header. If it already
     exists, append to the file (unless the user specifies overwrite=True).
 
+    analyze() first captures all data of a frame in a GSDFrame, then writes it to the file. In asynchronous mode, a
+    background thread writes the frame while the simulation continues. At most one frame is in flight: analyze() and
+    flush() wait for the previous frame to be written before they touch the file.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -67,12 +75,49 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
             m_write_topology = b;
             }
 
+        //! Control parallel writes
+        /*! When enabled in MPI simulations, every rank writes a contiguous slice of the per-particle chunks directly
+            to the file and only the root rank writes the frame header, the index, and the remaining chunks.
+        */
+        void setParallelWrite(bool b)
+            {
+            m_parallel_write = b;
+            }
+
+        //! Control asynchronous writes
+        void setAsyncWrite(bool b)
+            {
+            m_async_write = b;
+            }
+
+        //! Set the quantization step of a per-particle chunk
+        /*! \param name Name of the chunk (particles/position, particles/orientation, or particles/velocity)
+            \param precision Quantization step, 0 to write raw floats
+
+            Must be set before the first frame is written, files with quantized chunks use hoomd schema 2.0.
+        */
+        void setPrecision(const std::string& name, float precision)
+            {
+            if (!hoomd::detail::gsd_is_encodable(name))
+                {
+                m_exec_conf->msg->error() << "dump.gsd: " << name << " cannot be quantized" << std::endl;
+                throw std::runtime_error("Error setting GSD precision");
+                }
+            if (precision > 0.0f)
+                m_precision[name] = precision;
+            else
+                m_precision.erase(name);
+            }
+
         //! Destructor
         ~GSDDumpWriter();
 
         //! Write out the data for the current timestep
         void analyze(unsigned int timestep);
 
+        //! Wait until the frame being written in the background is complete
+        virtual void flush();
+
         hoomd::detail::SharedSignal<int (gsd_handle&)>& getWriteSignal() { return m_write_signal; }
 
     private:
@@ -84,14 +129,73 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         bool m_write_property;              //!< True if properties should be written
         bool m_write_momentum;              //!< True if momenta should be written
         bool m_write_topology;              //!< True if topology should be written
+        bool m_parallel_write;              //!< True if the ranks write per-particle chunks in parallel
+        bool m_async_write;                 //!< True if frames are written in a background thread
         gsd_handle m_handle;                //!< Handle to the file
+        #ifdef ENABLE_MPI
+        int m_fd;                           //!< File descriptor for parallel writes
+        #endif
 
         std::shared_ptr<ParticleGroup> m_group;   //!< Group to write out to the file
         std::map<std::string, bool> m_nondefault; //!< Map of quantities (true when non-default in frame 0)
+        std::map<std::string, float> m_precision; //!< Quantization step of the quantized chunks
         std::map<std::string, pybind11::function> m_user_log;   //!< Map of user-defined quantities to log
 
         hoomd::detail::SharedSignal<int (gsd_handle&)> m_write_signal;
 
+        //! User-defined log data evaluated for a frame
+        struct UserChunk
+            {
+            std::string name;       //!< Name of the chunk
+            gsd_type type;          //!< Data type
+            uint64_t N;             //!< Number of rows
+            uint32_t M;             //!< Number of columns
+            std::vector<char> data; //!< Copy of the data
+            };
+
+        //! All data needed to write one frame, captured on the root rank
+        struct GSDFrame
+            {
+            unsigned int timestep;                      //!< Time step of the frame
+            uint64_t nframes;                           //!< Number of frames in the file before this one
+            BoxDim box;                                 //!< Global box
+            unsigned int dimensions;                    //!< Number of dimensions
+            uint32_t N;                                 //!< Number of particles in the group
+
+            bool write_particles;                       //!< True if the per-particle chunks are written
+            SnapshotParticleData<float> snapshot;       //!< Particle data snapshot
+            std::map<unsigned int, unsigned int> map;   //!< Map from tags to snapshot indices
+            std::vector<unsigned int> tags;             //!< Tags of the group members in ascending order
+
+            bool write_topology;                        //!< True if the topology is written
+            BondData::Snapshot bond;                    //!< Bond data snapshot
+            AngleData::Snapshot angle;                  //!< Angle data snapshot
+            DihedralData::Snapshot dihedral;            //!< Dihedral data snapshot
+            ImproperData::Snapshot improper;            //!< Improper data snapshot
+            ConstraintData::Snapshot constraint;        //!< Constraint data snapshot
+            PairData::Snapshot pair;                    //!< Special pair data snapshot
+
+            std::vector<UserChunk> user;                //!< User-defined log data
+
+            std::shared_ptr<Profiler> prof;             //!< Profiler to trace the write in (may be null)
+            };
+
+        std::thread m_writer_thread;                //!< Background thread that writes frames
+        std::mutex m_writer_mutex;                  //!< Protects the members shared with the writer thread
+        std::condition_variable m_writer_cv;        //!< Signals changes of the writer thread state
+        std::shared_ptr<GSDFrame> m_writer_frame;   //!< Frame being written by the writer thread (if any)
+        std::string m_writer_error;                 //!< Error raised by the writer thread
+        bool m_writer_exit;                         //!< Set to true to stop the writer thread
+
+        //! Main loop of the writer thread
+        void writerLoop();
+
+        //! Wait for the writer thread to finish the current frame and report its errors
+        void waitForWriter();
+
+        //! Write a captured frame to the file
+        void writeFrame(const GSDFrame& frame);
+
         //! Write a type mapping out to the file
         void writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping);
 
@@ -99,27 +203,38 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         void initFileIO();
 
         //! Write frame header
-        void writeFrameHeader(unsigned int timestep);
+        void writeFrameHeader(const GSDFrame& frame);
 
         //! Write particle attributes
-        void writeAttributes(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
+        void writeAttributes(const GSDFrame& frame);
+
+        //! Write a float chunk, quantized if requested
+        void writeFloatChunk(const char *name, uint32_t N, uint32_t M, const std::vector<float>& data);
 
         //! Write particle properties
-        void writeProperties(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
+        void writeProperties(const GSDFrame& frame);
 
         //! Write particle momenta
-        void writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
+        void writeMomenta(const GSDFrame& frame);
+
+        #ifdef ENABLE_MPI
+        //! Write the per-particle chunks in parallel from all ranks
+        void writeParticlesParallel(uint64_t nframes, bool root);
+        #endif
 
         //! Write bond topology
-        void writeTopology(BondData::Snapshot& bond,
-                           AngleData::Snapshot& angle,
-                           DihedralData::Snapshot& dihedral,
-                           ImproperData::Snapshot& improper,
-                           ConstraintData::Snapshot& constraint,
-                           PairData::Snapshot& pair);
+        void writeTopology(const BondData::Snapshot& bond,
+                           const AngleData::Snapshot& angle,
+                           const DihedralData::Snapshot& dihedral,
+                           const ImproperData::Snapshot& improper,
+                           const ConstraintData::Snapshot& constraint,
+                           const PairData::Snapshot& pair);
+
+        //! Evaluate user defined log data
+        void evaluateUser(unsigned int timestep, bool root, std::vector<UserChunk>& user);
 
         //! Write user defined log data
-        void writeUser(unsigned int timestep, bool root);
+        void writeUser(const std::vector<UserChunk>& user);
 
         //! Check and raise an exception if an error occurs
         void checkError(int retval);
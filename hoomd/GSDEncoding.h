@@ -0,0 +1,170 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#ifndef __GSD_ENCODING_H__
+#define __GSD_ENCODING_H__
+
+/*! \file GSDEncoding.h
+    \brief Encoding and decoding of quantized per-particle chunks in GSD files
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "hoomd/extern/gsd.h"
+
+namespace hoomd
+{
+namespace detail
+{
+
+//! GSD schema version of files that may contain encoded chunks
+/*! Readers of hoomd schema 1.x do not know the encoding and refuse to open these files.
+*/
+inline uint32_t gsd_encoded_schema_version()
+    {
+    return gsd_make_version(2,0);
+    }
+
+//! Identifies the quantized encoding in the chunk header
+const uint8_t GSD_ENCODING_QUANTIZED = 1;
+
+//! Header of an encoded chunk
+/*! An encoded chunk is stored as a GSD_TYPE_UINT8 chunk with M=1 under the name of the float chunk it replaces.
+    The header is followed by one variable length integer per value, in row major order.
+*/
+struct gsd_encoded_header
+    {
+    uint8_t encoding;   //!< Encoding identifier
+    uint8_t M;          //!< Number of columns of the decoded chunk
+    uint16_t reserved;  //!< Reserved, set to 0
+    uint32_t N;         //!< Number of rows of the decoded chunk
+    float precision;    //!< Quantization step
+    };
+
+//! Test if a chunk may be stored encoded
+inline bool gsd_is_encodable(const std::string& name)
+    {
+    return name == "particles/position" || name == "particles/orientation" || name == "particles/velocity";
+    }
+
+//! Encode a float chunk with fixed precision quantization
+/*! \param out Output: encoded chunk, including the header
+    \param data Values to encode (N*M)
+    \param N Number of rows
+    \param M Number of columns
+    \param precision Quantization step
+
+    Each value x is stored as the integer q = round(x / precision), so the decoded value differs from x by at most
+    precision/2. Like the XTC format, consecutive rows of a column are stored as differences, which are small when
+    nearby particles have nearby tags. The differences are zigzag encoded and written as variable length integers
+    of 7 bits per byte.
+
+    \returns false if a value cannot be quantized (not finite or out of range), \a out is then undefined
+*/
+inline bool gsd_encode_quantized(std::vector<uint8_t>& out,
+                                 const float *data,
+                                 uint32_t N,
+                                 uint32_t M,
+                                 float precision)
+    {
+    gsd_encoded_header header;
+    header.encoding = GSD_ENCODING_QUANTIZED;
+    header.M = (uint8_t)M;
+    header.reserved = 0;
+    header.N = N;
+    header.precision = precision;
+
+    out.resize(sizeof(header));
+    memcpy(&out[0], &header, sizeof(header));
+
+    // most differences fit in 2-3 bytes
+    out.reserve(sizeof(header) + uint64_t(N)*M*3);
+
+    const double max_q = 4.0e18;
+    std::vector<int64_t> prev(M, 0);
+    for (uint64_t i = 0; i < uint64_t(N)*M; i++)
+        {
+        double scaled = double(data[i]) / double(precision);
+        if (!std::isfinite(scaled) || std::abs(scaled) > max_q)
+            return false;
+
+        int64_t q = (int64_t)std::llround(scaled);
+        int64_t delta = q - prev[i % M];
+        prev[i % M] = q;
+
+        uint64_t zigzag = (uint64_t(delta) << 1) ^ uint64_t(delta >> 63);
+        while (zigzag >= 0x80)
+            {
+            out.push_back(uint8_t(zigzag) | 0x80);
+            zigzag >>= 7;
+            }
+        out.push_back(uint8_t(zigzag));
+        }
+
+    return true;
+    }
+
+//! Read the header of an encoded chunk
+/*! \returns false if \a size bytes do not hold a valid header
+*/
+inline bool gsd_read_encoded_header(gsd_encoded_header& header, const uint8_t *data, size_t size)
+    {
+    if (size < sizeof(header))
+        return false;
+    memcpy(&header, data, sizeof(header));
+    return header.encoding == GSD_ENCODING_QUANTIZED && header.M > 0 && header.precision > 0.0f;
+    }
+
+//! Decode a chunk encoded with gsd_encode_quantized()
+/*! \param out Output: N*M decoded values
+    \param data Encoded chunk, including the header
+    \param size Size of the encoded chunk in bytes
+
+    \returns false if the chunk is corrupt
+*/
+inline bool gsd_decode_quantized(float *out, const uint8_t *data, size_t size)
+    {
+    gsd_encoded_header header;
+    if (!gsd_read_encoded_header(header, data, size))
+        return false;
+
+    const uint8_t *cur = data + sizeof(header);
+    const uint8_t *end = data + size;
+    std::vector<int64_t> prev(header.M, 0);
+    for (uint64_t i = 0; i < uint64_t(header.N)*header.M; i++)
+        {
+        uint64_t zigzag = 0;
+        unsigned int shift = 0;
+        while (true)
+            {
+            if (cur == end || shift > 63)
+                return false;
+            uint8_t byte = *cur++;
+            zigzag |= uint64_t(byte & 0x7f) << shift;
+            shift += 7;
+            if (!(byte & 0x80))
+                break;
+            }
+
+        int64_t delta = int64_t(zigzag >> 1) ^ -int64_t(zigzag & 1);
+        int64_t q = prev[i % header.M] + delta;
+        prev[i % header.M] = q;
+        out[i] = float(double(q) * double(header.precision));
+        }
+
+    return cur == end;
+    }
+
+} // end namespace detail
+} // end namespace hoomd
+
+#endif
@@ -11,10 +11,14 @@
 #include "GSDReader.h"
 #include "SnapshotSystemData.h"
 #include "ExecutionConfiguration.h"
+#include "GSDEncoding.h"
 #include "hoomd/extern/gsd.h"
 #include <string.h>
+#include <unistd.h>
 
 #include <stdexcept>
+#include <algorithm>
+#include <cstddef>
 using namespace std;
 
 namespace py = pybind11;
@@ -23,21 +27,29 @@ namespace py = pybind11;
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param parallel Read the particles on every rank (see readLocalParticles())
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file into
     memory (on the root rank).
+
+    In parallel mode with more than one rank, every rank opens the file. The snapshot then holds the header,
+    particle types, and topology but no per-particle data, which readLocalParticles() reads later.
 */
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string &name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool parallel)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame), m_parallel(false),
+      m_nglobal(0)
     {
     m_snapshot = std::shared_ptr< SnapshotSystemData<float> >(new SnapshotSystemData<float>);
 
     #ifdef ENABLE_MPI
+    m_parallel = parallel && m_exec_conf->getNRanks() > 1;
+
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_parallel)
         {
         return;
         }
@@ -46,6 +58,22 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
     // open the GSD file in read mode
     m_exec_conf->msg->notice(3) << "data.gsd_snapshot: open gsd file " << name << endl;
     int retval = gsd_open(&m_handle, name.c_str(), GSD_OPEN_READONLY);
+
+    #ifdef ENABLE_MPI
+    // in parallel mode, all ranks raise the error together so that no rank is left waiting in a collective call
+    if (m_parallel)
+        {
+        int status = (retval != 0);
+        MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MAX, m_exec_conf->getMPICommunicator());
+        if (status && retval == 0)
+            {
+            // the rank that failed prints the error message
+            gsd_close(&m_handle);
+            throw runtime_error("Error opening GSD file");
+            }
+        }
+    #endif
+
     if (retval == -1)
         {
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << strerror(errno) << " - " << name << endl;
@@ -83,7 +111,7 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid schema in " << name << endl;
         throw runtime_error("Error opening GSD file");
         }
-    if (m_handle.header.schema_version >= gsd_make_version(2,0))
+    if (m_handle.header.schema_version >= gsd_make_version(3,0))
         {
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid schema version in " << name << endl;
         throw runtime_error("Error opening GSD file");
@@ -102,7 +130,19 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         }
 
     readHeader();
-    readParticles();
+
+    if (m_parallel)
+        {
+        m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
+
+        if (!m_exec_conf->isRoot())
+            return;
+        }
+    else
+        {
+        readParticles();
+        }
+
     readTopology();
     }
 
@@ -110,7 +150,7 @@ GSDReader::~GSDReader()
     {
     #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_parallel)
         {
         return;
         }
@@ -131,6 +171,8 @@ GSDReader::~GSDReader()
 
     Per the GSD spec, keep the default when the frame 0 N does not match the current N.
 
+    Chunks written quantized by dump.gsd (hoomd schema 2.0) are decoded into \a data.
+
     Return true if data is actually read from the file.
 */
 bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t expected_size, unsigned int cur_n)
@@ -139,7 +181,31 @@ bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t e
     if (entry == NULL && frame != 0)
         entry = gsd_find_chunk(&m_handle, 0, name);
 
-    if (entry == NULL || (cur_n != 0 && entry->N != cur_n))
+    // encoded chunks are stored as bytes, their header holds the decoded dimensions
+    bool encoded = entry != NULL && entry->type == GSD_TYPE_UINT8 && hoomd::detail::gsd_is_encodable(name);
+    std::vector<uint8_t> encoded_data;
+    uint64_t chunk_n = 0;
+    size_t actual_size = 0;
+    if (encoded)
+        {
+        encoded_data.resize(entry->N * entry->M);
+        hoomd::detail::gsd_encoded_header header;
+        if (gsd_read_chunk(&m_handle, &encoded_data[0], entry) != 0
+            || !hoomd::detail::gsd_read_encoded_header(header, &encoded_data[0], encoded_data.size()))
+            {
+            m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid encoded chunk " << name << " in " << m_name << endl;
+            throw runtime_error("Error reading GSD file");
+            }
+        chunk_n = header.N;
+        actual_size = size_t(header.N) * header.M * sizeof(float);
+        }
+    else if (entry != NULL)
+        {
+        chunk_n = entry->N;
+        actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+        }
+
+    if (entry == NULL || (cur_n != 0 && chunk_n != cur_n))
         {
         m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
         return false;
@@ -147,12 +213,22 @@ bool GSDReader::readChunk(void *data, uint64_t frame, const char *name, size_t e
     else
         {
         m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading chunk " << name << endl;
-        size_t actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
         if (actual_size != expected_size)
             {
             m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << expected_size << " bytes in " << name << " but found " << actual_size << endl;
             throw runtime_error("Error reading GSD file");
             }
+
+        if (encoded)
+            {
+            if (!hoomd::detail::gsd_decode_quantized((float *)data, &encoded_data[0], encoded_data.size()))
+                {
+                m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid encoded chunk " << name << " in " << m_name << endl;
+                throw runtime_error("Error reading GSD file");
+                }
+            return true;
+            }
+
         int retval = gsd_read_chunk(&m_handle, data, entry);
 
         if (retval == -1)
@@ -264,7 +340,11 @@ void GSDReader::readHeader()
         m_exec_conf->msg->error() << "data.gsd_snapshot: " << "cannot read a file with 0 particles" << endl;
         throw runtime_error("Error reading GSD file");
         }
-    m_snapshot->particle_data.resize(N);
+    m_nglobal = N;
+
+    // in parallel mode, no rank holds all particles
+    if (!m_parallel)
+        m_snapshot->particle_data.resize(N);
     }
 
 /*! Read the same data chunks for particles
@@ -289,6 +369,290 @@ void GSDReader::readParticles()
     readChunk(&m_snapshot->particle_data.image[0], m_frame, "particles/image", N*12, N);
     }
 
+#ifdef ENABLE_MPI
+namespace
+{
+//! Per-particle data of one particle, sent to the rank whose domain holds it in a parallel read
+/*! All fields are 4 bytes wide and stored in the same layout as the rows of the corresponding gsd chunks.
+*/
+struct gsd_particle_record
+    {
+    uint32_t tag;           //!< Particle tag (the row in the chunks)
+    uint32_t typeid_;       //!< particles/typeid
+    float mass;             //!< particles/mass
+    float charge;           //!< particles/charge
+    float diameter;         //!< particles/diameter
+    uint32_t body;          //!< particles/body
+    float inertia[3];       //!< particles/moment_inertia
+    float position[3];      //!< particles/position
+    float orientation[4];   //!< particles/orientation
+    float velocity[3];      //!< particles/velocity
+    float angmom[4];        //!< particles/angmom
+    int32_t image[3];       //!< particles/image
+    };
+
+//! Description of a per-particle chunk read in parallel
+struct gsd_parallel_chunk
+    {
+    const char *name;       //!< Name of the chunk
+    size_t row_size;        //!< Size of one row in bytes
+    size_t offset;          //!< Offset of the row in gsd_particle_record
+    };
+}
+
+/*! \param rows Output: the rows of this rank's slice of the chunk
+    \param name Name of the data chunk
+    \param row_size Expected size of one row in bytes
+    \param slice_begin First row of the slice of each rank, followed by the number of rows
+
+    Finds a per-particle chunk at the current frame or frame 0, with the same rules as readChunk(). Every rank reads
+    only the rows of its own slice from the file. Encoded chunks cannot be read by row, the root rank decodes them
+    and scatters the slices.
+
+    All ranks must call readChunkSlice() for the same chunks.
+
+    \returns 1 if the chunk was read, 0 if it is not present, or -1 on an error. The error message is printed on the
+    rank where the error occurred.
+*/
+int GSDReader::readChunkSlice(std::vector<char>& rows, const char *name, size_t row_size,
+                              const std::vector<unsigned int>& slice_begin)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, m_frame, name);
+    if (entry == NULL && m_frame != 0)
+        entry = gsd_find_chunk(&m_handle, 0, name);
+
+    if (entry == NULL)
+        return 0;
+
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+    unsigned int rank = m_exec_conf->getRank();
+    unsigned int n_slice = slice_begin[rank+1] - slice_begin[rank];
+    rows.resize(size_t(n_slice)*row_size);
+
+    if (entry->type == GSD_TYPE_UINT8 && hoomd::detail::gsd_is_encodable(name))
+        {
+        int status = 1;
+        std::vector<char> decoded;
+        if (m_exec_conf->isRoot())
+            {
+            try
+                {
+                decoded.resize(size_t(m_nglobal)*row_size);
+                if (!readChunk(&decoded[0], m_frame, name, decoded.size(), m_nglobal))
+                    status = 0;
+                }
+            catch (const std::exception&)
+                {
+                // readChunk() has printed the error message
+                status = -1;
+                }
+            }
+        MPI_Bcast(&status, 1, MPI_INT, 0, mpi_comm);
+        if (status != 1)
+            return status;
+
+        std::vector<int> counts(n_ranks);
+        std::vector<int> displs(n_ranks);
+        for (unsigned int i = 0; i < n_ranks; i++)
+            {
+            counts[i] = int((slice_begin[i+1] - slice_begin[i])*row_size);
+            displs[i] = int(slice_begin[i]*row_size);
+            }
+        MPI_Scatterv(decoded.size() ? &decoded[0] : NULL, &counts[0], &displs[0], MPI_BYTE,
+                     rows.size() ? &rows[0] : NULL, counts[rank], MPI_BYTE, 0, mpi_comm);
+        return 1;
+        }
+
+    if (entry->N != m_nglobal)
+        return 0;
+
+    size_t actual_row_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_row_size != row_size)
+        {
+        m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Expecting " << row_size*m_nglobal << " bytes in "
+                                  << name << " but found " << actual_row_size*entry->N << endl;
+        return -1;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading slice of chunk " << name << endl;
+    size_t total_bytes = 0;
+    off_t offset = entry->location + off_t(slice_begin[rank])*row_size;
+    while (total_bytes < rows.size())
+        {
+        ssize_t bytes = ::pread(m_handle.fd, &rows[total_bytes], rows.size() - total_bytes, offset + total_bytes);
+        if (bytes == -1 && errno == EINTR)
+            continue;
+        if (bytes == -1)
+            {
+            m_exec_conf->msg->error() << "data.gsd_snapshot: " << strerror(errno) << " - " << m_name << endl;
+            return -1;
+            }
+        if (bytes == 0)
+            {
+            m_exec_conf->msg->error() << "data.gsd_snapshot: " << "Invalid GSD file " << m_name << endl;
+            return -1;
+            }
+        total_bytes += bytes;
+        }
+
+    return 1;
+    }
+
+/*! \param decomposition Domain decomposition of the system
+    \param global_box Global simulation box
+
+    Every rank reads a contiguous slice of the particles, tags [N*r/P, N*(r+1)/P), from the file and sends each
+    particle to the rank whose domain holds it, the same exchange that dump.gsd performs in reverse when it writes
+    in parallel. No rank reads or holds the data of all particles, except that encoded chunks are decoded on the
+    root rank (see readChunkSlice()).
+
+    The local particles are stored in ascending tag order.
+*/
+void GSDReader::readLocalParticles(std::shared_ptr<DomainDecomposition> decomposition, const BoxDim& global_box)
+    {
+    assert(m_parallel);
+
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+    unsigned int rank = m_exec_conf->getRank();
+
+    // first tag of the slice read by each rank
+    std::vector<unsigned int> slice_begin(n_ranks+1);
+    for (unsigned int i = 0; i <= n_ranks; i++)
+        slice_begin[i] = (unsigned int)((uint64_t(m_nglobal)*i)/n_ranks);
+    unsigned int n_slice = slice_begin[rank+1] - slice_begin[rank];
+
+    // the snapshot defaults are kept when a chunk is not present
+    gsd_particle_record default_record;
+    memset(&default_record, 0, sizeof(default_record));
+    default_record.mass = 1.0f;
+    default_record.diameter = 1.0f;
+    default_record.body = NO_BODY;
+    default_record.orientation[0] = 1.0f;
+
+    std::vector<gsd_particle_record> slice(n_slice, default_record);
+    for (unsigned int i = 0; i < n_slice; i++)
+        slice[i].tag = slice_begin[rank] + i;
+
+    const gsd_parallel_chunk chunks[] = {
+        {"particles/typeid", 4, offsetof(gsd_particle_record, typeid_)},
+        {"particles/mass", 4, offsetof(gsd_particle_record, mass)},
+        {"particles/charge", 4, offsetof(gsd_particle_record, charge)},
+        {"particles/diameter", 4, offsetof(gsd_particle_record, diameter)},
+        {"particles/body", 4, offsetof(gsd_particle_record, body)},
+        {"particles/moment_inertia", 12, offsetof(gsd_particle_record, inertia)},
+        {"particles/position", 12, offsetof(gsd_particle_record, position)},
+        {"particles/orientation", 16, offsetof(gsd_particle_record, orientation)},
+        {"particles/velocity", 12, offsetof(gsd_particle_record, velocity)},
+        {"particles/angmom", 16, offsetof(gsd_particle_record, angmom)},
+        {"particles/image", 12, offsetof(gsd_particle_record, image)}};
+    const unsigned int n_chunks = sizeof(chunks)/sizeof(gsd_parallel_chunk);
+
+    // errors are only raised once all ranks know about them, so that no rank is left waiting in a collective call
+    int status = 0;
+
+    std::vector<char> rows;
+    for (unsigned int c = 0; c < n_chunks; c++)
+        {
+        int retval = readChunkSlice(rows, chunks[c].name, chunks[c].row_size, slice_begin);
+        if (retval == -1)
+            status = 1;
+        else if (retval == 1)
+            {
+            for (unsigned int i = 0; i < n_slice; i++)
+                memcpy((char *)&slice[i] + chunks[c].offset, &rows[i*chunks[c].row_size], chunks[c].row_size);
+            }
+        }
+
+    // find the rank whose domain holds each particle
+    std::vector<int> send_bytes(n_ranks, 0);
+    std::vector<unsigned int> dest(n_slice);
+
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < n_slice; i++)
+            {
+            gsd_particle_record& r = slice[i];
+            Scalar3 pos = make_scalar3(r.position[0], r.position[1], r.position[2]);
+            int3 img = make_int3(r.image[0], r.image[1], r.image[2]);
+            dest[i] = decomposition->placeSnapshotParticle(global_box, pos, img, h_cart_ranks.data);
+            if (dest[i] >= n_ranks)
+                {
+                m_exec_conf->msg->error() << "init.*: Particle " << r.tag << " out of bounds." << std::endl;
+                status = 1;
+                dest[i] = rank;
+                }
+
+            // store the wrapped position
+            r.position[0] = float(pos.x);
+            r.position[1] = float(pos.y);
+            r.position[2] = float(pos.z);
+            r.image[0] = img.x;
+            r.image[1] = img.y;
+            r.image[2] = img.z;
+            send_bytes[dest[i]] += sizeof(gsd_particle_record);
+            }
+        }
+
+    MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MAX, mpi_comm);
+    if (status)
+        throw runtime_error("Error reading GSD file");
+
+    // order the records by destination rank
+    std::vector<int> send_displs(n_ranks, 0);
+    for (unsigned int i = 1; i < n_ranks; i++)
+        send_displs[i] = send_displs[i-1] + send_bytes[i-1];
+
+    std::vector<gsd_particle_record> send_buf(n_slice);
+        {
+        std::vector<unsigned int> n_placed(n_ranks, 0);
+        for (unsigned int i = 0; i < n_slice; i++)
+            send_buf[send_displs[dest[i]]/sizeof(gsd_particle_record) + n_placed[dest[i]]++] = slice[i];
+        }
+    std::vector<gsd_particle_record>().swap(slice);
+
+    // exchange the records
+    std::vector<int> recv_bytes(n_ranks, 0);
+    std::vector<int> recv_displs(n_ranks, 0);
+    MPI_Alltoall(&send_bytes[0], 1, MPI_INT, &recv_bytes[0], 1, MPI_INT, mpi_comm);
+    for (unsigned int i = 1; i < n_ranks; i++)
+        recv_displs[i] = recv_displs[i-1] + recv_bytes[i-1];
+
+    unsigned int n_recv = (recv_displs[n_ranks-1] + recv_bytes[n_ranks-1]) / sizeof(gsd_particle_record);
+    std::vector<gsd_particle_record> recv_buf(n_recv);
+    MPI_Alltoallv(send_buf.size() ? &send_buf[0] : NULL, &send_bytes[0], &send_displs[0], MPI_BYTE,
+                  recv_buf.size() ? &recv_buf[0] : NULL, &recv_bytes[0], &recv_displs[0], MPI_BYTE, mpi_comm);
+    std::vector<gsd_particle_record>().swap(send_buf);
+
+    // the records come from several ranks, put them in tag order
+    std::sort(recv_buf.begin(), recv_buf.end(),
+        [](const gsd_particle_record& a, const gsd_particle_record& b) { return a.tag < b.tag; });
+
+    SnapshotParticleData<float>& snap = m_local_particles;
+    snap.resize(n_recv);
+    snap.type_mapping = m_snapshot->particle_data.type_mapping;
+    m_local_tags.resize(n_recv);
+    for (unsigned int i = 0; i < n_recv; i++)
+        {
+        const gsd_particle_record& r = recv_buf[i];
+        m_local_tags[i] = r.tag;
+        snap.type[i] = r.typeid_;
+        snap.mass[i] = r.mass;
+        snap.charge[i] = r.charge;
+        snap.diameter[i] = r.diameter;
+        snap.body[i] = r.body;
+        snap.inertia[i] = vec3<float>(r.inertia[0], r.inertia[1], r.inertia[2]);
+        snap.pos[i] = vec3<float>(r.position[0], r.position[1], r.position[2]);
+        snap.orientation[i] = quat<float>(r.orientation[0],
+                                          vec3<float>(r.orientation[1], r.orientation[2], r.orientation[3]));
+        snap.vel[i] = vec3<float>(r.velocity[0], r.velocity[1], r.velocity[2]);
+        snap.angmom[i] = quat<float>(r.angmom[0], vec3<float>(r.angmom[1], r.angmom[2], r.angmom[3]));
+        snap.image[i] = make_int3(r.image[0], r.image[1], r.image[2]);
+        }
+    }
+#endif
+
 /*! Read the same data chunks for topology
 */
 void GSDReader::readTopology()
@@ -373,6 +737,8 @@ void export_GSDReader(py::module& m)
     {
     py::class_< GSDReader, std::shared_ptr<GSDReader> >(m,"GSDReader")
     .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool>())
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool, bool>())
+    .def("isParallel", &GSDReader::isParallel)
     .def("getTimeStep", &GSDReader::getTimeStep)
     .def("getSnapshot", &GSDReader::getSnapshot)
     .def("clearSnapshot", &GSDReader::clearSnapshot)
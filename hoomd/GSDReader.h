@@ -14,6 +14,7 @@
 
 #include "ParticleData.h"
 #include <string>
+#include <vector>
 #include "hoomd/extern/gsd.h"
 
 #ifdef NVCC
@@ -39,7 +40,8 @@ class PYBIND11_EXPORT GSDReader
         GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                   const std::string &name,
                   const uint64_t frame,
-                  bool from_end);
+                  bool from_end,
+                  bool parallel=false);
 
         //! Destructor
         ~GSDReader();
@@ -87,6 +89,42 @@ class PYBIND11_EXPORT GSDReader
 
         pybind11::list readTypeShapesPy(uint64_t frame);
 
+        //! Test if the particles are read on every rank
+        bool isParallel() const
+            {
+            return m_parallel;
+            }
+
+        //! Get the global number of particles
+        unsigned int getNGlobal() const
+            {
+            return m_nglobal;
+            }
+
+        #ifdef ENABLE_MPI
+        //! Read the particles in the local domain
+        void readLocalParticles(std::shared_ptr<DomainDecomposition> decomposition, const BoxDim& global_box);
+
+        //! Get the particles read by readLocalParticles()
+        const SnapshotParticleData<float>& getLocalParticles() const
+            {
+            return m_local_particles;
+            }
+
+        //! Get the tags of the particles read by readLocalParticles()
+        const std::vector<unsigned int>& getLocalTags() const
+            {
+            return m_local_tags;
+            }
+
+        //! Free the particles read by readLocalParticles()
+        void clearLocalParticles()
+            {
+            m_local_particles = SnapshotParticleData<float>();
+            std::vector<unsigned int>().swap(m_local_tags);
+            }
+        #endif
+
     private:
         std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
         uint64_t m_timestep;                                         //!< Timestep at the selected frame
@@ -94,6 +132,10 @@ class PYBIND11_EXPORT GSDReader
         uint64_t m_frame;                                            //!< Cached frame
         std::shared_ptr< SnapshotSystemData<float> > m_snapshot;   //!< The snapshot to read
         gsd_handle m_handle;                                         //!< Handle to the file
+        bool m_parallel;                                             //!< True if all ranks read the file
+        unsigned int m_nglobal;                                      //!< Number of particles in the frame
+        SnapshotParticleData<float> m_local_particles;               //!< Particles in the local domain
+        std::vector<unsigned int> m_local_tags;                      //!< Tags of the particles in the local domain
 
         //! Helper function to read a type list from the file
         std::vector<std::string> readTypes(uint64_t frame, const char *name);
@@ -102,6 +144,12 @@ class PYBIND11_EXPORT GSDReader
         void readHeader();
         void readParticles();
         void readTopology();
+
+        #ifdef ENABLE_MPI
+        //! Read this rank's slice of the rows of a per-particle chunk
+        int readChunkSlice(std::vector<char>& rows, const char *name, size_t row_size,
+                           const std::vector<unsigned int>& slice_begin);
+        #endif
     };
 
 //! Exports GSDReader to python
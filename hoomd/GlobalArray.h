@@ -310,6 +310,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
                 m_acquired = false;
                 m_align_bytes = rhs.m_align_bytes;
                 m_tag = rhs.m_tag;
+                this->m_write_count++;
 
                 if (rhs.m_data.get())
                     {
@@ -357,6 +358,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
               , m_event(std::move(other.m_event))
               #endif
             {
+            this->m_write_count = other.m_write_count;
             }
 
         //! Move assignment operator
@@ -380,6 +382,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
                 #ifdef ENABLE_CUDA
                 m_event = std::move(other.m_event);
                 #endif
+                this->m_write_count = other.m_write_count;
                 }
 
             return *this;
@@ -440,6 +443,7 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
             #ifdef ENABLE_CUDA
             std::swap(m_event, from.m_event);
             #endif
+            std::swap(this->m_write_count, from.m_write_count);
 
             #ifndef ALWAYS_USE_MANAGED_MEMORY
             m_fallback.swap(from.m_fallback);
@@ -521,6 +525,8 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
         */
         inline void resize(unsigned int num_elements)
             {
+            this->m_write_count++;
+
             #ifndef ALWAYS_USE_MANAGED_MEMORY
             if (! this->m_exec_conf || ! m_is_managed)
                 {
@@ -567,6 +573,8 @@ class GlobalArray : public GPUArrayBase<T, GlobalArray<T> >
             {
             assert(this->m_exec_conf);
 
+            this->m_write_count++;
+
             #ifndef ALWAYS_USE_MANAGED_MEMORY
             if (! m_is_managed)
                 {
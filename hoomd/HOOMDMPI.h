@@ -54,6 +54,11 @@ typedef struct{
     int i;
     }Scalar_Int;
 
+//! Number of elements per message when snapshots are distributed to the ranks
+/*! Snapshots are streamed in chunks of this size so that the temporary buffers are bounded independent of N.
+*/
+const unsigned int MPI_SNAPSHOT_CHUNK_SIZE = 65536;
+
 
 namespace cereal
    {
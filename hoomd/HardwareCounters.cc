@@ -0,0 +1,111 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file HardwareCounters.cc
+    \brief Defines the HardwareCounters class
+*/
+
+#include "HardwareCounters.h"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef __linux__
+//! Open one hardware counter of the calling thread
+/*! \param config Hardware event (PERF_COUNT_HW_*)
+    \param group_fd File descriptor of the group leader, -1 to open the leader
+    \returns The file descriptor, -1 on error
+*/
+static int open_counter(uint64_t config, int group_fd)
+    {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    // the leader starts the whole group
+    attr.disabled = (group_fd == -1);
+
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+    }
+#endif
+
+HardwareCounters::HardwareCounters()
+    {
+    for (unsigned int i = 0; i < num_counters; i++)
+        m_fds[i] = -1;
+
+#ifdef __linux__
+    const uint64_t config[num_counters] = {PERF_COUNT_HW_CPU_CYCLES,
+                                           PERF_COUNT_HW_INSTRUCTIONS,
+                                           PERF_COUNT_HW_CACHE_MISSES};
+
+    for (unsigned int i = 0; i < num_counters; i++)
+        {
+        m_fds[i] = open_counter(config[i], m_fds[0]);
+        if (m_fds[i] < 0)
+            {
+            m_error = string("perf_event_open failed: ") + strerror(errno);
+            if (errno == EACCES || errno == EPERM)
+                m_error += " (check /proc/sys/kernel/perf_event_paranoid)";
+
+            for (unsigned int j = 0; j < i; j++)
+                {
+                close(m_fds[j]);
+                m_fds[j] = -1;
+                }
+            return;
+            }
+        }
+
+    ioctl(m_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+    m_error = "hardware counters are only supported on Linux";
+#endif
+    }
+
+HardwareCounters::~HardwareCounters()
+    {
+#ifdef __linux__
+    for (unsigned int i = 0; i < num_counters; i++)
+        if (m_fds[i] >= 0)
+            close(m_fds[i]);
+#endif
+    }
+
+/*! \param values Output: num_counters counter values, all zero if the counters cannot be read
+*/
+void HardwareCounters::read(int64_t *values) const
+    {
+    for (unsigned int i = 0; i < num_counters; i++)
+        values[i] = 0;
+
+#ifdef __linux__
+    if (!isAvailable())
+        return;
+
+    // with PERF_FORMAT_GROUP, the kernel writes the number of counters followed by their values
+    uint64_t buf[num_counters+1];
+    ssize_t n = ::read(m_fds[0], buf, sizeof(buf));
+    if (n != (ssize_t)sizeof(buf) || buf[0] != num_counters)
+        return;
+
+    for (unsigned int i = 0; i < num_counters; i++)
+        values[i] = (int64_t)buf[i+1];
+#endif
+    }
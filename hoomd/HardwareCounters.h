@@ -0,0 +1,78 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file HardwareCounters.h
+    \brief Declares the HardwareCounters class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __HARDWARE_COUNTERS_H__
+#define __HARDWARE_COUNTERS_H__
+
+#include <stdint.h>
+#include <string>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Reads the hardware performance counters of the calling thread
+/*! On Linux, the counters are opened with perf_event_open as one group, so that all of them are read at once with
+    a single system call. Only user space events of the thread that constructs the HardwareCounters are counted,
+    threads it starts later are not included.
+
+    Opening the counters fails when the kernel does not allow it (see /proc/sys/kernel/perf_event_paranoid), in
+    virtual machines without a virtual PMU, and on other operating systems. isAvailable() then returns false, and
+    getError() the reason.
+
+    Memory traffic is estimated from the last level cache misses, each of which transfers one cache line.
+    \ingroup utils
+*/
+class PYBIND11_EXPORT HardwareCounters
+    {
+    public:
+        //! Indices of the counters
+        enum counter
+            {
+            cycles = 0,     //!< CPU cycles
+            instructions,   //!< Retired instructions
+            llc_misses,     //!< Last level cache misses
+            num_counters
+            };
+
+        //! Size of a cache line in bytes
+        static const unsigned int cache_line_size = 64;
+
+        //! Open and start the counters
+        HardwareCounters();
+
+        //! Close the counters
+        ~HardwareCounters();
+
+        //! Test if the counters could be opened
+        bool isAvailable() const
+            {
+            return m_fds[0] >= 0;
+            }
+
+        //! Get the reason why the counters are not available
+        const std::string& getError() const
+            {
+            return m_error;
+            }
+
+        //! Read the current counter values
+        void read(int64_t *values) const;
+
+    private:
+        int m_fds[num_counters];    //!< File descriptors of the counters, m_fds[0] is the group leader
+        std::string m_error;        //!< Reason why the counters are not available
+
+        //! Prevent copies, which would close the file descriptors twice
+        HardwareCounters(const HardwareCounters&);
+        HardwareCounters& operator=(const HardwareCounters&);
+    };
+
+#endif
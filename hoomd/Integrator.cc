@@ -27,6 +27,8 @@ using namespace std;
 */
 Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT) : Updater(sysdef), m_deltaT(deltaT)
     {
+    m_call_timer->setName("time_integrate");
+
     if (m_deltaT <= 0.0)
         m_exec_conf->msg->warning() << "integrate.*: A timestep of less than 0.0 was specified" << endl;
     }
@@ -38,7 +40,10 @@ Integrator::~Integrator()
     if (m_request_flags_connected && m_comm)
         m_comm->getCommFlagsRequestSignal().disconnect<Integrator, &Integrator::determineFlags>(this);
     if (m_signals_connected && m_comm)
+        {
         m_comm->getComputeCallbackSignal().disconnect<Integrator, &Integrator::computeCallback>(this);
+        m_comm->getInteriorComputeCallbackSignal().disconnect<Integrator, &Integrator::computeInteriorCallback>(this);
+        }
     #endif
     }
 
@@ -48,7 +53,7 @@ void Integrator::addForceCompute(std::shared_ptr<ForceCompute> fc)
     {
     assert(fc);
     m_forces.push_back(fc);
-    fc->setDeltaT(m_deltaT);
+    fc->setDeltaT(m_deltaT*fc->getMTSPeriod());
     }
 
 /*! \param fc ForceConstraint to add
@@ -91,8 +96,9 @@ void Integrator::setDeltaT(Scalar deltaT)
     if (m_deltaT <= 0.0)
         m_exec_conf->msg->warning() << "integrate.*: A timestep of less than 0.0 was specified" << endl;
 
+    // forces applied every few steps see the correspondingly longer time step
     for (unsigned int i=0; i < m_forces.size(); i++)
-        m_forces[i]->setDeltaT(deltaT);
+        m_forces[i]->setDeltaT(deltaT*m_forces[i]->getMTSPeriod());
 
     for (unsigned int i=0; i < m_constraint_forces.size(); i++)
         m_constraint_forces[i]->setDeltaT(deltaT);
@@ -306,12 +312,24 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and \a m_net_virial
     \note The summation step is performed <b>on the CPU</b> and will result in a lot of data traffic back and forth
           if the forces and/or integrator are on the GPU. Call computeNetForcesGPU() to sum the forces on the GPU
+
+    Forces with a multiple time step period \a P > 1 (see ForceCompute::setMTSPeriod()) are only computed on time
+    steps that are a multiple of \a P, where their force and torque enter the net force scaled by \a P. Because every
+    two-step integration method applies the net force in the kicks before and after such a step, this is the impulse
+    form of r-RESPA for any integration method. On the other steps, these forces contribute no force, and the energy
+    and virial of their last evaluation are carried in the external energy and virial so that thermodynamic
+    quantities remain complete.
 */
 void Integrator::computeNetForce(unsigned int timestep)
     {
+    int64_t start_time = m_measure_compute_time ? m_compute_clock.getTime() : 0;
+
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+        {
+        if ((*force_compute)->isMTSStep(timestep))
+            (*force_compute)->compute(timestep);
+        }
 
     if (m_prof)
         {
@@ -351,6 +369,17 @@ void Integrator::computeNetForce(unsigned int timestep)
 
         for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
             {
+            unsigned int mts_period = (*force_compute)->getMTSPeriod();
+            if (!(*force_compute)->isMTSStep(timestep))
+                {
+                // not applied on this step, carry the energy and virial of the last evaluation
+                for (unsigned int k = 0; k < 6; k++)
+                    external_virial[k] += (*force_compute)->getMTSVirial(k);
+
+                external_energy += (*force_compute)->getMTSEnergy();
+                continue;
+                }
+
             GlobalArray<Scalar4>& h_force_array = (*force_compute)->getForceArray();
             GlobalArray<Scalar>& h_virial_array = (*force_compute)->getVirialArray();
             GlobalArray<Scalar4>& h_torque_array = (*force_compute)->getTorqueArray();
@@ -364,22 +393,62 @@ void Integrator::computeNetForce(unsigned int timestep)
             ArrayHandle<Scalar4> h_torque(h_torque_array,access_location::host,access_mode::read);
 
             unsigned int virial_pitch = h_virial_array.getPitch();
-            for (unsigned int j = 0; j < nparticles; j++)
+            if (mts_period == 1)
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
-                h_net_force.data[j].w += h_force.data[j].w;
-
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
-                h_net_torque.data[j].w += h_torque.data[j].w;
-
+                for (unsigned int j = 0; j < nparticles; j++)
+                    {
+                    h_net_force.data[j].x += h_force.data[j].x;
+                    h_net_force.data[j].y += h_force.data[j].y;
+                    h_net_force.data[j].z += h_force.data[j].z;
+                    h_net_force.data[j].w += h_force.data[j].w;
+
+                    h_net_torque.data[j].x += h_torque.data[j].x;
+                    h_net_torque.data[j].y += h_torque.data[j].y;
+                    h_net_torque.data[j].z += h_torque.data[j].z;
+                    h_net_torque.data[j].w += h_torque.data[j].w;
+
+                    for (unsigned int k = 0; k < 6; k++)
+                        {
+                        h_net_virial.data[k*net_virial_pitch+j] += h_virial.data[k*virial_pitch+j];
+                        }
+                    }
+                }
+            else
+                {
+                // apply the force as an impulse over the whole period, the energy and virial are not scaled
+                Scalar scale = Scalar(mts_period);
+                Scalar mts_energy = (*force_compute)->getExternalEnergy();
+                Scalar mts_virial[6];
                 for (unsigned int k = 0; k < 6; k++)
+                    mts_virial[k] = (*force_compute)->getExternalVirial(k);
+
+                for (unsigned int j = 0; j < nparticles; j++)
                     {
-                    h_net_virial.data[k*net_virial_pitch+j] += h_virial.data[k*virial_pitch+j];
+                    h_net_force.data[j].x += scale*h_force.data[j].x;
+                    h_net_force.data[j].y += scale*h_force.data[j].y;
+                    h_net_force.data[j].z += scale*h_force.data[j].z;
+                    h_net_force.data[j].w += h_force.data[j].w;
+
+                    h_net_torque.data[j].x += scale*h_torque.data[j].x;
+                    h_net_torque.data[j].y += scale*h_torque.data[j].y;
+                    h_net_torque.data[j].z += scale*h_torque.data[j].z;
+                    h_net_torque.data[j].w += scale*h_torque.data[j].w;
+
+                    for (unsigned int k = 0; k < 6; k++)
+                        {
+                        h_net_virial.data[k*net_virial_pitch+j] += h_virial.data[k*virial_pitch+j];
+                        }
+
+                    // ghost particles do not count towards the local totals
+                    if (j < m_pdata->getN())
+                        {
+                        mts_energy += h_force.data[j].w;
+                        for (unsigned int k = 0; k < 6; k++)
+                            mts_virial[k] += h_virial.data[k*virial_pitch+j];
+                        }
                     }
+
+                (*force_compute)->setMTSTotals(mts_energy, mts_virial);
                 }
 
             for (unsigned int k = 0; k < 6; k++)
@@ -400,6 +469,10 @@ void Integrator::computeNetForce(unsigned int timestep)
         m_prof->pop();
         }
 
+    // the net force communication waits for the other ranks and is not counted
+    if (m_measure_compute_time)
+        addComputeTime(start_time);
+
     // return early if there are no constraint forces or no HalfStepHook set
     if (m_constraint_forces.size() == 0)
         return;
@@ -412,6 +485,8 @@ void Integrator::computeNetForce(unsigned int timestep)
         }
     #endif
 
+    start_time = m_measure_compute_time ? m_compute_clock.getTime() : 0;
+
     // compute all the constraint forces next
     // constraint forces only apply a force, not a torque
     std::vector< std::shared_ptr<ForceConstraint> >::iterator force_constraint;
@@ -484,6 +559,9 @@ void Integrator::computeNetForce(unsigned int timestep)
         m_prof->pop();
         m_prof->pop();
         }
+
+    if (m_measure_compute_time)
+        addComputeTime(start_time);
     }
 
 #ifdef ENABLE_CUDA
@@ -499,12 +577,21 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         throw runtime_error("Error computing accelerations");
         }
 
+    int64_t start_time = m_measure_compute_time ? m_compute_clock.getTime() : 0;
+
     // compute all the normal forces first
 
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
 
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        {
+        if ((*force_compute)->getMTSPeriod() != 1)
+            {
+            m_exec_conf->msg->error() << "Multiple time step integration is not supported on the GPU" << endl;
+            throw runtime_error("Error computing accelerations");
+            }
         (*force_compute)->compute(timestep);
+        }
 
     if (m_prof)
         {
@@ -680,6 +767,10 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         m_prof->pop(m_exec_conf);
         }
 
+    // the net force communication waits for the other ranks and is not counted
+    if (m_measure_compute_time)
+        addComputeTime(start_time);
+
     // return early if there are no constraint forces or no HalfStepHook set
     if (m_constraint_forces.size() == 0)
         return;
@@ -692,6 +783,8 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         }
     #endif
 
+    start_time = m_measure_compute_time ? m_compute_clock.getTime() : 0;
+
     // compute all the constraint forces next
     std::vector< std::shared_ptr<ForceConstraint> >::iterator force_constraint;
     for (force_constraint = m_constraint_forces.begin(); force_constraint != m_constraint_forces.end(); ++force_constraint)
@@ -845,9 +938,25 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         m_prof->pop(m_exec_conf);
         }
 
+    if (m_measure_compute_time)
+        addComputeTime(start_time);
     }
 #endif
 
+/*! \param start_time Clock time at which the measured part of the force computation started
+
+    On the GPU, the kernels execute asynchronously, so the device is synchronized first.
+*/
+void Integrator::addComputeTime(int64_t start_time)
+    {
+    #ifdef ENABLE_CUDA
+    if (m_exec_conf->isCUDAEnabled())
+        cudaDeviceSynchronize();
+    #endif
+
+    m_compute_time += double(m_compute_clock.getTime() - start_time) * 1e-9;
+    }
+
 /*! The base class integrator actually does nothing in update()
     \param timestep Current time step of the simulation
 */
@@ -904,7 +1013,10 @@ void Integrator::setCommunicator(std::shared_ptr<Communicator> comm)
     m_request_flags_connected = true;
 
     if (! m_signals_connected && m_comm)
+        {
         comm->getComputeCallbackSignal().connect<Integrator, &Integrator::computeCallback>(this);
+        comm->getInteriorComputeCallbackSignal().connect<Integrator, &Integrator::computeInteriorCallback>(this);
+        }
 
     m_signals_connected = true;
     }
@@ -915,7 +1027,25 @@ void Integrator::computeCallback(unsigned int timestep)
     std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
 
     for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->preCompute(timestep);
+        {
+        if ((*force_compute)->isMTSStep(timestep))
+            (*force_compute)->preCompute(timestep);
+        }
+    }
+
+/*! Nothing is computed when the particles are going to migrate, since the neighbor lists are then rebuilt and the
+    early results would be discarded.
+*/
+void Integrator::computeInteriorCallback(unsigned int timestep)
+    {
+    if (m_comm->peekMigrate(timestep))
+        return;
+
+    for (auto force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        {
+        if ((*force_compute)->isMTSStep(timestep))
+            (*force_compute)->computeInterior(timestep);
+        }
     }
 #endif
 
@@ -948,5 +1078,8 @@ void export_Integrator(py::module& m)
     .def("setDeltaT", &Integrator::setDeltaT)
     .def("getNDOF", &Integrator::getNDOF)
     .def("getRotationalNDOF", &Integrator::getRotationalNDOF)
+    .def("enableComputeTimer", &Integrator::enableComputeTimer)
+    .def("getComputeTime", &Integrator::getComputeTime)
+    .def("resetComputeTime", &Integrator::resetComputeTime)
     ;
     }
@@ -20,6 +20,7 @@
 #include "ForceConstraint.h"
 #include "HalfStepHook.h"
 #include "ParticleGroup.h"
+#include "ClockSource.h"
 #include <string>
 #include <vector>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
@@ -129,6 +130,30 @@ class PYBIND11_EXPORT Integrator : public Updater
         //! Prepare for the run
         virtual void prepRun(unsigned int timestep);
 
+        //! Enable or disable measuring the time spent in the force computation
+        /*! \param enable Set to true to accumulate the wall-clock time of every net force computation
+
+            On the GPU, the device is synchronized at the end of each measured computation. The communication of
+            the net force to the ghost particles is not measured, but communication inside of the force computes
+            (e.g. the distributed FFT of PPPM) is, including any time spent waiting for other ranks.
+        */
+        void enableComputeTimer(bool enable)
+            {
+            m_measure_compute_time = enable;
+            }
+
+        //! Get the wall-clock time spent computing the net force since the last reset (in seconds)
+        double getComputeTime() const
+            {
+            return m_compute_time;
+            }
+
+        //! Reset the accumulated force computation time
+        void resetComputeTime()
+            {
+            m_compute_time = 0.0;
+            }
+
         #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm The Communicator
@@ -137,6 +162,9 @@ class PYBIND11_EXPORT Integrator : public Updater
 
         //! Callback for pre-computing the forces
         void computeCallback(unsigned int timestep);
+
+        //! Callback for computing the forces that do not depend on ghosts during the ghost update
+        virtual void computeInteriorCallback(unsigned int timestep);
         #endif
 
     protected:
@@ -168,6 +196,13 @@ class PYBIND11_EXPORT Integrator : public Updater
         bool getAnisotropic();
 
     private:
+        ClockSource m_compute_clock;                //!< Clock for measuring the force computation time
+        bool m_measure_compute_time = false;        //!< True if the force computation time is accumulated
+        double m_compute_time = 0.0;                //!< Accumulated force computation time (in seconds)
+
+        //! Add the time since \a start_time to the accumulated force computation time
+        void addComputeTime(int64_t start_time);
+
         #ifdef ENABLE_MPI
         bool m_request_flags_connected = false;     //!< Connection to Communicator to request communication flags
         bool m_signals_connected = false;                           //!< Track if we have already connected signals
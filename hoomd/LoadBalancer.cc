@@ -33,6 +33,7 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
         : Updater(sysdef), m_decomposition(decomposition), m_mpi_comm(m_exec_conf->getMPICommunicator()),
           m_max_imbalance(Scalar(1.0)), m_recompute_max_imbalance(true), m_needs_migrate(false),
           m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
+          m_cost_model(particle_count), m_damping(Scalar(0.0)), m_cost_per_particle(Scalar(1.0)),
           m_N_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
           m_n_iterations(0), m_n_rebalances(0)
     {
@@ -66,6 +67,9 @@ void LoadBalancer::update(unsigned int timestep)
     // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
     resetNOwn(m_pdata->getN());
 
+    // the measured cost applies to the particles on the rank now, and is kept for all iterations of this step
+    computeCostPerParticle();
+
     // figure out which rank is the reduction root for broadcasting
     const Index3D& di = m_decomposition->getDomainIndexer();
     unsigned int reduce_root(0);
@@ -112,17 +116,17 @@ void LoadBalancer::update(unsigned int timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
+            vector<Scalar> load_i;
             bool adjusted = false;
 
-            // reduce the number of particles in the slice along dim
-            bool active = reduce(N_i, dim, reduce_root);
+            // reduce the load in the slice along dim
+            bool active = reduce(load_i, dim, reduce_root);
 
             // attempt an adjustment
             vector<Scalar> cum_frac = m_decomposition->getCumulativeFractions(dim);
             if (active)
                 {
-                adjusted = adjust(cum_frac, N_i, L_i, min_frac_i);
+                adjusted = adjust(cum_frac, load_i, L_i, min_frac_i);
                 }
 
             // broadcast if an adjustment has been made on the root
@@ -150,17 +154,67 @@ void LoadBalancer::update(unsigned int timestep)
             }
         }
 
+    // start a new measurement interval
+    if (m_integrator)
+        m_integrator->resetComputeTime();
+
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all ranks.
+ * \returns The force computation time of the integrator, or 0 if there is none
+ */
+double LoadBalancer::getComputeTime()
+    {
+    if (!m_integrator)
+        return 0.0;
+
+    return m_integrator->getComputeTime();
+    }
+
+/*!
+ * With the particle_count cost model, every particle has unit cost. With the compute_time cost model, the cost of a
+ * particle is the measured time divided by the number of particles on the rank. Until every rank has a time
+ * measurement (e.g., at the first balancing step), all ranks fall back to unit cost.
+ *
+ * \note All ranks must call this method since it involves a collective MPI call.
+ */
+void LoadBalancer::computeCostPerParticle()
+    {
+    m_cost_per_particle = Scalar(1.0);
+    m_recompute_max_imbalance = true;
+
+    if (m_cost_model != compute_time)
+        return;
+
+    double t = getComputeTime();
+    double min_t(0.0);
+    MPI_Allreduce(&t, &min_t, 1, MPI_DOUBLE, MPI_MIN, m_mpi_comm);
+
+    if (min_t > 0.0)
+        {
+        // a rank without particles still has a fixed cost, which is attributed to a single particle
+        m_cost_per_particle = Scalar(t / double(std::max(getNOwn(), 1u)));
+        }
+    }
+
+/*!
+ * Computes the imbalance factor I = L / <L> for each rank, and computes the maximum among all ranks. The load L is the
+ * number of particles, or the estimated compute time, depending on the cost model.
  */
 Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn()) / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        Scalar cur_load = getLoad();
+        Scalar total_load = Scalar(m_pdata->getNGlobal());
+        if (m_cost_model == compute_time)
+            {
+            // the total estimated load changes when particles move between ranks of different cost
+            MPI_Allreduce(&cur_load, &total_load, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+            }
+
+        Scalar cur_imb = (total_load > Scalar(0.0)) ? cur_load / (total_load / Scalar(m_exec_conf->getNRanks())) : Scalar(1.0);
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -175,12 +229,12 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * \param N_i Vector holding the total load in each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
  * \returns true if the current rank holds the active \a N_i
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
+ * \post \a N_i holds the load (see getLoad()) in each slice along \a dim
  *
  * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for efficiency the data will
  *       be active only on Cartesian rank \a reduce_root, as indicated by the return value. As a result, only \a reduce_root
@@ -191,18 +245,18 @@ Scalar LoadBalancer::getMaxImbalance()
  * down dimensions. Generally, load balancing should not be performed too frequently, and so we do not pursue this
  * optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root)
+bool LoadBalancer::reduce(std::vector<Scalar>& N_i, unsigned int dim, unsigned int reduce_root)
     {
     // do nothing if there is only one rank
     if (N_i.size() == 1) return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<Scalar> N_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load of the current rank (the quantity to be reduced)
+    Scalar N_own = getLoad();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&N_own, 1, MPI_HOOMD_SCALAR, &N_per_rank[0], 1, MPI_HOOMD_SCALAR, reduce_root, m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -210,7 +264,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
     // rearrange the data from ranks to cartesian order in case it is jumbled around
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(), access_location::host, access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<Scalar> N_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank=0; cur_rank < di.getNumElements(); ++cur_rank)
         {
         N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
@@ -273,15 +327,15 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param N_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
  * \returns true if an adjustment occurred
  *
  * An adjustment is attempted as follows:
- *  1. Compute the imbalance factor (and scale factor) for each slice. Enforce the maximum 5% target for adjustment
- *     in the scale factor. Compute the target new width for each rank.
+ *  1. Compute the imbalance factor (and scale factor) for each slice. Damp the scale factor, and enforce the maximum 5%
+ *     target for adjustment. Compute the target new width for each rank.
  *  2. Construct a set of linear equations with box constraints that will enforce the necessary constraints. This is
  *     done through a matrix A that converts slices between domains into widths while conserving total length. A is then
  *     augmented to include an inequality constraint on the minimum domain size through a slack variable w. Additional
@@ -291,15 +345,17 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
  *     successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<Scalar>& N_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
     if (N_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per rank is uniform distribution
+    const Scalar target = std::accumulate(N_i.begin(), N_i.end(), Scalar(0.0)) / Scalar(N_i.size());
+    if (target <= Scalar(0.0))
+        return false;
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
@@ -316,6 +372,9 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
         const Scalar imb_factor = Scalar(N_i[i]) / target;
         Scalar scale_factor = (N_i[i] > 0) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
 
+        // apply only part of the proposed rescaling
+        scale_factor = Scalar(1.0) + (Scalar(1.0) - m_damping) * (scale_factor - Scalar(1.0));
+
         // limit rescaling to 5% either direction
         // we should use absolute distance here, it is necessary to control balancing in corrugated systems
         if (scale_factor > (Scalar(1.0) + m_max_scale))
@@ -571,13 +630,24 @@ void LoadBalancer::resetStats()
 
 void export_LoadBalancer(py::module& m)
     {
-    py::class_<LoadBalancer, std::shared_ptr<LoadBalancer> >(m,"LoadBalancer",py::base<Updater>())
-    .def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >())
+    py::class_<LoadBalancer, std::shared_ptr<LoadBalancer> > loadbalancer(m,"LoadBalancer",py::base<Updater>());
+    loadbalancer.def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >())
     .def("enableDimension", &LoadBalancer::enableDimension)
     .def("getTolerance", &LoadBalancer::getTolerance)
     .def("setTolerance", &LoadBalancer::setTolerance)
     .def("getMaxIterations", &LoadBalancer::getMaxIterations)
     .def("setMaxIterations", &LoadBalancer::setMaxIterations)
+    .def("setCostModel", &LoadBalancer::setCostModel)
+    .def("getCostModel", &LoadBalancer::getCostModel)
+    .def("setIntegrator", &LoadBalancer::setIntegrator)
+    .def("setDamping", &LoadBalancer::setDamping)
+    .def("getDamping", &LoadBalancer::getDamping)
+    ;
+
+    py::enum_<LoadBalancer::costModel>(loadbalancer,"costModel")
+    .value("particle_count", LoadBalancer::costModel::particle_count)
+    .value("compute_time", LoadBalancer::costModel::compute_time)
+    .export_values()
     ;
     }
 #endif // ENABLE_MPI
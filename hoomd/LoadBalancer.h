@@ -18,6 +18,7 @@
 #define __LOADBALANCER_H__
 
 #include "Updater.h"
+#include "Integrator.h"
 
 #include <memory>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
@@ -41,11 +42,24 @@
  * Constraints are satisfied by solving a least-squares problem with box constraints, where the cost function is the
  * deviation of the domain sizes from the proposed rescaled width.
  *
+ * With the compute_time cost model, the load of a rank is its number of particles weighted by the measured
+ * wall-clock time per particle of the force computation on that rank since the last balancing step. Particles that
+ * move to another rank during balancing are priced at the cost per particle measured by the rank that receives them,
+ * since the cost is not carried along with the particles. A damping factor reduces each rescaling to a fraction of
+ * the proposed one to avoid oscillations from noisy measurements.
+ *
  * \ingroup updaters
  */
 class PYBIND11_EXPORT LoadBalancer : public Updater
     {
     public:
+        //! Measure of the load of a rank
+        enum costModel
+            {
+            particle_count = 0, //!< Number of owned particles
+            compute_time        //!< Owned particles weighted by the measured force computation time per particle
+            };
+
         //! Constructor
         LoadBalancer(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<DomainDecomposition> decomposition);
         //! Destructor
@@ -83,6 +97,61 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
             m_maxiter = maxiter;
             }
 
+        //! Set the measure of the load of a rank
+        /*!
+         * \param model Cost model
+         */
+        void setCostModel(costModel model)
+            {
+            m_cost_model = model;
+            m_recompute_max_imbalance = true;
+            if (m_integrator)
+                m_integrator->enableComputeTimer(m_cost_model == compute_time);
+            }
+
+        //! Get the measure of the load of a rank
+        costModel getCostModel() const
+            {
+            return m_cost_model;
+            }
+
+        //! Set the integrator whose force computation time is measured
+        /*!
+         * \param integrator The integrator (may be null)
+         */
+        void setIntegrator(std::shared_ptr<Integrator> integrator)
+            {
+            if (m_integrator && m_integrator != integrator)
+                m_integrator->enableComputeTimer(false);
+
+            m_integrator = integrator;
+            if (m_integrator)
+                {
+                m_integrator->enableComputeTimer(m_cost_model == compute_time);
+                m_integrator->resetComputeTime();
+                }
+            }
+
+        //! Set the damping of the domain rescaling
+        /*!
+         * \param damping Fraction of the proposed rescaling that is not applied (0 <= damping < 1)
+         */
+        void setDamping(Scalar damping)
+            {
+            if (damping < Scalar(0.0) || damping >= Scalar(1.0))
+                {
+                m_exec_conf->msg->error() << "comm.balance: damping must be in [0,1)" << std::endl;
+                throw std::runtime_error("Error setting load balancer damping");
+                }
+            m_damping = damping;
+            }
+
+        //! Get the damping of the domain rescaling
+        Scalar getDamping() const
+            {
+            return m_damping;
+            }
+
         //! Enable / disable load balancing along a dimension
         /*!
          * \param dim Dimension along which to balance
@@ -119,8 +188,20 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
         Scalar m_max_imbalance;             //!< Maximum imbalance
         bool m_recompute_max_imbalance;     //!< Flag if maximum imbalance needs to be computed
 
-        //! Reduce the particle numbers per rank down to one dimension
-        bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+        //! Reduce the loads per rank down to one dimension
+        bool reduce(std::vector<Scalar>& N_i, unsigned int dim, unsigned int reduce_root);
+
+        //! Get the time spent in the force computation on this rank since the last balancing step (in seconds)
+        virtual double getComputeTime();
+
+        //! Measure the cost per particle on this rank
+        void computeCostPerParticle();
+
+        //! Get the estimated load of this rank
+        Scalar getLoad()
+            {
+            return Scalar(getNOwn()) * m_cost_per_particle;
+            }
 
         //! Set flags within the class that a resize has been performed
         void signalResize()
@@ -132,7 +213,7 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
 
         //! Adjust the partitioning along a single dimension
         bool adjust(std::vector<Scalar>& cum_frac_i,
-                    const std::vector<unsigned int>& N_i,
+                    const std::vector<Scalar>& N_i,
                     Scalar L_i,
                     Scalar min_domain_frac);
         bool m_needs_migrate;   //!< Flag to signal that migration is necessary
@@ -170,6 +251,11 @@ class PYBIND11_EXPORT LoadBalancer : public Updater
 
         const Scalar m_max_scale;   //!< Maximum fraction to rescale either direction (5%)
 
+        costModel m_cost_model;                     //!< Measure of the load of a rank
+        std::shared_ptr<Integrator> m_integrator;   //!< Integrator whose force computation is timed
+        Scalar m_damping;                           //!< Fraction of the proposed rescaling that is not applied
+        Scalar m_cost_per_particle;                 //!< Load of one particle on this rank
+
     private:
         unsigned int m_N_own;               //!< Number of particles owned by this rank
 
@@ -108,12 +108,50 @@ void Logger::registerCallback(std::string name, pybind11::handle callback)
     m_callback_quantities[name] = callback.ptr();
     }
 
+/*! \param timer The call timer to register
+
+    After the timer is registered, its quantity is available for logging. Timers without a name are ignored.
+*/
+void Logger::registerCallTimer(std::shared_ptr<CallTimer> timer)
+    {
+    const std::string& name = timer->getName();
+    if (name.empty())
+        return;
+
+    // first check if this quantity is already set, printing a warning if so
+    if (   m_compute_quantities.count(name)
+        || m_updater_quantities.count(name)
+        || m_callback_quantities.count(name)
+        || m_timer_quantities.count(name)
+        )
+        m_exec_conf->msg->warning() << "analyze.log: The log quantity " << name <<
+             " has been registered more than once. Only the most recent registration takes effect" << endl;
+    m_timer_quantities[name] = timer;
+    m_exec_conf->msg->notice(6) << "analyze.log: Registering log quantity " << name << endl;
+
+    enableCallTimers();
+    }
+
+/*! Timers stay enabled when they are no longer logged, because other loggers may log them.
+*/
+void Logger::enableCallTimers()
+    {
+    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+        {
+        std::map< std::string, std::shared_ptr<CallTimer> >::iterator timer
+            = m_timer_quantities.find(m_logged_quantities[i]);
+        if (timer != m_timer_quantities.end())
+            timer->second->enable(true);
+        }
+    }
+
 /*! After calling removeAll(), no quantities are registered for logging
 */
 void Logger::removeAll()
     {
     m_compute_quantities.clear();
     m_updater_quantities.clear();
+    m_timer_quantities.clear();
     //The callbacks are intentionally not cleared, because before each
     //run all compute and updaters should be cleared, but the python
     //callbacks should not be cleared for this.
@@ -127,6 +165,7 @@ void Logger::removeAll()
 void Logger::setLoggedQuantities(const std::vector< std::string >& quantities)
     {
     m_logged_quantities = quantities;
+    enableCallTimers();
 
     // prepare or adjust storage for caching the logger properties.
     m_cached_timestep = -1;
@@ -188,6 +227,11 @@ Scalar Logger::getValue(const std::string &quantity, int timestep)
         {
         return Scalar(double(m_clk.getTime())/1e9);
         }
+    // check to see if the quantity is a call timer, it must not trigger the compute
+    else if (m_timer_quantities.count(quantity))
+        {
+        return Scalar(m_timer_quantities[quantity]->getTimePerCall(timestep));
+        }
     // check to see if the quantity exists in the compute list
     else if (m_compute_quantities.count(quantity))
         {
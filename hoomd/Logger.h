@@ -32,6 +32,10 @@
     all quantities that the compute/updater provides (a list of strings). And getLogValue takes a string
     as an argument and returns a scalar.
 
+    Call timers (see CallTimer) provide the wall time per call of computes, updaters, analyzers, and the
+    communicator. They are registered separately, because their quantities are common to all of these classes. A
+    timer is enabled when its quantity is logged.
+
     Any number of computes and updaters can be registered with the
     Logger. It will track which quantities are provided. If any
     particular quantity is registered twice, a warning is printed and
@@ -63,6 +67,9 @@ class __attribute__((visibility("default"))) Logger : public Analyzer
         //! Register a callback
         virtual void registerCallback(std::string name, pybind11::handle callback);
 
+        //! Registers a call timer
+        virtual void registerCallTimer(std::shared_ptr<CallTimer> timer);
+
         //! Clears all registered computes and updaters
         virtual void removeAll();
 
@@ -98,6 +105,8 @@ class __attribute__((visibility("default"))) Logger : public Analyzer
         std::map< std::string, std::shared_ptr<Updater> > m_updater_quantities;
         //! List of callbacks
         std::map< std::string, PyObject * > m_callback_quantities;
+        //! A map of call timers indexed by their log quantity
+        std::map< std::string, std::shared_ptr<CallTimer> > m_timer_quantities;
         //! List of quantities to log
         std::vector< std::string > m_logged_quantities;
         //! Clock for the time log quantity
@@ -110,6 +119,9 @@ class __attribute__((visibility("default"))) Logger : public Analyzer
     private:
         //! Helper function to get a value for a given quantity
         Scalar getValue(const std::string &quantity, int timestep);
+
+        //! Helper function to enable the call timers of the logged quantities
+        void enableCallTimers();
     };
 
 //! exports the Logger class to python
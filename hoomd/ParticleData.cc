@@ -757,6 +757,29 @@ void ParticleData::reallocate(unsigned int max_n)
     m_max_particle_num_signal.emit();
     }
 
+/*! \param mirror Mirror to prepare
+    \returns \a mirror, with streams of 4 rows of at least getMaxN() elements
+
+    The mirrors are only allocated when a class first asks for them, so simulations that do not use
+    SoAArrayHandle pay no memory cost. A newly allocated or grown mirror is marked as not filled.
+*/
+SoAMirror& ParticleData::getSoAMirror(SoAMirror& mirror) const
+    {
+    if (mirror.streams.isNull())
+        {
+        GlobalArray< Scalar > streams(m_max_nparticles, 4, m_exec_conf);
+        mirror.streams.swap(streams);
+        TAG_ALLOCATION(mirror.streams);
+        mirror.source = NULL;
+        }
+    else if (mirror.streams.getPitch() < m_max_nparticles)
+        {
+        mirror.streams.resize(m_max_nparticles, 4);
+        mirror.source = NULL;
+        }
+    return mirror;
+    }
+
 /*! Rebuild the cached vector of active tags, if necessary
 */
 void ParticleData::maybe_rebuild_tag_cache()
@@ -817,6 +840,41 @@ bool ParticleData::inBox(const SnapshotParticleData<Real> &snap)
     return in_box;
     }
 
+#ifdef ENABLE_MPI
+//! Pack a snapshot particle for placement in a domain
+/*! \param snapshot Snapshot holding the particle
+    \param idx Index of the particle in \a snapshot
+    \param pos Position of the particle, wrapped into the global box
+    \param img Image of the particle, wrapped into the global box
+    \param tag Global tag of the particle
+*/
+template <class Real>
+static pdata_element makeSnapshotElement(const SnapshotParticleData<Real>& snapshot,
+                                         unsigned int idx,
+                                         const Scalar3& pos,
+                                         const int3& img,
+                                         unsigned int tag)
+    {
+    pdata_element p;
+    memset(&p, 0, sizeof(pdata_element));
+    p.pos = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(snapshot.type[idx]));
+    p.vel = make_scalar4(snapshot.vel[idx].x,
+                         snapshot.vel[idx].y,
+                         snapshot.vel[idx].z,
+                         snapshot.mass[idx]);
+    p.accel = vec_to_scalar3(snapshot.accel[idx]);
+    p.charge = snapshot.charge[idx];
+    p.diameter = snapshot.diameter[idx];
+    p.image = img;
+    p.body = snapshot.body[idx];
+    p.orientation = quat_to_scalar4(snapshot.orientation[idx]);
+    p.angmom = quat_to_scalar4(snapshot.angmom[idx]);
+    p.inertia = vec_to_scalar3(snapshot.inertia[idx]);
+    p.tag = tag;
+    return p;
+    }
+#endif
+
 //! Initialize from a snapshot
 /*! \param snapshot the initial particle data
     \param ignore_bodies If True, ignore particles that have a body flag set
@@ -854,144 +912,16 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
 #ifdef ENABLE_MPI
     if (m_decomposition)
         {
-        // gather box information from all processors
         unsigned int root = 0;
-
-        // Define per-processor particle data
-        std::vector< std::vector<Scalar3> > pos_proc;              // Position array of every processor
-        std::vector< std::vector<Scalar3> > vel_proc;              // Velocities array of every processor
-        std::vector< std::vector<Scalar3> > accel_proc;            // Accelerations array of every processor
-        std::vector< std::vector<unsigned int> > type_proc;        // Particle types array of every processor
-        std::vector< std::vector<Scalar > > mass_proc;             // Particle masses array of every processor
-        std::vector< std::vector<Scalar > > charge_proc;           // Particle charges array of every processor
-        std::vector< std::vector<Scalar > > diameter_proc;         // Particle diameters array of every processor
-        std::vector< std::vector<int3 > > image_proc;              // Particle images array of every processor
-        std::vector< std::vector<unsigned int > > body_proc;       // Body ids of every processor
-        std::vector< std::vector<Scalar4> > orientation_proc;      // Orientations of every processor
-        std::vector< std::vector<Scalar4> > angmom_proc;           // Angular momenta of every processor
-        std::vector< std::vector<Scalar3> > inertia_proc;           // Angular momenta of every processor
-        std::vector< std::vector<unsigned int > > tag_proc;         // Global tags of every processor
-        std::vector< unsigned int > N_proc;                        // Number of particles on every processor
-
-
-        // resize to number of ranks in communicator
         const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
-        unsigned int size = m_exec_conf->getNRanks();
+        unsigned int n_ranks = m_exec_conf->getNRanks();
         unsigned int my_rank = m_exec_conf->getRank();
 
-        pos_proc.resize(size);
-        vel_proc.resize(size);
-        accel_proc.resize(size);
-        type_proc.resize(size);
-        mass_proc.resize(size);
-        charge_proc.resize(size);
-        diameter_proc.resize(size);
-        image_proc.resize(size);
-        body_proc.resize(size);
-        orientation_proc.resize(size);
-        angmom_proc.resize(size);
-        inertia_proc.resize(size);
-        tag_proc.resize(size);
-        N_proc.resize(size,0);
-
-        if (my_rank == 0)
+        // check the input for errors
+        if (my_rank == root && snapshot.type_mapping.size() == 0)
             {
-            ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
-
-            // check the input for errors
-            if (snapshot.type_mapping.size() == 0)
-                {
-                m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
-                throw std::runtime_error("Error initializing ParticleData");
-                }
-
-            const Index3D& di = m_decomposition->getDomainIndexer();
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-
-            BoxDim global_box = m_global_box;
-
-            // loop over particles in snapshot, place them into domains
-            for (typename std::vector< vec3<Real> >::const_iterator it=snapshot.pos.begin(); it != snapshot.pos.end(); it++)
-                {
-                unsigned int snap_idx = it - snapshot.pos.begin();
-
-                // if requested, do not initialize constituent particles of bodies
-                if (ignore_bodies && snapshot.body[snap_idx] < MIN_FLOPPY)
-                    {
-                    continue;
-                    }
-
-                // determine domain the particle is placed into
-                Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box.makeFraction(pos);
-                int i= f.x * ((Scalar)di.getW());
-                int j= f.y * ((Scalar)di.getH());
-                int k= f.z * ((Scalar)di.getD());
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0,0,0);
-                if (i == (int) di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int) di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int) di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
-                int3 img = snapshot.image[snap_idx];
-
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, h_cart_ranks.data);
-
-                if (rank >= n_ranks)
-                    {
-                    m_exec_conf->msg->error() << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
-                    m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box.getLo();
-                    Scalar3 hi = m_global_box.getHi();
-                    m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
-                    m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
-
-                    throw std::runtime_error("Error initializing from snapshot.");
-                    }
-
-                // fill up per-processor data structures
-                pos_proc[rank].push_back(pos);
-                image_proc[rank].push_back(img);
-                vel_proc[rank].push_back(vec_to_scalar3(snapshot.vel[snap_idx]));
-                accel_proc[rank].push_back(vec_to_scalar3(snapshot.accel[snap_idx]));
-                type_proc[rank].push_back(snapshot.type[snap_idx]);
-                mass_proc[rank].push_back(snapshot.mass[snap_idx]);
-                charge_proc[rank].push_back(snapshot.charge[snap_idx]);
-                diameter_proc[rank].push_back(snapshot.diameter[snap_idx]);
-                body_proc[rank].push_back(snapshot.body[snap_idx]);
-                orientation_proc[rank].push_back(quat_to_scalar4(snapshot.orientation[snap_idx]));
-                angmom_proc[rank].push_back(quat_to_scalar4(snapshot.angmom[snap_idx]));
-                inertia_proc[rank].push_back(vec_to_scalar3(snapshot.inertia[snap_idx]));
-                tag_proc[rank].push_back(nglobal++);
-                N_proc[rank]++;
-                }
-
+            m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+            throw std::runtime_error("Error initializing ParticleData");
             }
 
         // get type mapping
@@ -1005,100 +935,84 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         // broadcast type mapping
         bcast(m_type_mapping, root, mpi_comm);
 
-        // broadcast global number of particles
-        bcast(nglobal, root, mpi_comm);
-
-        // resize array for reverse-lookup tags
-        m_rtag.resize(nglobal);
-
-        // Local particle data
-        std::vector<Scalar3> pos;
-        std::vector<Scalar3> vel;
-        std::vector<Scalar3> accel;
-        std::vector<unsigned int> type;
-        std::vector<Scalar> mass;
-        std::vector<Scalar> charge;
-        std::vector<Scalar> diameter;
-        std::vector<int3> image;
-        std::vector<unsigned int> body;
-        std::vector<Scalar4> orientation;
-        std::vector<Scalar4> angmom;
-        std::vector<Scalar3> inertia;
-        std::vector<unsigned int> tag;
-
-        // distribute particle data
-        scatter_v(pos_proc,pos,root, mpi_comm);
-        scatter_v(vel_proc,vel,root, mpi_comm);
-        scatter_v(accel_proc, accel, root, mpi_comm);
-        scatter_v(type_proc, type, root, mpi_comm);
-        scatter_v(mass_proc, mass, root, mpi_comm);
-        scatter_v(charge_proc, charge, root, mpi_comm);
-        scatter_v(diameter_proc, diameter, root, mpi_comm);
-        scatter_v(image_proc, image, root, mpi_comm);
-        scatter_v(body_proc, body, root, mpi_comm);
-        scatter_v(orientation_proc, orientation, root, mpi_comm);
-        scatter_v(angmom_proc, angmom, root, mpi_comm);
-        scatter_v(inertia_proc, inertia, root, mpi_comm);
-        scatter_v(tag_proc, tag, root, mpi_comm);
-
-        // distribute number of particles
-        scatter_v(N_proc, m_nparticles, root, mpi_comm);
+        unsigned int snap_size = snapshot.size;
+        MPI_Bcast(&snap_size, 1, MPI_UNSIGNED, root, mpi_comm);
 
+        // stream the particles to their domains in chunks, so that no rank holds more than one chunk of particles
+        // besides the snapshot and its local particles
+        std::vector<pdata_element> local;
+        std::vector< std::vector<pdata_element> > send_proc(n_ranks);
+        std::vector<pdata_element> send_buf;
+        std::vector<int> send_counts(n_ranks, 0);
+        std::vector<int> displs(n_ranks, 0);
 
+        for (unsigned int start = 0; start < snap_size; start += MPI_SNAPSHOT_CHUNK_SIZE)
             {
-            // reset all reverse lookup tags to NOT_LOCAL flag
-            ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+            unsigned int end = std::min(start + MPI_SNAPSHOT_CHUNK_SIZE, snap_size);
 
-            // we have to reset all previous rtags, to remove 'leftover' ghosts
-            unsigned int max_tag = m_rtag.size();
-            for (unsigned int tag = 0; tag < max_tag; tag++)
-                h_rtag.data[tag] = NOT_LOCAL;
-            }
+            if (my_rank == root)
+                {
+                ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
 
-        // update list of active tags
-        for (unsigned int tag = 0; tag < nglobal; tag++)
-            {
-            m_tag_set.insert(tag);
-            }
+                for (unsigned int rank = 0; rank < n_ranks; rank++)
+                    send_proc[rank].clear();
 
-        // Now that active tag list has changed, invalidate the cache
-        m_invalid_cached_tags = true;
+                // place the particles of this chunk into domains
+                for (unsigned int snap_idx = start; snap_idx < end; snap_idx++)
+                    {
+                    // if requested, do not initialize constituent particles of bodies
+                    if (ignore_bodies && snapshot.body[snap_idx] < MIN_FLOPPY)
+                        {
+                        continue;
+                        }
+
+                    // determine domain the particle is placed into
+                    Scalar3 pos = vec_to_scalar3(snapshot.pos[snap_idx]);
+                    int3 img = snapshot.image[snap_idx];
+                    unsigned int rank = m_decomposition->placeSnapshotParticle(m_global_box, pos, img, h_cart_ranks.data);
+
+                    if (rank >= n_ranks)
+                        {
+                        Scalar3 f = m_global_box.makeFraction(pos);
+                        m_exec_conf->msg->error() << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
+                        m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
+                        m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
+                        m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
+                        m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
+                        Scalar3 lo = m_global_box.getLo();
+                        Scalar3 hi = m_global_box.getHi();
+                        m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
+                        m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
+
+                        throw std::runtime_error("Error initializing from snapshot.");
+                        }
+
+                    send_proc[rank].push_back(makeSnapshotElement(snapshot, snap_idx, pos, img, nglobal++));
+                    }
 
-        // resize particle data
-        resize(m_nparticles);
+                // pack the chunk in rank order
+                send_buf.clear();
+                for (unsigned int rank = 0; rank < n_ranks; rank++)
+                    {
+                    displs[rank] = send_buf.size()*sizeof(pdata_element);
+                    send_counts[rank] = send_proc[rank].size()*sizeof(pdata_element);
+                    send_buf.insert(send_buf.end(), send_proc[rank].begin(), send_proc[rank].end());
+                    }
+                }
 
-        // Load particle data
-        ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
-        ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
-        ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
-        ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
-        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
-        ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
-        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+            int recv_count = 0;
+            MPI_Scatter(send_counts.data(), 1, MPI_INT, &recv_count, 1, MPI_INT, root, mpi_comm);
 
-        for (unsigned int idx = 0; idx < m_nparticles; idx++)
-            {
-            h_pos.data[idx] = make_scalar4(pos[idx].x,pos[idx].y, pos[idx].z, __int_as_scalar(type[idx]));
-            h_vel.data[idx] = make_scalar4(vel[idx].x, vel[idx].y, vel[idx].z, mass[idx]);
-            h_accel.data[idx] = accel[idx];
-            h_charge.data[idx] = charge[idx];
-            h_diameter.data[idx] = diameter[idx];
-            h_image.data[idx] = image[idx];
-            h_tag.data[idx] = tag[idx];
-            h_rtag.data[tag[idx]] = idx;
-            h_body.data[idx] = body[idx];
-            h_orientation.data[idx] = orientation[idx];
-            h_angmom.data[idx] = angmom[idx];
-            h_inertia.data[idx] = inertia[idx];
-
-            h_comm_flag.data[idx] = 0; // initialize with zero
+            unsigned int offset = local.size();
+            local.resize(offset + recv_count/sizeof(pdata_element));
+            MPI_Scatterv(send_buf.data(), send_counts.data(), displs.data(), MPI_BYTE,
+                         local.data() + offset, recv_count, MPI_BYTE, root, mpi_comm);
             }
+
+        // broadcast global number of particles
+        bcast(nglobal, root, mpi_comm);
+
+        setLocalParticles(local, nglobal);
         }
     else
 #endif
@@ -1193,6 +1107,153 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     m_num_types_signal.emit();
     }
 
+#ifdef ENABLE_MPI
+//! Initialize from the local part of a snapshot
+/*! \param snapshot Particles owned by this rank, in any order
+    \param tags Global tags of the particles in \a snapshot
+    \param nglobal Global number of particles
+
+    \post the particle data arrays are initialized from the snapshot
+
+    Every rank passes the particles in its domain, so no particle data is communicated. The type mapping must be set
+    in \a snapshot on all ranks. The tags on all ranks together must be exactly 0 to nglobal-1.
+
+    \pre The domain decomposition and global box are set.
+ */
+template <class Real>
+void ParticleData::initializeFromLocalSnapshot(const SnapshotParticleData<Real>& snapshot,
+                                               const std::vector<unsigned int>& tags,
+                                               unsigned int nglobal)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from local snapshot" << std::endl;
+
+    assert(m_decomposition);
+    assert(tags.size() == snapshot.size);
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    if (snapshot.type_mapping.size() == 0)
+        {
+        m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    // check that all particles are accounted for
+    unsigned int ntotal = snapshot.size;
+    MPI_Allreduce(MPI_IN_PLACE, &ntotal, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+    if (ntotal != nglobal)
+        {
+        m_exec_conf->msg->error() << "init.*: " << ntotal << " particles placed in the domains, expected "
+                                  << nglobal << std::endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    // clear set of active tags
+    m_tag_set.clear();
+
+    // clear reservoir of recycled tags
+    while (! m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    m_type_mapping = snapshot.type_mapping;
+
+    std::vector<pdata_element> local(snapshot.size);
+    for (unsigned int idx = 0; idx < snapshot.size; idx++)
+        local[idx] = makeSnapshotElement(snapshot, idx, vec_to_scalar3(snapshot.pos[idx]), snapshot.image[idx],
+                                         tags[idx]);
+
+    setLocalParticles(local, nglobal);
+
+    m_accel_set = false;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+    }
+#endif
+
+#ifdef ENABLE_MPI
+/*! \param local Particles placed in the local domain
+    \param nglobal Global number of particles
+
+    Resets the tags and reverse lookup tags and fills the particle data arrays with \a local, in order. Shared by
+    initializeFromSnapshot() and initializeFromLocalSnapshot().
+*/
+void ParticleData::setLocalParticles(const std::vector<pdata_element>& local, unsigned int nglobal)
+    {
+    m_nparticles = local.size();
+
+    // resize array for reverse-lookup tags
+    m_rtag.resize(nglobal);
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+
+        // we have to reset all previous rtags, to remove 'leftover' ghosts
+        unsigned int max_tag = m_rtag.size();
+        for (unsigned int tag = 0; tag < max_tag; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    // update list of active tags
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(tag);
+        }
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    // resize particle data
+    resize(m_nparticles);
+
+    // Load particle data
+    ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+    ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+    ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar4 > h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar3 > h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+    ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
+    ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+    ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+    for (unsigned int idx = 0; idx < m_nparticles; idx++)
+        {
+        const pdata_element& p = local[idx];
+        h_pos.data[idx] = p.pos;
+        h_vel.data[idx] = p.vel;
+        h_accel.data[idx] = p.accel;
+        h_charge.data[idx] = p.charge;
+        h_diameter.data[idx] = p.diameter;
+        h_image.data[idx] = p.image;
+        h_tag.data[idx] = p.tag;
+        h_rtag.data[p.tag] = idx;
+        h_body.data[idx] = p.body;
+        h_orientation.data[idx] = p.orientation;
+        h_angmom.data[idx] = p.angmom;
+        h_inertia.data[idx] = p.inertia;
+
+        h_comm_flag.data[idx] = 0; // initialize with zero
+        }
+    }
+#endif
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -2490,6 +2551,10 @@ template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                            std::shared_ptr<DomainDecomposition> decomposition
                                           );
 template void ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float> & snapshot, bool ignore_bodies);
+#ifdef ENABLE_MPI
+template void ParticleData::initializeFromLocalSnapshot<float>(const SnapshotParticleData<float> & snapshot,
+    const std::vector<unsigned int>& tags, unsigned int nglobal);
+#endif
 template std::map<unsigned int, unsigned int> ParticleData::takeSnapshot<float>(SnapshotParticleData<float> &snapshot);
 
 
@@ -19,6 +19,7 @@
 #include "GlobalArray.h"
 #include "GPUVector.h"
 #include "GlobalArray.h"
+#include "SoAArrayHandle.h"
 
 #ifdef ENABLE_CUDA
 #include "ParticleData.cuh"
@@ -798,6 +799,15 @@ class PYBIND11_EXPORT ParticleData
         //! Get the net torque array
         const GlobalArray< Scalar4 >& getNetTorqueArray() const { return m_net_torque; }
 
+        //! Get the structure-of-arrays mirror of the positions (see SoAArrayHandle)
+        SoAMirror& getPositionsSoA() const { return getSoAMirror(m_pos_soa); }
+
+        //! Get the structure-of-arrays mirror of the velocities (see SoAArrayHandle)
+        SoAMirror& getVelocitiesSoA() const { return getSoAMirror(m_vel_soa); }
+
+        //! Get the structure-of-arrays mirror of the net force (see SoAArrayHandle)
+        SoAMirror& getNetForceSoA() const { return getSoAMirror(m_net_force_soa); }
+
         //! Get the orientation array
         const GlobalArray< Scalar4 >& getOrientationArray() const { return m_orientation; }
 
@@ -977,6 +987,14 @@ class PYBIND11_EXPORT ParticleData
         template <class Real>
         void initializeFromSnapshot(const SnapshotParticleData<Real> & snapshot, bool ignore_bodies=false);
 
+        #ifdef ENABLE_MPI
+        //! Initialize from the particles of a snapshot that are owned by this rank
+        template <class Real>
+        void initializeFromLocalSnapshot(const SnapshotParticleData<Real> & snapshot,
+                                         const std::vector<unsigned int>& tags,
+                                         unsigned int nglobal);
+        #endif
+
         //! Take a snapshot
         template <class Real>
         std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real> &snapshot);
@@ -1182,6 +1200,10 @@ class PYBIND11_EXPORT ParticleData
         GlobalArray< Scalar > m_net_virial;             //!< Net virial calculated for each particle (2D GPU array of dimensions 6*number of particles)
         GlobalArray< Scalar4 > m_net_torque;            //!< Net torque calculated for each particle
 
+        mutable SoAMirror m_pos_soa;                    //!< Structure-of-arrays mirror of the positions (allocated on first use)
+        mutable SoAMirror m_vel_soa;                    //!< Structure-of-arrays mirror of the velocities (allocated on first use)
+        mutable SoAMirror m_net_force_soa;              //!< Structure-of-arrays mirror of the net force (allocated on first use)
+
         Scalar m_external_virial[6];                 //!< External potential contribution to the virial
         Scalar m_external_energy;                    //!< External potential energy
         const float m_resize_factor;                 //!< The numerical factor with which the particle data arrays are resized
@@ -1211,9 +1233,17 @@ class PYBIND11_EXPORT ParticleData
         //! Helper function to reallocate particle data
         void reallocate(unsigned int max_n);
 
+        //! Helper function to allocate or grow a structure-of-arrays mirror to the current maximum particle number
+        SoAMirror& getSoAMirror(SoAMirror& mirror) const;
+
         //! Helper function to rebuild the active tag cache if necessary
         void maybe_rebuild_tag_cache();
 
+        #ifdef ENABLE_MPI
+        //! Helper function to fill the particle data with the particles placed in the local domain
+        void setLocalParticles(const std::vector<pdata_element>& local, unsigned int nglobal);
+        #endif
+
         //! Helper function to check that particles of a snapshot are in the box
         /*! \return true If and only if all particles are in the simulation box
          * \param Snapshot to check
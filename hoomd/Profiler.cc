@@ -10,8 +10,15 @@
 
 #include "Profiler.h"
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <chrono>
+#include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 
 
 using namespace std;
@@ -98,7 +105,11 @@ void ProfileDataElem::output(std::ostream &o, const std::string& name, int tab_l
         bytes = double(getTotalMemByteCount())/sec;
         }
 
-    output_line(o, name, sec, perc, flops, bytes, name_width);
+    double min_sec = m_min_elapsed_time >= 0 ? double(m_min_elapsed_time)/1e9 : -1.0;
+    double max_sec = m_max_elapsed_time >= 0 ? double(m_max_elapsed_time)/1e9 : -1.0;
+    // hardware counters include the children, so they are meaningful on every level
+    const int64_t *counters = m_counters[HardwareCounters::cycles] > 0 ? m_counters : NULL;
+    output_line(o, name, sec, perc, flops, bytes, name_width, min_sec, max_sec, counters);
 
     // start by determining the name width
     map<string, ProfileDataElem>::const_iterator i;
@@ -141,7 +152,10 @@ void ProfileDataElem::output_line(std::ostream &o,
                                   double perc,
                                   double flops,
                                   double bytes,
-                                  unsigned int name_width) const
+                                  unsigned int name_width,
+                                  double min_sec,
+                                  double max_sec,
+                                  const int64_t *counters) const
     {
     o << setiosflags(ios::fixed);
 
@@ -153,6 +167,12 @@ void ProfileDataElem::output_line(std::ostream &o,
     o << setw(7) << setprecision(4) << sec << "s";
     o << " | " << setprecision(3) << setw(6) << perc << "% ";
 
+    // range over the MPI ranks
+    if (min_sec >= 0 && max_sec >= 0)
+        {
+        o << "| " << setprecision(4) << setw(7) << min_sec << "s - " << setw(7) << max_sec << "s ";
+        }
+
     //If sec is zero, the values to be printed are garbage.  Thus, we skip it all together.
     if (sec == 0)
         {
@@ -185,13 +205,31 @@ void ProfileDataElem::output_line(std::ostream &o,
             o << bytes/1e9 << " GiB/s ";
         }
 
+    // measured instructions per cycle and memory traffic
+    if (counters)
+        {
+        double ipc = double(counters[HardwareCounters::instructions])/double(counters[HardwareCounters::cycles]);
+        double llc_bytes = double(counters[HardwareCounters::llc_misses]) * HardwareCounters::cache_line_size;
+        o << "| IPC " << setprecision(2) << setw(4) << ipc;
+        o << " LLC miss " << setprecision(4) << setw(7) << llc_bytes/sec/1e9 << " GB/s ";
+        }
+
     o << endl;
     }
 
 ////////////////////////////////////////////////////////////////////
 // Profiler
 
-Profiler::Profiler(const std::string& name) : m_name(name)
+Profiler::Profiler(const std::string& name) : Profiler(name, std::shared_ptr<const ExecutionConfiguration>())
+    {
+    }
+
+/*! \param name Name of the profile
+    \param exec_conf Execution configuration, used to merge the output of all MPI ranks
+*/
+Profiler::Profiler(const std::string& name, std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    : m_name(name), m_exec_conf(exec_conf), m_period(1), m_active(true), m_trace(false), m_step_start(0),
+      m_sampled_time(0), m_n_sampled(0), m_n_trace_steps(0)
     {
     // push the root onto the top of the stack so that it is the default
     m_stack.push(&m_root);
@@ -199,11 +237,289 @@ Profiler::Profiler(const std::string& name) : m_name(name)
     // record the start of this profile
     m_root.m_start_time = m_clk.getTime();
 
+    // trace timestamps are given in wall clock time so that the timelines of the ranks line up
+    int64_t now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    m_epoch_us = now_us - m_root.m_start_time/1000;
+
+    // the constructing thread is the main thread
+    m_thread_ids[std::this_thread::get_id()] = 0;
+
     #ifdef SCOREP_USER_ENABLE
     SCOREP_USER_REGION_BEGIN(m_root.m_scorep_region, name.c_str(),SCOREP_USER_REGION_TYPE_COMMON )
     #endif
     }
 
+/*! Hardware counters are read in every push() and pop() of the main thread, which must be the thread that
+    constructed the profiler.
+
+    The counters only count events of the main thread. With more than one thread, the work done by the other
+    threads would be missing from the IPC and memory traffic of a region, so the counters are not enabled.
+
+    \returns false (after printing a warning) if the counters are not available
+*/
+bool Profiler::enableHardwareCounters()
+    {
+    assert(m_stack.top() == &m_root);
+
+    if (m_exec_conf && m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->msg->warning() << "Hardware counters only measure the main thread, they are disabled with "
+                                    << m_exec_conf->getNumThreads() << " threads" << endl;
+        return false;
+        }
+
+    m_counters.reset(new HardwareCounters());
+    if (!m_counters->isAvailable())
+        {
+        if (m_exec_conf)
+            m_exec_conf->msg->warning() << "Hardware counters are not available, "
+                                        << m_counters->getError() << endl;
+        m_counters.reset();
+        return false;
+        }
+
+    m_counters->read(m_root.m_counter_start);
+    return true;
+    }
+
+/*! \param timestep Time step that is about to be taken
+
+    Steps with \a timestep a multiple of the sample period are sampled.
+*/
+void Profiler::beginStep(unsigned int timestep)
+    {
+    assert(m_stack.top() == &m_root);
+
+    m_active = (timestep % m_period == 0);
+    if (m_active)
+        {
+        m_step_start = m_clk.getTime();
+
+        // when only some steps are sampled, the root counters total the sampled steps
+        if (m_counters && m_period > 1)
+            m_counters->read(m_root.m_counter_start);
+        }
+    }
+
+void Profiler::endStep()
+    {
+    assert(m_stack.top() == &m_root);
+
+    if (m_active)
+        {
+        int64_t t = m_clk.getTime();
+        m_sampled_time += t - m_step_start;
+        m_n_sampled++;
+
+        if (m_counters && m_period > 1)
+            {
+            int64_t counters[HardwareCounters::num_counters];
+            m_counters->read(counters);
+            for (unsigned int i = 0; i < HardwareCounters::num_counters; i++)
+                m_root.m_counters[i] += counters[i] - m_root.m_counter_start[i];
+            }
+
+        if (m_trace)
+            {
+            traceEvent("Step", m_step_start, t);
+            m_n_trace_steps++;
+            }
+        }
+
+    // work outside of steps is only timed when every step is
+    m_active = (m_period == 1);
+    }
+
+/*! \param name Name of the region
+    \param start_time Start of the region, measured by getTime()
+    \param end_time End of the region, measured by getTime()
+
+    This method may be called from any thread. Each thread is shown as a separate track in the trace.
+*/
+void Profiler::traceEvent(const std::string& name, int64_t start_time, int64_t end_time)
+    {
+    if (!m_trace)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_trace_mutex);
+
+    std::map<std::thread::id, unsigned int>::iterator it = m_thread_ids.find(std::this_thread::get_id());
+    if (it == m_thread_ids.end())
+        {
+        unsigned int tid = (unsigned int)m_thread_ids.size();
+        it = m_thread_ids.insert(std::make_pair(std::this_thread::get_id(), tid)).first;
+        }
+
+    TraceEvent event = {name, start_time, end_time - start_time, it->second};
+    m_events.push_back(event);
+    }
+
+//! Escape a string for output in JSON
+static string json_escape(const std::string& s)
+    {
+    string out;
+    for (char c : s)
+        {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+        }
+    return out;
+    }
+
+/*! \param fname File name of the trace
+
+    The events of all ranks are gathered and appended to \a fname by the root rank, with the MPI rank as process id.
+    The file is a JSON array of Chrome trace events. The closing bracket is optional in this format, so that
+    subsequent runs can append to the same file.
+
+    In MPI runs, writeTrace() must be called on all ranks. It is called at the end of a run, and every
+    trace_flush_steps sampled steps during the run (see isTraceFlushDue()), so that at most that many steps of
+    events are held in memory.
+*/
+void Profiler::writeTrace(const std::string& fname)
+    {
+    unsigned int rank = 0;
+    if (m_exec_conf)
+        rank = m_exec_conf->getRank();
+
+    ostringstream s;
+    s << setiosflags(ios::fixed) << setprecision(3);
+        {
+        std::lock_guard<std::mutex> lock(m_trace_mutex);
+
+        s << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+          << ",\"args\":{\"name\":\"rank " << rank << "\"}}," << endl;
+        for (auto thread : m_thread_ids)
+            {
+            s << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank << ",\"tid\":" << thread.second
+              << ",\"args\":{\"name\":\"" << (thread.second == 0 ? string("main") : "thread " + to_string(thread.second))
+              << "\"}}," << endl;
+            }
+
+        for (const TraceEvent& event : m_events)
+            {
+            s << "{\"name\":\"" << json_escape(event.name) << "\",\"ph\":\"X\",\"ts\":"
+              << double(m_epoch_us) + double(event.start)/1e3 << ",\"dur\":" << double(event.duration)/1e3
+              << ",\"pid\":" << rank << ",\"tid\":" << event.tid << "}," << endl;
+            }
+        m_events.clear();
+        m_n_trace_steps = 0;
+        }
+
+    std::vector<std::string> traces(1, s.str());
+    #ifdef ENABLE_MPI
+    if (m_exec_conf && m_exec_conf->getNRanks() > 1)
+        gather_v(traces[0], traces, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (rank != 0)
+        return;
+
+    // open the array when the file is new
+    bool empty;
+        {
+        ifstream in(fname.c_str(), ios::in | ios::binary | ios::ate);
+        empty = !in.good() || in.tellg() <= 0;
+        }
+
+    ofstream f(fname.c_str(), ios::out | ios::app);
+    if (!f.good())
+        {
+        if (m_exec_conf)
+            m_exec_conf->msg->error() << "Unable to open trace file " << fname << endl;
+        throw runtime_error("Error writing trace");
+        }
+
+    if (empty)
+        f << "[" << endl;
+    for (const std::string& trace : traces)
+        f << trace;
+    }
+
+//! Flatten a profile tree into a map from the path of each node to its counters
+static void flatten_profile(const ProfileDataElem& elem,
+                            std::vector<std::string>& path,
+                            std::map< std::vector<std::string>, std::vector<int64_t> >& out)
+    {
+    std::vector<int64_t> counters(3 + HardwareCounters::num_counters);
+    counters[0] = elem.m_elapsed_time;
+    counters[1] = elem.m_flop_count;
+    counters[2] = elem.m_mem_byte_count;
+    for (unsigned int i = 0; i < HardwareCounters::num_counters; i++)
+        counters[3+i] = elem.m_counters[i];
+    out[path] = counters;
+
+    for (auto child = elem.m_children.begin(); child != elem.m_children.end(); ++child)
+        {
+        path.push_back(child->first);
+        flatten_profile(child->second, path, out);
+        path.pop_back();
+        }
+    }
+
+/*! \param merged Output: the merged profile (only set on the root rank)
+
+    Each node in the merged tree holds the elapsed time averaged over all ranks, with the minimum and maximum, and
+    the flop, byte, and hardware counts summed over all ranks. A rank that never entered a node counts as zero time.
+*/
+void Profiler::mergeRanks(ProfileDataElem& merged)
+    {
+    #ifdef ENABLE_MPI
+    typedef std::map< std::vector<std::string>, std::vector<int64_t> > flat_profile;
+
+    flat_profile local;
+    std::vector<std::string> path;
+    flatten_profile(m_root, path, local);
+
+    std::vector<flat_profile> all;
+    gather_v(local, all, 0, m_exec_conf->getMPICommunicator());
+
+    if (m_exec_conf->getRank() != 0)
+        return;
+
+    // collect the elapsed times of every node on every rank
+    unsigned int nranks = (unsigned int)all.size();
+    std::map< std::vector<std::string>, std::vector<int64_t> > elapsed;
+    for (unsigned int rank = 0; rank < nranks; rank++)
+        {
+        for (auto node = all[rank].begin(); node != all[rank].end(); ++node)
+            {
+            std::vector<int64_t>& times = elapsed[node->first];
+            times.resize(nranks, 0);
+            times[rank] = node->second[0];
+
+            ProfileDataElem *elem = &merged;
+            for (const std::string& name : node->first)
+                elem = &elem->m_children[name];
+            elem->m_flop_count += node->second[1];
+            elem->m_mem_byte_count += node->second[2];
+            for (unsigned int i = 0; i < HardwareCounters::num_counters; i++)
+                elem->m_counters[i] += node->second[3+i];
+            }
+        }
+
+    for (auto node = elapsed.begin(); node != elapsed.end(); ++node)
+        {
+        ProfileDataElem *elem = &merged;
+        for (const std::string& name : node->first)
+            elem = &elem->m_children[name];
+
+        int64_t sum = 0;
+        elem->m_min_elapsed_time = node->second[0];
+        elem->m_max_elapsed_time = node->second[0];
+        for (int64_t t : node->second)
+            {
+            sum += t;
+            elem->m_min_elapsed_time = std::min(elem->m_min_elapsed_time, t);
+            elem->m_max_elapsed_time = std::max(elem->m_max_elapsed_time, t);
+            }
+        elem->m_elapsed_time = sum / nranks;
+        }
+    #endif
+    }
+
 void Profiler::output(std::ostream &o)
     {
     // perform a sanity check, but don't bail out
@@ -217,7 +533,37 @@ void Profiler::output(std::ostream &o)
     #endif
 
     // outputting a profile implicitly calls for a time sample
-    m_root.m_elapsed_time = m_clk.getTime() - m_root.m_start_time;
+    // when only some steps are sampled, the total is the time spent in those steps
+    if (m_period > 1)
+        {
+        m_root.m_elapsed_time = m_sampled_time;
+        o << "Sampled " << m_n_sampled << " steps (every " << m_period << " steps)" << endl;
+        }
+    else
+        m_root.m_elapsed_time = m_clk.getTime() - m_root.m_start_time;
+
+    if (m_counters && m_period == 1)
+        {
+        int64_t counters[HardwareCounters::num_counters];
+        m_counters->read(counters);
+        for (unsigned int i = 0; i < HardwareCounters::num_counters; i++)
+            m_root.m_counters[i] = counters[i] - m_root.m_counter_start[i];
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_exec_conf && m_exec_conf->getNRanks() > 1)
+        {
+        ProfileDataElem merged;
+        mergeRanks(merged);
+
+        if (m_exec_conf->getRank() == 0)
+            {
+            o << "Average over " << m_exec_conf->getNRanks() << " ranks (min - max)" << endl;
+            merged.output(o, m_name, 0, merged.m_elapsed_time, (int)m_name.size());
+            }
+        return;
+        }
+    #endif
 
     // startup the recursive output process
     m_root.output(o, m_name, 0, m_root.m_elapsed_time, (int)m_name.size());
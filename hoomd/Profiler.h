@@ -14,6 +14,7 @@
 
 #include "ExecutionConfiguration.h"
 #include "ClockSource.h"
+#include "HardwareCounters.h"
 
 #ifdef ENABLE_CUDA
 #include <cuda_runtime.h>
@@ -26,8 +27,12 @@
 #include <string>
 #include <stack>
 #include <map>
+#include <vector>
 #include <iostream>
 #include <cassert>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 
@@ -63,11 +68,15 @@ class PYBIND11_EXPORT ProfileDataElem
     {
     public:
         //! Constructs an element with zeroed counters
-        ProfileDataElem() : m_start_time(0), m_elapsed_time(0), m_flop_count(0), m_mem_byte_count(0)
+        ProfileDataElem() : m_start_time(0), m_elapsed_time(0), m_flop_count(0), m_mem_byte_count(0),
+                            m_min_elapsed_time(-1), m_max_elapsed_time(-1)
             #ifdef SCOREP_USER_ENABLE
             , m_scorep_region(SCOREP_USER_INVALID_REGION)
             #endif
-            {}
+            {
+            for (unsigned int i = 0; i < HardwareCounters::num_counters; i++)
+                m_counter_start[i] = m_counters[i] = 0;
+            }
 
         //! Returns the total elapsed time of this nodes children
         int64_t getChildElapsedTime() const;
@@ -85,7 +94,10 @@ class PYBIND11_EXPORT ProfileDataElem
                          double perc,
                          double flops,
                          double bytes,
-                         unsigned int name_width) const;
+                         unsigned int name_width,
+                         double min_sec = -1.0,
+                         double max_sec = -1.0,
+                         const int64_t *counters = NULL) const;
 
         std::map<std::string, ProfileDataElem> m_children; //!< Child nodes of this profile
 
@@ -94,6 +106,12 @@ class PYBIND11_EXPORT ProfileDataElem
         int64_t m_flop_count;   //!< A running total of floating point operations
         int64_t m_mem_byte_count;   //!< A running total of memory bytes transferred
 
+        int64_t m_min_elapsed_time; //!< Minimum elapsed time over all ranks (-1 if not aggregated)
+        int64_t m_max_elapsed_time; //!< Maximum elapsed time over all ranks (-1 if not aggregated)
+
+        int64_t m_counter_start[HardwareCounters::num_counters];  //!< Hardware counters at the most recent push
+        int64_t m_counters[HardwareCounters::num_counters];       //!< Running totals of the hardware counters
+
         #ifdef SCOREP_USER_ENABLE
         SCOREP_User_RegionHandle m_scorep_region;   //!< ScoreP region identifier
         #endif
@@ -117,7 +135,22 @@ class PYBIND11_EXPORT ProfileDataElem
     These methods automatically synchronize with the asynchronous GPU execution stream in order
     to provide accurate timing information.
 
-    These profiles can of course be output via normal ostream operators.
+    These profiles can of course be output via normal ostream operators. When the profiler is constructed with an
+    ExecutionConfiguration in an MPI run, output is collective: the trees of all ranks are merged and each node reports
+    the average elapsed time over the ranks along with the minimum and maximum.
+
+    To keep the overhead low in long runs, only every \a period-th step may be sampled (see setSamplePeriod()).
+    The caller brackets each step with beginStep() and endStep(), and push() and pop() return immediately during steps
+    that are not sampled.
+
+    When tracing is enabled, every timed region of a sampled step is also recorded as an event with its start and end
+    time, and writeTrace() appends the events of all ranks to a file in the Chrome trace event format, which can be
+    viewed with chrome://tracing or Perfetto. Threads other than the main thread add their own events with
+    traceEvent(). To bound the memory held by the events in long runs, the caller writes them out whenever
+    isTraceFlushDue() returns true, which happens every trace_flush_steps sampled steps on all ranks at once.
+
+    enableHardwareCounters() additionally measures cycles, instructions, and last level cache misses of the main
+    thread in every node, which show whether a region is bound by memory bandwidth or by computation.
     \ingroup utils
     */
 class PYBIND11_EXPORT Profiler
@@ -125,6 +158,9 @@ class PYBIND11_EXPORT Profiler
     public:
         //! Constructs an empty profiler and starts its timer ticking
         Profiler(const std::string& name = "Profile");
+
+        //! Constructs an empty profiler that aggregates its output over all MPI ranks
+        Profiler(const std::string& name, std::shared_ptr<const ExecutionConfiguration> exec_conf);
         //! Pushes a new sub-category into the current category
         void push(const std::string& name);
         //! Pops back up to the next super-category
@@ -135,15 +171,92 @@ class PYBIND11_EXPORT Profiler
         //! Pops back up to the next super-category & syncs the GPUs
         void pop(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint64_t flop_count = 0, uint64_t byte_count = 0);
 
+        //! Set the period (in time steps) between sampled steps
+        /*! Work outside of beginStep() and endStep() is only timed when every step is sampled.
+        */
+        void setSamplePeriod(unsigned int period)
+            {
+            m_period = period > 0 ? period : 1;
+            m_active = (m_period == 1);
+            }
+
+        //! Number of sampled steps after which the recorded trace events should be written out
+        static const unsigned int trace_flush_steps = 100;
+
+        //! Enable or disable the recording of trace events
+        void enableTrace(bool enable)
+            {
+            m_trace = enable;
+            }
+
+        //! Test if trace_flush_steps sampled steps have been recorded since the last writeTrace()
+        /*! The result is the same on all ranks, so it can be used to decide when to call writeTrace().
+        */
+        bool isTraceFlushDue() const
+            {
+            return m_trace && m_n_trace_steps >= trace_flush_steps;
+            }
+
+        //! Start a time step
+        void beginStep(unsigned int timestep);
+
+        //! End the current time step
+        void endStep();
+
+        //! Get the current time of the profiler clock
+        /*! Threads other than the main thread may use this to time regions they pass to traceEvent()
+        */
+        int64_t getTime() const
+            {
+            return m_clk.getTime();
+            }
+
+        //! Measure hardware performance counters in every node
+        bool enableHardwareCounters();
+
+        //! Record a trace event from any thread
+        void traceEvent(const std::string& name, int64_t start_time, int64_t end_time);
+
+        //! Append the recorded trace events of all ranks to a file and clear them
+        void writeTrace(const std::string& fname);
+
     private:
+        //! A timed region in the trace
+        struct TraceEvent
+            {
+            std::string name;   //!< Name of the region
+            int64_t start;      //!< Start time (ns, measured by m_clk)
+            int64_t duration;   //!< Duration (ns)
+            unsigned int tid;   //!< Index of the thread that recorded the event
+            };
+
         ClockSource m_clk;  //!< Clock to provide timing information
         std::string m_name; //!< The name of this profile
         ProfileDataElem m_root; //!< The root profile element
         std::stack<ProfileDataElem *> m_stack;  //!< A stack of data elements for the push/pop structure
+        std::stack<const std::string *> m_name_stack;   //!< Names of the elements on m_stack (for the trace)
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration (may be null)
+        std::unique_ptr<HardwareCounters> m_counters;   //!< Hardware performance counters (may be null)
+
+        unsigned int m_period;      //!< Period between sampled steps
+        bool m_active;              //!< True when push() and pop() record timings
+        bool m_trace;               //!< True when trace events are recorded
+        int64_t m_step_start;       //!< Start time of the current sampled step
+        int64_t m_sampled_time;     //!< Total time of all sampled steps
+        unsigned int m_n_sampled;   //!< Number of sampled steps
+        unsigned int m_n_trace_steps;   //!< Number of sampled steps recorded in m_events
+        int64_t m_epoch_us;         //!< Wall clock time (us since the epoch) when m_clk was started
+
+        std::vector<TraceEvent> m_events;   //!< Recorded trace events
+        std::map<std::thread::id, unsigned int> m_thread_ids; //!< Index of each thread that recorded events
+        std::mutex m_trace_mutex;           //!< Protects m_events and m_thread_ids
 
         //! Output helper function
         void output(std::ostream &o);
 
+        //! Merge the profiles of all ranks into \a merged
+        void mergeRanks(ProfileDataElem& merged);
+
         //! friend operator to enable stream output
         friend std::ostream& operator<<(std::ostream &o, Profiler& prof);
     };
@@ -162,6 +275,9 @@ PYBIND11_EXPORT std::ostream& operator<<(std::ostream &o, Profiler& prof);
 
 inline void Profiler::push(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& name)
     {
+    if (!m_active)
+        return;
+
 #if defined(ENABLE_CUDA) && !defined(ENABLE_NVTOOLS)
     // nvtools profiling disables synchronization so that async CPU/GPU overlap can be seen
     if(exec_conf->isCUDAEnabled())
@@ -175,6 +291,9 @@ inline void Profiler::push(std::shared_ptr<const ExecutionConfiguration> exec_co
 
 inline void Profiler::pop(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint64_t flop_count, uint64_t byte_count)
     {
+    if (!m_active)
+        return;
+
 #if defined(ENABLE_CUDA) && !defined(ENABLE_NVTOOLS)
     // nvtools profiling disables synchronization so that async CPU/GPU overlap can be seen
     if(exec_conf->isCUDAEnabled())
@@ -188,6 +307,10 @@ inline void Profiler::pop(std::shared_ptr<const ExecutionConfiguration> exec_con
 
 inline void Profiler::push(const std::string& name)
     {
+    // steps that are not sampled are not timed
+    if (!m_active)
+        return;
+
     // sanity checks
     assert(!m_stack.empty());
 
@@ -201,19 +324,28 @@ inline void Profiler::push(const std::string& name)
     ProfileDataElem *cur = m_stack.top();
 
     // then creating (or accessing) the named sample and setting the start time
-    cur->m_children[name].m_start_time = t;
+    std::map<std::string, ProfileDataElem>::iterator child = cur->m_children.find(name);
+    if (child == cur->m_children.end())
+        child = cur->m_children.insert(std::make_pair(name, ProfileDataElem())).first;
+    child->second.m_start_time = t;
+    if (m_counters)
+        m_counters->read(child->second.m_counter_start);
 
     // and updating the stack
-    m_stack.push(&cur->m_children[name]);
+    m_stack.push(&child->second);
+    m_name_stack.push(&child->first);
 
     #ifdef SCOREP_USER_ENABLE
     // log Score-P region
-    SCOREP_USER_REGION_BEGIN( cur->m_children[name].m_scorep_region, name.c_str(),SCOREP_USER_REGION_TYPE_COMMON )
+    SCOREP_USER_REGION_BEGIN( child->second.m_scorep_region, name.c_str(),SCOREP_USER_REGION_TYPE_COMMON )
     #endif
     }
 
 inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
     {
+    if (!m_active)
+        return;
+
     // sanity checks
     assert(!m_stack.empty());
     assert(!(m_stack.top() == &m_root));
@@ -232,12 +364,29 @@ inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
     #endif
     cur->m_elapsed_time += t - cur->m_start_time;
 
+    if (m_counters)
+        {
+        int64_t counters[HardwareCounters::num_counters];
+        m_counters->read(counters);
+        for (unsigned int i = 0; i < HardwareCounters::num_counters; i++)
+            cur->m_counters[i] += counters[i] - cur->m_counter_start[i];
+        }
+
     // and increasing the flop and mem counters
     cur->m_flop_count += flop_count;
     cur->m_mem_byte_count += byte_count;
 
+    // record the region in the trace
+    if (m_trace)
+        {
+        TraceEvent event = {*m_name_stack.top(), cur->m_start_time, t - cur->m_start_time, 0};
+        std::lock_guard<std::mutex> lock(m_trace_mutex);
+        m_events.push_back(event);
+        }
+
     // and finally popping the stack so that the next pop will access the correct element
     m_stack.pop();
+    m_name_stack.pop();
     }
 
 #endif
@@ -27,6 +27,8 @@ struct RNGIdentifier
     static const uint32_t HPMCMonoShuffle = 0xfa870af6;
     static const uint32_t HPMCMonoTrialMove = 0x754dea60;
     static const uint32_t HPMCMonoShift = 0xf4a3210e;
+    static const uint32_t HPMCMonoCheckerboard = 0x3c9e81d7;
+    static const uint32_t HPMCMonoCheckerboardSets = 0x8d52b06e;
     static const uint32_t UpdaterBoxMC= 0xf6a510ab;
     static const uint32_t UpdaterClusters =  0x09365bf5;
     static const uint32_t UpdaterClustersPairwise = 0x50060112;
@@ -0,0 +1,137 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file SoAArrayHandle.h
+    \brief Defines the SoAMirror and SoAArrayHandle classes
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __SOA_ARRAY_HANDLE_H__
+#define __SOA_ARRAY_HANDLE_H__
+
+#include "HOOMDMath.h"
+#include "GlobalArray.h"
+
+//! Structure-of-arrays copy of a Scalar4 per-particle array
+/*! The x, y, z, and w components are stored in the four rows of \a streams. The remaining members record which
+    contents of the packed array the streams were filled from, so that SoAArrayHandle only converts the data again
+    after the packed array has been written to, swapped (as in a particle sort), or resized (as in a migration).
+*/
+struct SoAMirror
+    {
+    //! Constructs an empty mirror
+    SoAMirror() : source(NULL), write_count(0), n(0) {}
+
+    GlobalArray<Scalar> streams;    //!< x, y, z, and w streams in rows 0 to 3
+    const Scalar4 *source;          //!< Host pointer to the packed array the streams were filled from (NULL if none)
+    unsigned int write_count;       //!< GPUArrayBase::getWriteCount() of the packed array when filled
+    unsigned int n;                 //!< Number of elements filled
+    };
+
+//! Host access to a Scalar4 per-particle array as separate x, y, z, and w streams
+/*! The particle data stores positions, velocities, and net forces packed into Scalar4 arrays, which is what the GPU
+    kernels want. CPU kernels that vectorize over particles or only need some of the components are better served by
+    one contiguous array per component. SoAArrayHandle provides that view of the first \a n elements of a
+    GlobalArray<Scalar4>, through a SoAMirror that ParticleData keeps for the positions, velocities, and net force
+    (see ParticleData::getPositionsSoA()).
+
+    The packed array remains the authoritative storage. When the handle is acquired with access_mode::read or
+    access_mode::readwrite, the streams are refilled from it only if it has been modified since the mirror was last
+    filled, which is detected from the data pointer and GPUArrayBase::getWriteCount(). Any ArrayHandle acquired for
+    writing, the array swaps of SFCPackUpdater, and the resizes and rewrites of Communicator migration all change one
+    of the two, so repeated reads between modifications cost nothing and the streams are always in the current
+    particle order. A handle acquired with access_mode::readwrite or access_mode::overwrite writes the streams back to
+    the packed array when it goes out of scope.
+
+    With access_mode::overwrite, all four components of all \a n elements must be written, as the old values are not
+    read. As with ArrayHandle, the packed array may not be accessed through another handle while the SoAArrayHandle
+    is in scope.
+
+    \code
+    SoAArrayHandle h_pos(m_pdata->getPositions(), m_pdata->getPositionsSoA(), m_pdata->getN(), access_mode::read);
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        com += h_pos.x[i];
+    \endcode
+*/
+class SoAArrayHandle
+    {
+    public:
+        //! Acquires the streams
+        /*! \param data Packed per-particle array
+            \param mirror Mirror of \a data, with streams of a pitch of at least \a n and 4 rows
+            \param n Number of elements to access
+            \param mode Access mode requested
+        */
+        SoAArrayHandle(const GlobalArray<Scalar4>& data,
+                       SoAMirror& mirror,
+                       unsigned int n,
+                       const access_mode::Enum mode)
+            : m_prev_write_count(data.getWriteCount()),
+              m_data(data, access_location::host, (mode == access_mode::read) ? access_mode::read
+                                                                               : access_mode::readwrite),
+              m_soa(mirror.streams, access_location::host, access_mode::readwrite),
+              m_n(n), m_mode(mode)
+            {
+            assert(mirror.streams.getPitch() >= n && mirror.streams.getHeight() >= 4);
+            unsigned int pitch = mirror.streams.getPitch();
+            x = m_soa.data;
+            y = m_soa.data + pitch;
+            z = m_soa.data + 2*pitch;
+            w = m_soa.data + 3*pitch;
+
+            bool current = mirror.source == m_data.data && mirror.write_count == m_prev_write_count && mirror.n >= n;
+            if (m_mode != access_mode::overwrite && !current)
+                {
+                for (unsigned int i = 0; i < m_n; i++)
+                    {
+                    const Scalar4 v = m_data.data[i];
+                    x[i] = v.x;
+                    y[i] = v.y;
+                    z[i] = v.z;
+                    w[i] = v.w;
+                    }
+                }
+
+            // acquiring the packed array for writing has already counted the write back in the destructor
+            if (m_mode != access_mode::read || !current)
+                {
+                mirror.source = m_data.data;
+                mirror.write_count = data.getWriteCount();
+                mirror.n = n;
+                }
+            }
+
+        //! Writes modified streams back to the packed array
+        ~SoAArrayHandle()
+            {
+            if (m_mode != access_mode::read)
+                {
+                for (unsigned int i = 0; i < m_n; i++)
+                    m_data.data[i] = make_scalar4(x[i], y[i], z[i], w[i]);
+                }
+            }
+
+        Scalar *x;  //!< x components (or first component) of the elements
+        Scalar *y;  //!< y components of the elements
+        Scalar *z;  //!< z components of the elements
+        Scalar *w;  //!< w components of the elements (type id, mass, or energy depending on the array)
+
+    private:
+        unsigned int m_prev_write_count;    //!< Write count of the packed array before it was acquired
+        ArrayHandle<Scalar4> m_data;        //!< Handle to the packed array
+        ArrayHandle<Scalar> m_soa;          //!< Handle to the streams
+        unsigned int m_n;                   //!< Number of elements accessed
+        access_mode::Enum m_mode;           //!< Access mode requested
+
+        // non-copyable
+        SoAArrayHandle(const SoAArrayHandle&);
+        SoAArrayHandle& operator=(const SoAArrayHandle&);
+    };
+
+#endif // __SOA_ARRAY_HANDLE_H__
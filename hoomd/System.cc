@@ -35,7 +35,7 @@ PyObject* walltimeLimitExceptionTypeObj = 0;
 System::System(std::shared_ptr<SystemDefinition> sysdef, unsigned int initial_tstep)
         : m_sysdef(sysdef), m_start_tstep(initial_tstep), m_end_tstep(0), m_cur_tstep(initial_tstep), m_cur_tps(0),
         m_med_tps(0), m_last_status_time(0), m_last_status_tstep(initial_tstep), m_quiet_run(false),
-        m_profile(false), m_stats_period(10)
+        m_profile(false), m_profile_period(1), m_profile_counters(false), m_stats_period(10)
     {
     // sanity check
     assert(m_sysdef);
@@ -581,12 +581,17 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
             #endif
             }
 
+        if (m_profiler) m_profiler->beginStep(m_cur_tstep);
+
         // execute analyzers
         vector<analyzer_item>::iterator analyzer;
         for (analyzer =  m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
             {
             if (analyzer->shouldExecute(m_cur_tstep))
+                {
+                CallTimer::Scope timer(*analyzer->m_analyzer->getCallTimer());
                 analyzer->m_analyzer->analyze(m_cur_tstep);
+                }
             }
 
         // execute updaters
@@ -594,7 +599,10 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
         for (updater =  m_updaters.begin(); updater != m_updaters.end(); ++updater)
             {
             if (updater->shouldExecute(m_cur_tstep))
+                {
+                CallTimer::Scope timer(*updater->m_updater->getCallTimer());
                 updater->m_updater->update(m_cur_tstep);
+                }
             }
 
         // look ahead to the next time step and see which analyzers and updaters will be executed
@@ -603,16 +611,32 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
 
         // execute the integrator
         if (m_integrator)
+            {
+            CallTimer::Scope timer(*m_integrator->getCallTimer());
             m_integrator->update(m_cur_tstep);
+            }
+
+        if (m_profiler)
+            {
+            m_profiler->endStep();
+
+            // write out the trace events periodically so that they do not accumulate over long runs
+            if (m_profiler->isTraceFlushDue())
+                m_profiler->writeTrace(m_trace_file);
+            }
 
         // quit if Ctrl-C was pressed
         if (g_sigint_recvd)
             {
             g_sigint_recvd = 0;
+            flushAnalyzers();
             return;
             }
         }
 
+    // complete any output in progress before returning to python
+    flushAnalyzers();
+
     // generate a final status line
     generateStatusLine();
     m_last_status_tstep = m_cur_tstep;
@@ -638,9 +662,12 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
         m_exec_conf->msg->notice(1) << "Average TPS: " << m_last_TPS << endl;
 
     // write out the profile data
-    if (m_profiler)
+    if (m_profiler && m_profile)
         m_exec_conf->msg->notice(1) << *m_profiler;
 
+    if (m_profiler && !m_trace_file.empty())
+        m_profiler->writeTrace(m_trace_file);
+
     if (!m_quiet_run)
         printStats();
 
@@ -659,24 +686,72 @@ void System::enableProfiler(bool enable)
     m_profile = enable;
     }
 
+/*! \param period Only every \a period-th time step is timed
+    \param trace_file File to append a trace of the timed steps to (empty to disable tracing)
+    \param counters Set to true to measure hardware performance counters in profiled runs
+
+    A run is profiled when enableProfiler() is set or \a trace_file is not empty.
+*/
+void System::setProfileOptions(unsigned int period, const std::string& trace_file, bool counters)
+    {
+    m_profile_period = period;
+    m_trace_file = trace_file;
+    m_profile_counters = counters;
+    }
+
 /*! \param logger Logger to register computes and updaters with
     All computes and updaters registered with the system are also registered with the logger.
+
+    The call timers of all computes, updaters, analyzers, and the communicator are registered as well. Timers that
+    do not have a name yet are named time_ followed by the name of the object in the system (e.g. time_analyzer0).
 */
 void System::registerLogger(std::shared_ptr<Logger> logger)
     {
     // set the profiler on everything
     if (m_integrator)
+        {
         logger->registerUpdater(m_integrator);
+        logger->registerCallTimer(m_integrator->getCallTimer());
+        }
 
     // updaters
     vector<updater_item>::iterator updater;
     for (updater = m_updaters.begin(); updater != m_updaters.end(); ++updater)
+        {
         logger->registerUpdater(updater->m_updater);
 
+        std::shared_ptr<CallTimer> timer = updater->m_updater->getCallTimer();
+        if (timer->getName().empty())
+            timer->setName("time_" + updater->m_name);
+        logger->registerCallTimer(timer);
+        }
+
     // computes
     map< string, std::shared_ptr<Compute> >::iterator compute;
     for (compute = m_computes.begin(); compute != m_computes.end(); ++compute)
+        {
         logger->registerCompute(compute->second);
+
+        std::shared_ptr<CallTimer> timer = compute->second->getCallTimer();
+        if (timer->getName().empty())
+            timer->setName("time_" + compute->first);
+        logger->registerCallTimer(timer);
+        }
+
+    // analyzers
+    vector<analyzer_item>::iterator analyzer;
+    for (analyzer = m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
+        {
+        std::shared_ptr<CallTimer> timer = analyzer->m_analyzer->getCallTimer();
+        if (timer->getName().empty())
+            timer->setName("time_" + analyzer->m_name);
+        logger->registerCallTimer(timer);
+        }
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        logger->registerCallTimer(m_comm->getCallTimer());
+#endif
     }
 
 /*! \param seconds Period between statistics output in seconds
@@ -720,8 +795,14 @@ void System::setAutotunerParams(bool enabled, unsigned int period)
 
 void System::setupProfiling()
     {
-    if (m_profile)
-        m_profiler = std::shared_ptr<Profiler>(new Profiler("Simulation"));
+    if (m_profile || !m_trace_file.empty())
+        {
+        m_profiler = std::shared_ptr<Profiler>(new Profiler("Simulation", m_exec_conf));
+        m_profiler->setSamplePeriod(m_profile_period);
+        m_profiler->enableTrace(!m_trace_file.empty());
+        if (m_profile && m_profile_counters)
+            m_profiler->enableHardwareCounters();
+        }
     else
         m_profiler = std::shared_ptr<Profiler>();
 
@@ -758,6 +839,16 @@ void System::setupProfiling()
 #endif
     }
 
+/*! Analyzers that write output in the background block until it is complete, so that files are complete when
+    run() returns.
+*/
+void System::flushAnalyzers()
+    {
+    vector<analyzer_item>::iterator analyzer;
+    for (analyzer = m_analyzers.begin(); analyzer != m_analyzers.end(); ++analyzer)
+      analyzer->m_analyzer->flush();
+    }
+
 void System::printStats()
     {
     m_exec_conf->msg->notice(1) << "---------" << endl;
@@ -928,6 +1019,7 @@ void export_System(py::module& m)
     .def("setStatsPeriod", &System::setStatsPeriod)
     .def("setAutotunerParams", &System::setAutotunerParams)
     .def("enableProfiler", &System::enableProfiler)
+    .def("setProfileOptions", &System::setProfileOptions)
     .def("enableQuietRun", &System::enableQuietRun)
     .def("run", &System::run)
 
@@ -150,6 +150,9 @@ class PYBIND11_EXPORT System
         //! Configures profiling of runs
         void enableProfiler(bool enable);
 
+        //! Set the sample period and trace output of profiled runs
+        void setProfileOptions(unsigned int period, const std::string& trace_file, bool counters);
+
         //! Toggle whether or not to print the status line and TPS for each run
         void enableQuietRun(bool enable)
             {
@@ -421,6 +424,9 @@ class PYBIND11_EXPORT System
 
         bool m_quiet_run;       //!< True to suppress the status line and TPS from being printed to stdout for each run
         bool m_profile;         //!< True if runs should be profiled
+        unsigned int m_profile_period;  //!< Period between profiled time steps
+        std::string m_trace_file;       //!< File to append the trace of profiled runs to (empty if disabled)
+        bool m_profile_counters;        //!< True if profiled runs measure hardware performance counters
         unsigned int m_stats_period; //!< Number of seconds between statistics output lines
 
         // --------- Steps in the simulation run implemented in helper functions
@@ -433,6 +439,9 @@ class PYBIND11_EXPORT System
         //! Resets stats for all contained classes
         void resetStats();
 
+        //! Completes output in progress in all analyzers
+        void flushAnalyzers();
+
         //! Prints out a formatted status line
         void generateStatusLine();
 
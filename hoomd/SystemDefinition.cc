@@ -10,6 +10,7 @@
 #include "SystemDefinition.h"
 
 #include "SnapshotSystemData.h"
+#include "GSDReader.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -98,6 +99,50 @@ SystemDefinition::SystemDefinition(std::shared_ptr< SnapshotSystemData<Real> > s
     m_integrator_data = std::shared_ptr<IntegratorData>(new IntegratorData(snapshot->integrator_data));
     }
 
+/*! \param reader GSD file reader
+    \param exec_conf Execution configuration to run on
+    \param decomposition (optional) The domain decomposition layout
+
+    When the reader is in parallel mode, its snapshot holds no particles. Every rank then reads the particles in its
+    own domain from the file, so that the particle data is neither held on nor scattered from the root rank. Bonds
+    and other topology are distributed from the snapshot on the root rank as usual.
+*/
+SystemDefinition::SystemDefinition(std::shared_ptr<GSDReader> reader,
+                                   std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                   std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    std::shared_ptr< SnapshotSystemData<float> > snapshot = reader->getSnapshot();
+    setNDimensions(snapshot->dimensions);
+
+    m_particle_data = std::shared_ptr<ParticleData>(new ParticleData(snapshot->particle_data,
+                 snapshot->global_box,
+                 exec_conf,
+                 decomposition));
+
+    #ifdef ENABLE_MPI
+    if (reader->isParallel() && decomposition)
+        {
+        reader->readLocalParticles(decomposition, m_particle_data->getGlobalBox());
+        m_particle_data->initializeFromLocalSnapshot(reader->getLocalParticles(),
+                                                     reader->getLocalTags(),
+                                                     reader->getNGlobal());
+        reader->clearLocalParticles();
+        }
+
+    // in MPI simulations, broadcast dimensionality from rank zero
+    if (m_particle_data->getDomainDecomposition())
+        bcast(m_n_dimensions, 0,exec_conf->getMPICommunicator());
+    #endif
+
+    m_bond_data = std::shared_ptr<BondData>(new BondData(m_particle_data, snapshot->bond_data));
+    m_angle_data = std::shared_ptr<AngleData>(new AngleData(m_particle_data, snapshot->angle_data));
+    m_dihedral_data = std::shared_ptr<DihedralData>(new DihedralData(m_particle_data, snapshot->dihedral_data));
+    m_improper_data = std::shared_ptr<ImproperData>(new ImproperData(m_particle_data, snapshot->improper_data));
+    m_constraint_data = std::shared_ptr<ConstraintData>(new ConstraintData(m_particle_data, snapshot->constraint_data));
+    m_pair_data = std::shared_ptr<PairData>(new PairData(m_particle_data, snapshot->pair_data));
+    m_integrator_data = std::shared_ptr<IntegratorData>(new IntegratorData(snapshot->integrator_data));
+    }
+
 /*! Sets the dimensionality of the system.  When quantities involving the dof of
     the system are computed, such as T, P, etc., the dimensionality is needed.
     Therefore, the dimensionality must be set before any temperature/pressure
@@ -300,6 +345,7 @@ void export_SystemDefinition(py::module& m)
     .def(py::init<std::shared_ptr< SnapshotSystemData<float> >, std::shared_ptr<ExecutionConfiguration> >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<double> >, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
     .def(py::init<std::shared_ptr< SnapshotSystemData<double> >, std::shared_ptr<ExecutionConfiguration> >())
+    .def(py::init<std::shared_ptr<GSDReader>, std::shared_ptr<ExecutionConfiguration>, std::shared_ptr<DomainDecomposition> >())
     .def("setNDimensions", &SystemDefinition::setNDimensions)
     .def("getNDimensions", &SystemDefinition::getNDimensions)
     .def("getParticleData", &SystemDefinition::getParticleData)
@@ -21,6 +21,8 @@ Updater::Updater(std::shared_ptr<SystemDefinition> sysdef)
     // sanity check
     assert(m_sysdef);
     assert(m_pdata);
+
+    m_call_timer = std::shared_ptr<CallTimer>(new CallTimer(m_exec_conf));
     }
 
 /*! It is useful for the user to know where computation time is spent, so all Updaters
@@ -7,6 +7,7 @@
 #include "HOOMDMath.h"
 #include "SystemDefinition.h"
 #include "Profiler.h"
+#include "CallTimer.h"
 #include "SharedSignal.h"
 
 #include <memory>
@@ -69,6 +70,14 @@ class PYBIND11_EXPORT Updater
         //! Sets the profiler for the compute to use
         virtual void setProfiler(std::shared_ptr<Profiler> prof);
 
+        //! Get the timer of the calls to update()
+        /*! The timer is registered with loggers when it has a name (see CallTimer).
+        */
+        std::shared_ptr<CallTimer> getCallTimer() const
+            {
+            return m_call_timer;
+            }
+
         //! Set autotuner parameters
         /*! \param enable Enable/disable autotuning
             \param period period (approximate) in time steps when returning occurs
@@ -200,6 +209,7 @@ class PYBIND11_EXPORT Updater
         const std::shared_ptr<SystemDefinition> m_sysdef; //!< The system definition this compute is associated with
         const std::shared_ptr<ParticleData> m_pdata;      //!< The particle data this compute is associated with
         std::shared_ptr<Profiler> m_prof;                 //!< The profiler this compute is to use
+        std::shared_ptr<CallTimer> m_call_timer;          //!< Timer of the calls to update()
 #ifdef ENABLE_MPI
         std::shared_ptr<Communicator> m_comm;             //!< The communicator this updater is to use
 #endif
@@ -86,7 +86,8 @@ sys.excepthook = _hoomd_sys_excepthook
 
 __version__ = "{0}.{1}.{2}".format(*_hoomd.__version__)
 
-def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_period=0, callback=None, quiet=False):
+def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_period=0, callback=None, quiet=False,
+        profile_period=1, trace=None, profile_counters=False):
     """ Runs the simulation for a given number of time steps.
 
     Args:
@@ -99,12 +100,16 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
         callback (`callable`): Sets a Python function to be called regularly during a run.
         callback_period (int): Sets the period, in time steps, between calls made to ``callback``.
         quiet (bool): Set to True to disable the status information printed to the screen by the run.
+        profile_period (int): Only time every ``profile_period``-th time step when profiling or tracing.
+        trace (str): If not None, append a timeline of the profiled time steps to this file.
+        profile_counters (bool): Set to True to add hardware performance counters to the profile.
 
     Example::
 
             hoomd.run(10)
             hoomd.run(10e6, limit_hours=1.0/3600.0, limit_multiple=10)
             hoomd.run(10, profile=True)
+            hoomd.run(10000, profile=True, profile_period=100, trace='trace.json')
             hoomd.run(10, quiet=True)
             hoomd.run(10, callback_period=2, callback=lambda step: print(step))
 
@@ -123,7 +128,24 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
 
     When `profile` is **True**, a detailed breakdown of how much time was spent in each
     portion of the calculation is printed at the end of the run. Collecting this timing information
-    slows the simulation.
+    slows the simulation. In MPI runs, each entry shows the time averaged over the ranks followed by the minimum and
+    maximum over the ranks, which includes the time spent waiting for messages from other ranks (*MPI wait*).
+
+    Set ``profile_period`` to time only every ``profile_period``-th time step. Steps that are not sampled run at full
+    speed, so that profiling may be left enabled in production runs. Percentages are then given relative to the total
+    time of the sampled steps.
+
+    When ``trace`` is set, every timed region of the sampled steps is recorded and appended to the given file every 100
+    sampled steps and at the end of the run, in the Chrome trace event format. View it with ``chrome://tracing`` or https://ui.perfetto.dev. Each MPI
+    rank is shown as a separate process and background threads, such as the asynchronous :py:class:`hoomd.dump.gsd`
+    writer, as separate tracks. Consecutive runs append to the same file.
+
+    When ``profile_counters`` is **True** on Linux, each profiled region also reports the instructions per CPU cycle
+    (*IPC*) and the memory traffic estimated from the last level cache misses, measured on the main thread with
+    ``perf_event_open``. Regions with a low IPC and high memory traffic are bound by the memory bandwidth. If the
+    kernel does not provide the counters (e.g. ``/proc/sys/kernel/perf_event_paranoid`` is too restrictive or the
+    run is in a virtual machine), a warning is printed and the profile is reported without them. The counters only
+    measure the main thread, so they are also disabled with a warning when HOOMD runs with more than one thread.
 
     **Wallclock limited runs:**
 
@@ -181,7 +203,18 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
 
     for logger in context.current.loggers:
         logger.update_quantities();
+
+    # load balancers measure the compute time of the current integrator
+    for updater in context.current.updaters:
+        if isinstance(updater, update.balance):
+            updater.update_integrator();
+
+    if int(profile_period) < 1:
+        context.msg.error("profile_period must be at least 1\n");
+        raise ValueError('Error running');
+
     context.current.system.enableProfiler(profile);
+    context.current.system.setProfileOptions(int(profile_period), trace if trace is not None else '', profile_counters);
     context.current.system.enableQuietRun(quiet);
 
     # update all user-defined neighbor lists
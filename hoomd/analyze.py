@@ -371,6 +371,22 @@ class log(_analyzer):
     globally chosen *r_cut* value is the largest of all active pair potentials and those with *log=True*, so you will
     observe performance degradation if you *disable(log=True)* a potential with a large *r_cut*.
 
+    Timing quantities give the average wall-clock time per call (in seconds) since the previous logged step, maximized
+    over the MPI ranks. They are measured only while they are logged:
+
+    - **time_pair_lj**, **time_pair_gauss**, ... - Pair potential force computation (with the name suffix, if any)
+    - **time_bond_harmonic**, ... - Bond potential force computation
+    - **time_nlist** - Neighbor list check and build
+    - **time_cell** - Cell list build
+    - **time_comm** - Particle migration and ghost communication
+    - **time_integrate** - One step of the MD integrator, **time_hpmc_sweep** - one HPMC sweep
+    - **time_force0**, **time_updater1**, **time_analyzer2**, ... - Any other force, compute, updater, or analyzer,
+      named after its internal name (e.g. ``force_name``, ``updater_name``, or ``analyzer_name`` of the python object)
+
+    The time of a call excludes the time of other logged timing quantities nested inside it: for example,
+    **time_integrate** excludes **time_pair_lj** and **time_comm** when these are also logged. On the GPU, every timed
+    call synchronizes the device.
+
     File output from analyze.log is optional. Specify *None* for the file name and no file will be output.
     Use this with the :py:meth:`query()` method to query the values of properties without the overhead of writing them
     to disk.
@@ -82,6 +82,43 @@ def barrier():
     if _hoomd.is_MPI_available():
         hoomd.context.mpi_conf.barrier()
 
+def set_ghost_overlap(enable=True):
+    """ Overlap the ghost position update with the force computation.
+
+    Args:
+        enable (bool): Set to True to compute forces while the ghost update is in flight.
+
+    On time steps without particle migration, the positions of the ghost particles are sent to the neighboring ranks
+    every step. With the overlap enabled, pair forces of particles that have no ghost particles as neighbors are
+    computed while these messages are in transit, and the remaining particles are computed after they arrive.
+    This hides part of the communication latency in MPI simulations on the CPU.
+
+    The overlap is disabled by default. It has no effect on the GPU, in simulations with rigid bodies, or on
+    time steps when the neighbor list is rebuilt.
+
+    Note:
+        Forces are summed in a different order with the overlap enabled, so results agree with those of a run
+        without it only to within floating point round-off.
+
+    Note:
+        Does nothing in non-MPI builds and in single rank simulations.
+
+    Example::
+
+        comm.set_ghost_overlap(True)
+
+    """
+    hoomd.util.print_status_line();
+
+    if not hoomd.init.is_initialized():
+        hoomd.context.msg.error("comm.set_ghost_overlap: cannot enable overlap before the system is initialized\n");
+        raise RuntimeError('Error setting ghost overlap');
+
+    if _hoomd.is_MPI_available():
+        cpp_communicator = hoomd.context.current.system.getCommunicator();
+        if cpp_communicator is not None:
+            cpp_communicator.setOverlapGhostUpdate(bool(enable));
+
 class decomposition(object):
     """ Set the domain decomposition.
 
@@ -504,6 +504,10 @@ class gsd(hoomd.analyze._analyzer):
         time_step (int): Time step to write to the file (only used when period is None)
         dynamic (list): A list of quantity categories to save every frame. (added in version 2.2)
         static (list): A list of quantity categories save only in frame 0 (may not be set in conjunction with *dynamic*, deprecated in version 2.2).
+        parallel (bool): When True, write the per-particle data from all MPI ranks in parallel (added in version 2.9).
+        async_write (bool): When True, write frames in a background thread (added in version 2.9).
+        precision (dict): Quantization step of ``position``, ``orientation``, and ``velocity``, or None to write exact
+                          values (added in version 2.9).
 
     Write a simulation snapshot to the specified GSD file at regular intervals. GSD is capable of storing all particle
     and bond data fields in hoomd, in every frame of the trajectory. This allows GSD to store simulations where the
@@ -560,6 +564,28 @@ class gsd(hoomd.analyze._analyzer):
     To write restart files with gsd, set `truncate=True`. This will cause :py:class:`gsd` to write a new frame 0
     to the file every period steps.
 
+    In MPI simulations, :py:class:`gsd` gathers all particles on the root rank to write a frame. With
+    `parallel=True`, the ranks instead exchange the particles so that each holds a contiguous range of the group in
+    tag order, and every rank writes its range of the per-particle chunks directly to the file. The root rank only
+    writes the remaining chunks and the index. The file is format-compatible with one written in serial and reads
+    back the same data, but chunks may be placed in a different order in the file. Parallel writes require a file
+    system where all ranks can write to *filename* at the same path, and remove the memory and communication
+    bottleneck on the root rank in large simulations.
+
+    With `async_write=True`, :py:class:`gsd` copies the data of a frame and returns to the simulation while a
+    background thread writes the frame to the file. At most one frame is written at a time, a new frame waits until the
+    previous one is complete. :py:func:`hoomd.run()` waits for the last frame before it returns (also when interrupted
+    with Ctrl-C), and :py:meth:`flush` waits for it explicitly. Frames are written synchronously when the notice level
+    is 10 or higher.
+
+    Set *precision* to store ``particles/position``, ``particles/orientation``, and ``particles/velocity`` quantized
+    to a fixed step, like the XTC format. A value *x* is stored as the integer nearest to *x/precision*, so the value
+    read back differs from *x* by at most *precision/2*. The integers are stored as variable length differences between
+    consecutive particles, which typically reduces these chunks to a third of their size or less. Quantized files use
+    version 2.0 of the hoomd schema. :py:func:`hoomd.init.read_gsd()` and :py:class:`hoomd.data.gsd_snapshot` read them,
+    older readers refuse to open them. Quantized frames cannot be appended to a file written without *precision*, and
+    *precision* cannot be combined with *parallel*.
+
     .. rubric:: State data
 
     :py:class:`gsd` can save internal state data for the following hoomd objects:
@@ -584,6 +610,9 @@ class gsd(hoomd.analyze._analyzer):
         dump.gsd(filename="configuration.gsd", overwrite=True, period=None, group=group.all(), time_step=0)
         dump.gsd(filename="momentum_too.gsd", period=1000, group=group.all(), phase=0, dynamic=['momentum'])
         dump.gsd(filename="saveall.gsd", overwrite=True, period=1000, group=group.all(), dynamic=['attribute', 'momentum', 'topology'])
+        dump.gsd(filename="large.gsd", period=1000, group=group.all(), parallel=True)
+        dump.gsd(filename="trajectory.gsd", period=1000, group=group.all(), async_write=True)
+        dump.gsd(filename="small.gsd", period=1000, group=group.all(), precision=dict(position=1e-3))
 
     """
     def __init__(self,
@@ -595,12 +624,24 @@ class gsd(hoomd.analyze._analyzer):
                  phase=0,
                  time_step=None,
                  static=None,
-                 dynamic=None):
+                 dynamic=None,
+                 parallel=False,
+                 async_write=False,
+                 precision=None):
         hoomd.util.print_status_line();
 
         if static is not None and dynamic is not None:
             raise ValueError("Cannot specify both static and dynamic arguments");
 
+        if precision is not None:
+            if parallel:
+                raise ValueError("Cannot specify both precision and parallel arguments");
+            for k, v in precision.items():
+                if k not in ['position', 'orientation', 'velocity']:
+                    raise ValueError("Cannot quantize " + str(k));
+                if v <= 0:
+                    raise ValueError("precision must be positive");
+
         categories = ['attribute', 'property', 'momentum', 'topology'];
         dynamic_quantities = ['property']
 
@@ -635,6 +676,11 @@ class gsd(hoomd.analyze._analyzer):
         self.cpp_analyzer.setWriteProperty('property' in dynamic_quantities);
         self.cpp_analyzer.setWriteMomentum('momentum' in dynamic_quantities);
         self.cpp_analyzer.setWriteTopology('topology' in dynamic_quantities);
+        self.cpp_analyzer.setParallelWrite(parallel);
+        self.cpp_analyzer.setAsyncWrite(async_write);
+        if precision is not None:
+            for k, v in precision.items():
+                self.cpp_analyzer.setPrecision('particles/' + k, v);
 
         if period is not None:
             self.setupAnalyzer(period, phase);
@@ -642,13 +688,17 @@ class gsd(hoomd.analyze._analyzer):
             if time_step is None:
                 time_step = hoomd.context.current.system.getCurrentTimeStep()
             self.cpp_analyzer.analyze(time_step);
+            self.cpp_analyzer.flush();
 
         # store metadata
         self.filename = filename
         self.period = period
         self.group = group
         self.phase = phase
-        self.metadata_fields = ['filename','period','group', 'phase']
+        self.parallel = parallel
+        self.async_write = async_write
+        self.precision = precision
+        self.metadata_fields = ['filename','period','group', 'phase', 'parallel', 'async_write', 'precision']
 
     def write_restart(self):
         """ Write a restart file at the current time step.
@@ -660,6 +710,18 @@ class gsd(hoomd.analyze._analyzer):
 
         time_step = hoomd.context.current.system.getCurrentTimeStep()
         self.cpp_analyzer.analyze(time_step);
+        self.cpp_analyzer.flush();
+
+    def flush(self):
+        """ Wait until the frame being written in the background is complete.
+
+        Only needed with ``async_write=True`` to read the file before :py:func:`hoomd.run()` returns, e.g. in a
+        python callback.
+
+        .. versionadded:: 2.9
+        """
+
+        self.cpp_analyzer.flush();
 
     def dump_state(self, obj):
         """Write state information for a hoomd object.
@@ -2,7 +2,11 @@ find_package(MKL QUIET)
 find_package(ACML QUIET)
 
 option(ENABLE_HOST "CPU FFT support" ON)
-if (MKL_LIBRARIES AND MKL_INCLUDE_DIR)
+if (ENABLE_FFTW AND FFTW_FOUND)
+    # use the same library as the local FFT in hoomd, it is linked in with HOOMD_COMMON_LIBS
+    set(LOCAL_FFT_LIB LOCAL_LIB_FFTW)
+    set(LOCAL_FFT_LIBRARIES "${FFTW_LIBRARIES}")
+elseif (MKL_LIBRARIES AND MKL_INCLUDE_DIR)
     set(LOCAL_FFT_LIB LOCAL_LIB_MKL)
     set(LOCAL_FFT_LIBRARIES "${MKL_LIBRARIES}")
     include_directories(${MKL_INCLUDE_DIR})
@@ -930,6 +930,48 @@ int gsd_end_frame(struct gsd_handle* handle)
     return 0;
     }
 
+// HOOMD local modification: __gsd_add_index_entry() is split out of gsd_write_chunk() so that gsd_reserve_chunk()
+// can share it. gsd_reserve_chunk() is not part of upstream GSD, it supports dump.gsd(parallel=True) and extends the
+// file with ftruncate(). Keep these changes when updating gsd.c from upstream.
+
+/*! \param handle Handle to an open GSD file
+    \param index_entry Entry to add to the in-memory index
+
+    Expands the index when it is full.
+
+    \return 0 on success, -1 on a file IO failure
+*/
+static int __gsd_add_index_entry(struct gsd_handle* handle, const struct gsd_index_entry *index_entry)
+    {
+    // need to expand the index if it is already full
+    if (handle->index_num_entries >= handle->header.index_allocated_entries)
+        {
+        int retval = __gsd_expand_index(handle);
+        if (retval != 0)
+            return -1;
+        }
+
+    // once we get here, there is a free slot to add this entry to the index
+    size_t slot = handle->index_num_entries;
+
+    // in append mode, only unwritten entries are stored in memory
+    if (handle->open_flags == GSD_OPEN_APPEND)
+        {
+        slot -= handle->index_written_entries;
+        if (slot >= handle->append_index_size)
+            {
+            handle->append_index_size *= 2;
+            handle->index = (struct gsd_index_entry *)realloc(handle->index, handle->append_index_size*sizeof(struct gsd_index_entry));
+            if (handle->index == NULL)
+                return -1;
+            }
+        }
+    handle->index[slot] = *index_entry;
+    handle->index_num_entries++;
+
+    return 0;
+    }
+
 /*! \param handle Handle to an open GSD file
     \param name Name of the data chunk (truncated to 63 chars)
     \param type type ID that identifies the type of data in \a data
@@ -985,34 +1027,70 @@ int gsd_write_chunk(struct gsd_handle* handle,
     // update the file_size in the handle
     handle->file_size += bytes_written;
 
-    // update the index entry in the index
-    // need to expand the index if it is already full
-    if (handle->index_num_entries >= handle->header.index_allocated_entries)
-        {
-        int retval = __gsd_expand_index(handle);
-        if (retval != 0)
-            return -1;
-        }
+    return __gsd_add_index_entry(handle, &index_entry);
+    }
 
-    // once we get here, there is a free slot to add this entry to the index
-    size_t slot = handle->index_num_entries;
+/*! \param handle Handle to an open GSD file
+    \param name Name of the data chunk (truncated to 63 chars)
+    \param type type ID that identifies the type of data in the chunk
+    \param N Number of rows in the data
+    \param M Number of columns in the data
+    \param flags set to 0, non-zero values reserved for future use
+    \param location Output: file offset of the reserved data region
 
-    // in append mode, only unwritten entries are stored in memory
-    if (handle->open_flags == GSD_OPEN_APPEND)
-        {
-        slot -= handle->index_written_entries;
-        if (slot >= handle->append_index_size)
-            {
-            handle->append_index_size *= 2;
-            handle->index = (struct gsd_index_entry *)realloc(handle->index, handle->append_index_size*sizeof(struct gsd_index_entry));
-            if (handle->index == NULL)
-                return -1;
-            }
-        }
-    handle->index[slot] = index_entry;
-    handle->index_num_entries++;
+    \pre \a handle was opened by gsd_open().
+    \pre \a name is a unique name for data chunks in the given frame.
 
-    return 0;
+    \post `N * M * gsd_sizeof_type(type)` bytes are reserved at the end of the file and the chunk is added to the
+           in-memory index. The caller must write the data to \a location (e.g. with pwrite() on another file
+           descriptor) before calling gsd_end_frame().
+
+    gsd_reserve_chunk() allows several processes to fill a single chunk in parallel, with only the process that owns
+    \a handle writing the index.
+
+    \note HOOMD local modification, not part of upstream GSD (see __gsd_add_index_entry()).
+
+    \return 0 on success, -1 on a file IO failure - see errno for details, -2 on invalid input, and -3 when out of names
+*/
+int gsd_reserve_chunk(struct gsd_handle* handle,
+                      const char *name,
+                      enum gsd_type type,
+                      uint64_t N,
+                      uint32_t M,
+                      uint8_t flags,
+                      int64_t *location)
+    {
+    // validate input
+    if (location == NULL)
+        return -2;
+    if (M == 0)
+        return -2;
+    if (handle->open_flags == GSD_OPEN_READONLY)
+        return -2;
+
+    // populate fields in the index_entry data
+    struct gsd_index_entry index_entry;
+    memset(&index_entry, 0, sizeof(index_entry));
+    index_entry.frame = handle->cur_frame;
+    index_entry.id = __gsd_get_id(handle, name, 1);
+    if (index_entry.id == UINT16_MAX)
+        return -3;
+    index_entry.type = (uint8_t)type;
+    index_entry.N = N;
+    index_entry.M = M;
+    size_t size = N * M * gsd_sizeof_type(type);
+
+    // reserve the region at the end of the file for the chunk
+    index_entry.location = handle->file_size;
+    handle->file_size += size;
+
+    // extend the file so that an index expansion is placed after the reserved region
+    int retval = ftruncate(handle->fd, handle->file_size);
+    if (retval != 0)
+        return -1;
+
+    *location = index_entry.location;
+    return __gsd_add_index_entry(handle, &index_entry);
     }
 
 /*! \param handle Handle to an open GSD file
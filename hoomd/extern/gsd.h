@@ -144,6 +144,18 @@ int gsd_write_chunk(struct gsd_handle* handle,
                     uint8_t flags,
                     const void *data);
 
+//! Reserve space for a data chunk in the current frame without writing its data
+/*! HOOMD local modification, not part of upstream GSD. Used by dump.gsd(parallel=True), keep it when updating this
+    file from upstream.
+*/
+int gsd_reserve_chunk(struct gsd_handle* handle,
+                      const char *name,
+                      enum gsd_type type,
+                      uint64_t N,
+                      uint32_t M,
+                      uint8_t flags,
+                      int64_t *location);
+
 //! Find a chunk in the GSD file
 const struct gsd_index_entry* gsd_find_chunk(struct gsd_handle* handle, uint64_t frame, const char *name);
 
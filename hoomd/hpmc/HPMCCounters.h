@@ -88,6 +88,19 @@ DEVICE inline hpmc_counters_t operator-(const hpmc_counters_t& a, const hpmc_cou
     return result;
     }
 
+//! Take the sum of two sets of counters
+DEVICE inline hpmc_counters_t operator+(const hpmc_counters_t& a, const hpmc_counters_t& b)
+    {
+    hpmc_counters_t result;
+    result.translate_accept_count = a.translate_accept_count + b.translate_accept_count;
+    result.rotate_accept_count = a.rotate_accept_count + b.rotate_accept_count;
+    result.translate_reject_count = a.translate_reject_count + b.translate_reject_count;
+    result.rotate_reject_count = a.rotate_reject_count + b.rotate_reject_count;
+    result.overlap_checks = a.overlap_checks + b.overlap_checks;
+    result.overlap_err_count = a.overlap_err_count + b.overlap_err_count;
+    return result;
+    }
+
 
 //! Storage for NPT acceptance counters
 /*! \ingroup hpmc_data_structs */
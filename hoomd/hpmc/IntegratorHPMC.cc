@@ -28,6 +28,7 @@ IntegratorHPMC::IntegratorHPMC(std::shared_ptr<SystemDefinition> sysdef,
       #endif
     {
     m_exec_conf->msg->notice(5) << "Constructing IntegratorHPMC" << endl;
+    m_call_timer->setName("time_hpmc_sweep");
 
     // broadcast the seed from rank 0 to all other ranks.
     #ifdef ENABLE_MPI
@@ -330,6 +331,8 @@ void export_IntegratorHPMC(py::module& m)
     .def("communicate", &IntegratorHPMC::communicate)
     .def("slotNumTypesChange", &IntegratorHPMC::slotNumTypesChange)
     .def("setDeterministic", &IntegratorHPMC::setDeterministic)
+    .def("setThreaded", &IntegratorHPMC::setThreaded)
+    .def("setVerletSkin", &IntegratorHPMC::setVerletSkin)
     .def("disablePatchEnergyLogOnly", &IntegratorHPMC::disablePatchEnergyLogOnly)
     ;
 
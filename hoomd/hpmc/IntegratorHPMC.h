@@ -322,6 +322,12 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         //! Enable deterministic simulations
         virtual void setDeterministic(bool deterministic) {};
 
+        //! Enable threaded trial moves on the CPU
+        virtual void setThreaded(bool threaded) {};
+
+        //! Set the skin of the Verlet list for trial moves on the CPU
+        virtual void setVerletSkin(Scalar skin) {};
+
         //! Prepare for the run
         virtual void prepRun(unsigned int timestep)
             {
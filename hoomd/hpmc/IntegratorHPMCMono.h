@@ -33,6 +33,10 @@
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 
 namespace hpmc
 {
@@ -105,6 +109,194 @@ class UpdateOrder
         std::vector<unsigned int> m_update_order; //!< Update order
     };
 
+//! Helper class to divide the local box into independent cells for threaded trial moves
+/*! The box is split into an even number of cells along each direction, each at least the nominal width wide. Cells
+    are grouped into 4 (2D) or 8 (3D) sets such that no two cells in the same set are neighbors. Particles in different
+    cells of the same set cannot interact, so their trial moves can be performed concurrently as long as moves that
+    leave the cell are rejected. The grid is shifted by a random fraction of a cell on every sweep.
+
+    bin() sorts the local particles into the cells. A particle keeps its cell for the duration of the sweep.
+
+    \ingroup hpmc_data_structs
+*/
+class CheckerboardGrid
+    {
+    public:
+        //! Constructor
+        CheckerboardGrid()
+            : m_dim(make_uint3(1,1,1)), m_shift(make_scalar3(0,0,0)), m_active_set(0)
+            {
+            }
+
+        //! Set up the grid
+        /*! \param box Local simulation box
+            \param width Minimum width of a cell
+            \param ndim Number of dimensions
+            \param shift Shift of the grid in units of the cell width (components in [0,1))
+        */
+        void setGrid(const BoxDim& box, Scalar width, unsigned int ndim, const Scalar3& shift)
+            {
+            m_box = box;
+            m_shift = shift;
+
+            Scalar3 npd = box.getNearestPlaneDistance();
+            m_dim.x = computeDim(npd.x, width);
+            m_dim.y = computeDim(npd.y, width);
+            m_dim.z = (ndim == 2) ? 1 : computeDim(npd.z, width);
+            m_cell_indexer = Index3D(m_dim.x, m_dim.y, m_dim.z);
+            }
+
+        //! Get the number of cells along each direction
+        uint3 getDim() const
+            {
+            return m_dim;
+            }
+
+        //! Get the number of cell sets
+        unsigned int getNumSets() const
+            {
+            return 8;
+            }
+
+        //! Compute the cell that a position belongs to
+        unsigned int getCell(const vec3<Scalar>& pos) const
+            {
+            Scalar3 f = m_box.makeFraction(vec_to_scalar3(pos));
+            int ib = wrap(int(floor(f.x*m_dim.x + m_shift.x)), m_dim.x);
+            int jb = wrap(int(floor(f.y*m_dim.y + m_shift.y)), m_dim.y);
+            int kb = wrap(int(floor(f.z*m_dim.z + m_shift.z)), m_dim.z);
+            return m_cell_indexer(ib, jb, kb);
+            }
+
+        //! Sort particles into cells
+        /*! \param h_postype Particle positions
+            \param order Order in which particles are added to their cells
+            \param N Number of local particles
+
+            Within each cell, particles are listed in the order given by \a order.
+        */
+        void bin(const Scalar4 *h_postype, UpdateOrder& order, unsigned int N)
+            {
+            unsigned int n_cells = m_cell_indexer.getNumElements();
+            m_cell_of.resize(N);
+            m_cell_particles.resize(N);
+            m_cell_start.assign(n_cells+1, 0);
+
+            for (unsigned int i = 0; i < N; i++)
+                {
+                m_cell_of[i] = getCell(vec3<Scalar>(h_postype[i]));
+                m_cell_start[m_cell_of[i]+1]++;
+                }
+
+            for (unsigned int c = 0; c < n_cells; c++)
+                m_cell_start[c+1] += m_cell_start[c];
+
+            std::vector<unsigned int> fill(m_cell_start.begin(), m_cell_start.end()-1);
+            for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+                {
+                unsigned int i = order[cur_particle];
+                m_cell_particles[fill[m_cell_of[i]]++] = i;
+                }
+
+            // group the cells into sets of non-adjacent cells
+            m_set_of_cell.resize(n_cells);
+            m_sets.resize(getNumSets());
+            for (unsigned int s = 0; s < getNumSets(); s++)
+                m_sets[s].clear();
+
+            for (unsigned int k = 0; k < m_dim.z; k++)
+                for (unsigned int j = 0; j < m_dim.y; j++)
+                    for (unsigned int i = 0; i < m_dim.x; i++)
+                        {
+                        unsigned int c = m_cell_indexer(i,j,k);
+                        m_set_of_cell[c] = getSet(i,j,k);
+                        if (m_cell_start[c+1] != m_cell_start[c])
+                            m_sets[m_set_of_cell[c]].push_back(c);
+                        }
+            }
+
+        //! Get the non-empty cells in a set
+        const std::vector<unsigned int>& getCellsInSet(unsigned int set) const
+            {
+            return m_sets[set];
+            }
+
+        //! Get the first particle in a cell
+        const unsigned int *beginCell(unsigned int cell) const
+            {
+            return m_cell_particles.data() + m_cell_start[cell];
+            }
+
+        //! Get one past the last particle in a cell
+        const unsigned int *endCell(unsigned int cell) const
+            {
+            return m_cell_particles.data() + m_cell_start[cell+1];
+            }
+
+        //! Get the cell particle i was binned into
+        unsigned int getCellOf(unsigned int i) const
+            {
+            return m_cell_of[i];
+            }
+
+        //! Set the set of cells that is currently being updated
+        void setActiveSet(unsigned int set)
+            {
+            m_active_set = set;
+            }
+
+        //! Test if particle j is being moved concurrently by a different cell than particle i
+        /*! Such a particle is at least one cell width away from particle i and can be ignored. Ghost particles
+            (j >= N) are never moved.
+        */
+        bool isMovedElsewhere(unsigned int i, unsigned int j) const
+            {
+            if (j >= m_cell_of.size())
+                return false;
+
+            unsigned int cell_j = m_cell_of[j];
+            return cell_j != m_cell_of[i] && m_set_of_cell[cell_j] == m_active_set;
+            }
+
+    private:
+        BoxDim m_box;                                 //!< Local simulation box
+        uint3 m_dim;                                  //!< Number of cells along each direction
+        Scalar3 m_shift;                              //!< Grid shift in units of the cell width
+        Index3D m_cell_indexer;                       //!< Indexes the cells
+        unsigned int m_active_set;                    //!< Set of cells currently being updated
+
+        std::vector<unsigned int> m_cell_of;          //!< Cell of each local particle
+        std::vector<unsigned int> m_cell_start;       //!< Offset of each cell in m_cell_particles
+        std::vector<unsigned int> m_cell_particles;   //!< Particle indices sorted by cell
+        std::vector<unsigned int> m_set_of_cell;      //!< Set that each cell belongs to
+        std::vector< std::vector<unsigned int> > m_sets; //!< Non-empty cells in each set
+
+        //! Number of cells along one direction
+        /*! An even number is required so that the checkerboard is consistent across periodic boundaries.
+        */
+        static unsigned int computeDim(Scalar npd, Scalar width)
+            {
+            if (width <= Scalar(0.0))
+                return 1;
+
+            unsigned int n = 2*(unsigned int)(npd / (Scalar(2.0)*width));
+            return (n >= 2) ? n : 1;
+            }
+
+        //! Wrap a cell coordinate into the grid
+        static int wrap(int i, unsigned int n)
+            {
+            int r = i % int(n);
+            return (r < 0) ? r + int(n) : r;
+            }
+
+        //! Get the set of a cell
+        static unsigned int getSet(unsigned int i, unsigned int j, unsigned int k)
+            {
+            return (i & 1) + 2*(j & 1) + 4*(k & 1);
+            }
+    };
+
 }; // end namespace detail
 
 //! HPMC on systems of mono-disperse shapes
@@ -154,6 +346,35 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Set elements of the interaction matrix
         virtual void setOverlapChecks(unsigned int typi, unsigned int typj, bool check_overlaps);
 
+        //! Enable or disable threaded trial moves on the CPU
+        /*! \param threaded True if independent cells should be swept concurrently by the TBB threads
+
+            Threaded execution requires a build with TBB. It is not used when an external field is set.
+        */
+        virtual void setThreaded(bool threaded)
+            {
+            #ifndef ENABLE_TBB
+            if (threaded)
+                {
+                m_exec_conf->msg->warning() << "hpmc: HOOMD was compiled without TBB, ignoring request for threaded execution" << std::endl;
+                threaded = false;
+                }
+            #endif
+            m_threaded = threaded;
+            m_aabb_tree_invalid = true;
+            }
+
+        //! Set the skin of the Verlet list
+        /*! \param skin Particles within the interaction range plus \a skin are cached as candidate neighbors and trial
+                        moves only test the cached particles. Set to 0 to search the AABB tree in every trial move.
+        */
+        virtual void setVerletSkin(Scalar skin)
+            {
+            m_verlet_skin = skin;
+            m_verlet_list_invalid = true;
+            m_aabb_tree_invalid = true;
+            }
+
         //! Set the external field for the integrator
         void setExternalField(std::shared_ptr< ExternalFieldMono<Shape> > external)
             {
@@ -283,6 +504,7 @@ class IntegratorHPMCMono : public IntegratorHPMC
                 m_comm->exchangeGhosts();
 
                 m_aabb_tree_invalid = true;
+                m_verlet_list_invalid = true;
                 }
             #endif
             }
@@ -312,7 +534,20 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange();
 
-        void invalidateAABBTree(){ m_aabb_tree_invalid = true; }
+        void invalidateAABBTree()
+            {
+            m_aabb_tree_invalid = true;
+            m_verlet_list_invalid = true;
+            }
+
+        //! Set the relative growth of the AABB tree surface area that triggers a rebuild
+        /*! \param threshold Rebuild the tree when refitting grows its total surface area by more than this factor.
+                             Set to 0 to rebuild the tree every time particles have moved.
+        */
+        void setAABBTreeRefitThreshold(Scalar threshold)
+            {
+            m_aabb_tree_refit_threshold = threshold;
+            }
 
         //! Method that is called whenever the GSD file is written if connected to a GSD file.
         int slotWriteGSDState(gsd_handle&, std::string name) const;
@@ -362,12 +597,30 @@ class IntegratorHPMCMono : public IntegratorHPMC
         bool m_image_list_warning_issued;                    //!< True if the image list warning has been issued
         bool m_hkl_max_warning_issued;                       //!< True if the image list size warning has been issued
         bool m_hasOrientation;                               //!< true if there are any orientable particles in the system
+        bool m_threaded;                                     //!< true if trial moves are performed by multiple threads
+        detail::CheckerboardGrid m_checkerboard;             //!< Independent cells for threaded trial moves
+        std::vector<unsigned int> m_cell_set_order;          //!< Update order for the checkerboard cell sets
 
         std::shared_ptr< ExternalFieldMono<Shape> > m_external;//!< External Field
         detail::AABBTree m_aabb_tree;               //!< Bounding volume hierarchy for overlap checks
         detail::AABB* m_aabbs;                      //!< list of AABBs, one per particle
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
+        bool m_aabb_tree_stale;                     //!< Flag if particles moved since the aabb tree was last fit
+        Scalar m_aabb_tree_refit_threshold;         //!< Rebuild when the tree surface area grows by this factor
+        Scalar m_aabb_tree_build_area;              //!< Surface area of the tree after the last full build
+        unsigned int m_aabb_tree_builds;            //!< Number of full tree builds since the last resetStats()
+        unsigned int m_aabb_tree_refits;            //!< Number of tree refits since the last resetStats()
+
+        Scalar m_verlet_skin;                       //!< Skin of the Verlet list, 0 if disabled
+        bool m_verlet_list_invalid;                 //!< Flag if the Verlet list has been invalidated
+        Scalar m_verlet_width;                      //!< Interaction range the Verlet list was built for
+        std::vector<unsigned int> m_verlet_head;    //!< First entry of each local particle in the Verlet list (N+1 entries)
+        std::vector<unsigned int> m_verlet_nbr;     //!< Neighbor index of each Verlet list entry
+        std::vector<int3> m_verlet_shift;           //!< Periodic image of the neighbor in each Verlet list entry
+        std::vector< vec3<Scalar> > m_verlet_pos;   //!< Particle positions when the Verlet list was built
+        std::vector<int3> m_verlet_image;           //!< Particle image flags when the Verlet list was built
+        unsigned int m_verlet_builds;               //!< Number of Verlet list builds since the last resetStats()
 
         Scalar m_extra_image_width;                 //! Extra width to extend the image list
 
@@ -382,6 +635,38 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Limit the maximum move distances
         virtual void limitMoveDistances();
 
+        //! Test if particles may move too far during this step to be covered by the Verlet list
+        bool verletDistanceCheck();
+
+        //! Build the Verlet list from the AABB tree
+        void buildVerletList();
+
+        //! Get the periodic image of a Verlet list entry
+        /*! \param k Index of the entry
+            \param i Particle owning the entry
+            \param h_image Current image flags of the particles
+            \param box Simulation box
+            \param primary Set to true when the neighbor is in the same image as \a i
+
+            The image is added to the position of \a i, like the entries of the image list. The shift stored in the
+            list is relative to the positions at build time, so it is corrected by the change in the image flags of
+            both particles from wrapping them back into the box since then.
+        */
+        inline vec3<Scalar> getVerletImage(unsigned int k, unsigned int i, const int3 *h_image, const BoxDim& box,
+            bool& primary) const
+            {
+            unsigned int j = m_verlet_nbr[k];
+            int3 shift = m_verlet_shift[k];
+            shift.x += (h_image[i].x - m_verlet_image[i].x) - (h_image[j].x - m_verlet_image[j].x);
+            shift.y += (h_image[i].y - m_verlet_image[i].y) - (h_image[j].y - m_verlet_image[j].y);
+            shift.z += (h_image[i].z - m_verlet_image[i].z) - (h_image[j].z - m_verlet_image[j].z);
+
+            primary = (shift.x == 0 && shift.y == 0 && shift.z == 0);
+            return Scalar(shift.x)*vec3<Scalar>(box.getLatticeVector(0))
+                + Scalar(shift.y)*vec3<Scalar>(box.getLatticeVector(1))
+                + Scalar(shift.z)*vec3<Scalar>(box.getLatticeVector(2));
+            }
+
         //! callback so that the box change signal can invalidate the image list
         virtual void slotBoxChanged()
             {
@@ -390,12 +675,14 @@ class IntegratorHPMCMono : public IntegratorHPMC
             // anything that changes the box (i.e. NPT, box_resize) is also moving the particles,
             // so use it as a sign to rebuild the AABB tree
             m_aabb_tree_invalid = true;
+            m_verlet_list_invalid = true;
             }
 
         //! callback so that the particle sort signal can invalidate the AABB tree
         virtual void slotSorted()
             {
             m_aabb_tree_invalid = true;
+            m_verlet_list_invalid = true;
             }
     };
 
@@ -407,6 +694,7 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
               m_image_list_is_initialized(false),
               m_image_list_valid(false),
               m_hasOrientation(true),
+              m_threaded(false),
               m_extra_image_width(0.0)
     {
     // allocate the parameter storage
@@ -432,6 +720,16 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     m_aabbs = NULL;
     m_aabbs_capacity = 0;
     m_aabb_tree_invalid = true;
+    m_aabb_tree_stale = false;
+    m_aabb_tree_refit_threshold = 1.25;
+    m_aabb_tree_build_area = 0.0;
+    m_aabb_tree_builds = 0;
+    m_aabb_tree_refits = 0;
+
+    m_verlet_skin = 0.0;
+    m_verlet_list_invalid = true;
+    m_verlet_width = 0.0;
+    m_verlet_builds = 0;
     }
 
 
@@ -489,6 +787,17 @@ void IntegratorHPMCMono<Shape>::printStats()
     {
     IntegratorHPMC::printStats();
 
+    unsigned int n_fits = m_aabb_tree_builds + m_aabb_tree_refits;
+    if (n_fits > 0)
+        {
+        m_exec_conf->msg->notice(2) << "AABB tree builds:              " << m_aabb_tree_builds << "\n";
+        m_exec_conf->msg->notice(2) << "AABB tree refits:              " << m_aabb_tree_refits << "\n";
+        m_exec_conf->msg->notice(2) << "AABB tree rebuild fraction:    " << double(m_aabb_tree_builds) / double(n_fits) << std::endl;
+        }
+
+    if (m_verlet_skin > Scalar(0.0))
+        m_exec_conf->msg->notice(2) << "Verlet list builds:            " << m_verlet_builds << std::endl;
+
     /*unsigned int max_height = 0;
     unsigned int total_height = 0;
 
@@ -508,6 +817,9 @@ template <class Shape>
 void IntegratorHPMCMono<Shape>::resetStats()
     {
     IntegratorHPMC::resetStats();
+    m_aabb_tree_builds = 0;
+    m_aabb_tree_refits = 0;
+    m_verlet_builds = 0;
     }
 
 template <class Shape>
@@ -542,7 +854,7 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
 
     // get needed vars
     ArrayHandle<hpmc_counters_t> h_counters(m_count_total, access_location::host, access_mode::readwrite);
-    hpmc_counters_t& counters = h_counters.data[0];
+    hpmc_counters_t& counters_total = h_counters.data[0];
     const BoxDim& box = m_pdata->getBox();
     unsigned int ndim = this->m_sysdef->getNDimensions();
 
@@ -563,6 +875,11 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     // update the image list
     updateImageList();
 
+    // rebuild the Verlet list if particles may move out of its skin during this step
+    bool use_verlet = m_verlet_skin > Scalar(0.0);
+    if (use_verlet && verletDistanceCheck())
+        buildVerletList();
+
     if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC update");
 
     if( m_external ) // I think we need this here otherwise I don't think it will get called.
@@ -573,6 +890,21 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // circumsphere diameters for the batched overlap pre-check
+    std::vector<OverlapReal> circumsphere_diameter(m_pdata->getNTypes());
+    for (unsigned int typ = 0; typ < m_pdata->getNTypes(); typ++)
+        {
+        Shape temp(quat<Scalar>(), m_params[typ]);
+        circumsphere_diameter[typ] = temp.getCircumsphereDiameter();
+        }
+
+    #ifdef ENABLE_TBB
+    // sweep independent cells concurrently, external fields are only evaluated serially
+    bool threaded = m_threaded && !m_external;
+    tbb::enumerable_thread_specific<hpmc_counters_t> thread_counters;
+    tbb::enumerable_thread_specific< std::vector< std::pair<unsigned int, OverlapReal> > > thread_tree_updates;
+    #endif
+
     // loop over local particles nselect times
     for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
         {
@@ -581,16 +913,23 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
         ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
         ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
 
         //access move sizes
         ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
         ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
 
-        // loop through N particles in a shuffled order
-        for (unsigned int cur_particle = 0; cur_particle < m_pdata->getN(); cur_particle++)
-            {
-            unsigned int i = m_update_order[cur_particle];
+        // largest possible displacement of a particle in one trial move
+        Scalar d_max = 0.0;
+        for (unsigned int typ = 0; typ < m_pdata->getNTypes(); typ++)
+            d_max = std::max(d_max, h_d.data[typ]);
 
+        // performs a trial move of particle i
+        // when cb is set, the move is confined to the cell of particle i and particles moved concurrently in other
+        // cells are skipped. Accepted moves append to tree_updates instead of updating the AABB tree, if set.
+        auto trial_move = [&](unsigned int i, hpmc_counters_t& counters, const detail::CheckerboardGrid *cb,
+                              std::vector< std::pair<unsigned int, OverlapReal> > *tree_updates)
+            {
             // read in the current position and orientation
             Scalar4 postype_i = h_postype.data[i];
             Scalar4 orientation_i = h_orientation.data[i];
@@ -601,7 +940,7 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                 {
                 // only move particle if active
                 if (!isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z), box, ghost_fraction))
-                    continue;
+                    return;
                 }
             #endif
 
@@ -622,7 +961,7 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                     {
                     if (!shape_i.ignoreStatistics())
                         counters.translate_accept_count++;
-                    continue;
+                    return;
                     }
 
                 move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
@@ -632,9 +971,17 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                     {
                     // check if particle has moved into the ghost layer, and skip if it is
                     if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
-                        continue;
+                        return;
                     }
                 #endif
+
+                // in threaded sweeps, the particle may not leave its cell
+                if (cb && cb->getCell(pos_i) != cb->getCellOf(i))
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.translate_reject_count++;
+                    return;
+                    }
                 }
             else
                 {
@@ -642,7 +989,7 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                     {
                     if (!shape_i.ignoreStatistics())
                         counters.rotate_accept_count++;
-                    continue;
+                    return;
                     }
 
                 move_rotate(shape_i.orientation, rng_i, h_a.data[typ_i], ndim);
@@ -662,110 +1009,219 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                 r_cut_patch-getMinCoreDiameter()/(OverlapReal)2.0);
             detail::AABB aabb_i_local = detail::AABB(vec3<Scalar>(0,0,0),R_query);
 
+            // in threaded sweeps, particles in the same cell may have moved since their tree entry was updated
+            detail::AABB aabb_i_query = cb ? detail::AABB(vec3<Scalar>(0,0,0),R_query+d_max) : aabb_i_local;
+
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
 
-            // check for overlaps with neighboring particle's positions (also calculate the new energy)
-            // All image boxes (including the primary)
-            const unsigned int n_images = m_image_list.size();
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+            // tests the trial configuration of i against particle j shifted by image, returns true on overlap.
+            // Otherwise, the patch energy of the new configuration is accumulated.
+            auto test_new = [&](unsigned int j, const vec3<Scalar>& image, bool primary) -> bool
                 {
-                vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
-                detail::AABB aabb = aabb_i_local;
-                aabb.translate(pos_i_image);
+                vec3<Scalar> pos_i_image = pos_i + image;
+                Scalar4 postype_j;
+                Scalar4 orientation_j;
 
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                // handle j==i situations
+                if ( j != i )
                     {
-                    if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                    // load the position and orientation of the j particle
+                    postype_j = h_postype.data[j];
+                    orientation_j = h_orientation.data[j];
+                    }
+                else
+                    {
+                    if (primary)
                         {
-                        if (m_aabb_tree.isNodeLeaf(cur_node_idx))
-                            {
-                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
-                                {
-                                // read in its position and orientation
-                                unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                        // in the first image, skip i == j
+                        return false;
+                        }
+                    else
+                        {
+                        // If this is particle i and we are in an outside image, use the translated position and orientation
+                        postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                        orientation_j = quat_to_scalar4(shape_i.orientation);
+                        }
+                    }
 
-                                Scalar4 postype_j;
-                                Scalar4 orientation_j;
+                // put particles in coordinate system of particle i
+                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
-                                // handle j==i situations
-                                if ( j != i )
-                                    {
-                                    // load the position and orientation of the j particle
-                                    postype_j = h_postype.data[j];
-                                    orientation_j = h_orientation.data[j];
-                                    }
-                                else
-                                    {
-                                    if (cur_image == 0)
-                                        {
-                                        // in the first image, skip i == j
-                                        continue;
-                                        }
-                                    else
-                                        {
-                                        // If this is particle i and we are in an outside image, use the translated position and orientation
-                                        postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
-                                        orientation_j = quat_to_scalar4(shape_i.orientation);
-                                        }
-                                    }
+                unsigned int typ_j = __scalar_as_int(postype_j.w);
+                Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
 
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                Scalar rcut = 0.0;
+                if (m_patch)
+                    rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
 
-                                unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+                counters.overlap_checks++;
+                if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                    {
+                    return true;
+                    }
+                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, calculate energy
+                    {
+                    // deltaU = U_old - U_new: subtract energy of new configuration
+                    patch_field_energy_diff -= m_patch->energy(r_ij, typ_i,
+                                               quat<float>(shape_i.orientation),
+                                               h_diameter.data[i],
+                                               h_charge.data[i],
+                                               typ_j,
+                                               quat<float>(orientation_j),
+                                               h_diameter.data[j],
+                                               h_charge.data[j]
+                                               );
+                    }
+                return false;
+                };
 
-                                Scalar rcut = 0.0;
-                                if (m_patch)
-                                    rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
+            // accumulates the patch energy of the old configuration of i with particle j shifted by image
+            auto add_old_energy = [&](unsigned int j, const vec3<Scalar>& image, bool primary)
+                {
+                vec3<Scalar> pos_i_image = pos_old + image;
+                Scalar4 postype_j;
+                Scalar4 orientation_j;
 
-                                counters.overlap_checks++;
-                                if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
-                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
-                                    {
-                                    overlap = true;
-                                    break;
-                                    }
-                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, calculate energy
-                                    {
-                                    // deltaU = U_old - U_new: subtract energy of new configuration
-                                    patch_field_energy_diff -= m_patch->energy(r_ij, typ_i,
-                                                               quat<float>(shape_i.orientation),
-                                                               h_diameter.data[i],
-                                                               h_charge.data[i],
-                                                               typ_j,
-                                                               quat<float>(orientation_j),
-                                                               h_diameter.data[j],
-                                                               h_charge.data[j]
-                                                               );
-                                    }
-                                }
-                            }
+                // handle j==i situations
+                if ( j != i )
+                    {
+                    // load the position and orientation of the j particle
+                    postype_j = h_postype.data[j];
+                    orientation_j = h_orientation.data[j];
+                    }
+                else
+                    {
+                    if (primary)
+                        {
+                        // in the first image, skip i == j
+                        return;
                         }
                     else
                         {
-                        // skip ahead
-                        cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                        // If this is particle i and we are in an outside image, use the translated position and orientation
+                        postype_j = make_scalar4(pos_old.x, pos_old.y, pos_old.z, postype_i.w);
+                        orientation_j = quat_to_scalar4(shape_old.orientation);
+                        }
+                    }
+
+                // put particles in coordinate system of particle i
+                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                unsigned int typ_j = __scalar_as_int(postype_j.w);
+                Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+
+                Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
+
+                // deltaU = U_old - U_new: add energy of old configuration
+                if (dot(r_ij,r_ij) <= rcut*rcut)
+                    patch_field_energy_diff += m_patch->energy(r_ij,
+                                               typ_i,
+                                               quat<float>(orientation_i),
+                                               h_diameter.data[i],
+                                               h_charge.data[i],
+                                               typ_j,
+                                               quat<float>(orientation_j),
+                                               h_diameter.data[j],
+                                               h_charge.data[j]);
+                };
+
+            const unsigned int n_images = m_image_list.size();
+
+            if (use_verlet && !(m_patch && !m_patch_log))
+                {
+                // without patch energies, only the cached neighbors with overlapping circumspheres need the narrow
+                // phase test. Gather packets of neighbors and check their circumspheres all at once.
+                const unsigned int packet_size = 32;
+                OverlapReal packet_dx[packet_size], packet_dy[packet_size], packet_dz[packet_size];
+                OverlapReal packet_diameter[packet_size];
+                unsigned int packet_k[packet_size];
+                unsigned int packet_hits[packet_size];
+
+                unsigned int k = m_verlet_head[i];
+                while (k < m_verlet_head[i+1] && !overlap)
+                    {
+                    unsigned int n_packet = 0;
+                    for (; k < m_verlet_head[i+1] && n_packet < packet_size; k++)
+                        {
+                        unsigned int j = m_verlet_nbr[k];
+                        if (cb && cb->isMovedElsewhere(i, j))
+                            continue;
+
+                        bool primary;
+                        vec3<Scalar> image = getVerletImage(k, i, h_image.data, box, primary);
+                        if (j == i && primary)
+                            continue;
+
+                        vec3<Scalar> pos_j = (j == i) ? pos_i : vec3<Scalar>(h_postype.data[j]);
+                        vec3<OverlapReal> r_ij(pos_j - (pos_i + image));
+                        packet_dx[n_packet] = r_ij.x;
+                        packet_dy[n_packet] = r_ij.y;
+                        packet_dz[n_packet] = r_ij.z;
+                        packet_diameter[n_packet] = circumsphere_diameter[__scalar_as_int(h_postype.data[j].w)];
+                        packet_k[n_packet] = k;
+                        n_packet++;
                         }
 
-                    if (overlap)
+                    unsigned int n_hits = check_circumsphere_overlap_batch(packet_dx, packet_dy, packet_dz,
+                        packet_diameter, circumsphere_diameter[typ_i], n_packet, packet_hits);
+                    counters.overlap_checks += n_packet - n_hits;
+
+                    for (unsigned int cur_hit = 0; cur_hit < n_hits; cur_hit++)
+                        {
+                        unsigned int k_hit = packet_k[packet_hits[cur_hit]];
+                        bool primary;
+                        vec3<Scalar> image = getVerletImage(k_hit, i, h_image.data, box, primary);
+                        if (test_new(m_verlet_nbr[k_hit], image, primary))
+                            {
+                            overlap = true;
+                            break;
+                            }
+                        }
+                    }
+                }
+            else if (use_verlet)
+                {
+                // check for overlaps with the cached neighbors (also calculate the new energy)
+                for (unsigned int k = m_verlet_head[i]; k < m_verlet_head[i+1]; k++)
+                    {
+                    unsigned int j = m_verlet_nbr[k];
+                    if (cb && cb->isMovedElsewhere(i, j))
+                        continue;
+
+                    bool primary;
+                    vec3<Scalar> image = getVerletImage(k, i, h_image.data, box, primary);
+                    if (test_new(j, image, primary))
+                        {
+                        overlap = true;
                         break;
-                    }  // end loop over AABB nodes
+                        }
+                    }
 
-                if (overlap)
-                    break;
-                } // end loop over images
+                // calculate old patch energy only if m_patch not NULL and no overlaps
+                if (m_patch && !m_patch_log && !overlap)
+                    {
+                    for (unsigned int k = m_verlet_head[i]; k < m_verlet_head[i+1]; k++)
+                        {
+                        unsigned int j = m_verlet_nbr[k];
+                        if (cb && cb->isMovedElsewhere(i, j))
+                            continue;
 
-            // calculate old patch energy only if m_patch not NULL and no overlaps
-            if (m_patch && !m_patch_log && !overlap)
+                        bool primary;
+                        vec3<Scalar> image = getVerletImage(k, i, h_image.data, box, primary);
+                        add_old_energy(j, image, primary);
+                        }
+                    }
+                }
+            else
                 {
+                // check for overlaps with neighboring particle's positions (also calculate the new energy)
+                // All image boxes (including the primary)
                 for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                     {
-                    vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
-                    detail::AABB aabb = aabb_i_local;
+                    vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+                    detail::AABB aabb = aabb_i_query;
                     aabb.translate(pos_i_image);
 
                     // stackless search
@@ -777,52 +1233,17 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                                 {
                                 for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
                                     {
-                                    // read in its position and orientation
                                     unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
 
-                                    Scalar4 postype_j;
-                                    Scalar4 orientation_j;
+                                    // particles moved concurrently in other cells are out of range
+                                    if (cb && cb->isMovedElsewhere(i, j))
+                                        continue;
 
-                                    // handle j==i situations
-                                    if ( j != i )
-                                        {
-                                        // load the position and orientation of the j particle
-                                        postype_j = h_postype.data[j];
-                                        orientation_j = h_orientation.data[j];
-                                        }
-                                    else
+                                    if (test_new(j, m_image_list[cur_image], cur_image == 0))
                                         {
-                                        if (cur_image == 0)
-                                            {
-                                            // in the first image, skip i == j
-                                            continue;
-                                            }
-                                        else
-                                            {
-                                            // If this is particle i and we are in an outside image, use the translated position and orientation
-                                            postype_j = make_scalar4(pos_old.x, pos_old.y, pos_old.z, postype_i.w);
-                                            orientation_j = quat_to_scalar4(shape_old.orientation);
-                                            }
+                                        overlap = true;
+                                        break;
                                         }
-
-                                    // put particles in coordinate system of particle i
-                                    vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
-                                    unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                    Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
-
-                                    Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
-
-                                    // deltaU = U_old - U_new: add energy of old configuration
-                                    if (dot(r_ij,r_ij) <= rcut*rcut)
-                                        patch_field_energy_diff += m_patch->energy(r_ij,
-                                                                   typ_i,
-                                                                   quat<float>(orientation_i),
-                                                                   h_diameter.data[i],
-                                                                   h_charge.data[i],
-                                                                   typ_j,
-                                                                   quat<float>(orientation_j),
-                                                                   h_diameter.data[j],
-                                                                   h_charge.data[j]);
                                     }
                                 }
                             }
@@ -831,9 +1252,52 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                             // skip ahead
                             cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
                             }
+
+                        if (overlap)
+                            break;
                         }  // end loop over AABB nodes
+
+                    if (overlap)
+                        break;
                     } // end loop over images
-                } // end if (m_patch)
+
+                // calculate old patch energy only if m_patch not NULL and no overlaps
+                if (m_patch && !m_patch_log && !overlap)
+                    {
+                    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                        {
+                        vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
+                        detail::AABB aabb = aabb_i_query;
+                        aabb.translate(pos_i_image);
+
+                        // stackless search
+                        for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                            {
+                            if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                                {
+                                if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                                    {
+                                    for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                        {
+                                        unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                        // particles moved concurrently in other cells are out of range
+                                        if (cb && cb->isMovedElsewhere(i, j))
+                                            continue;
+
+                                        add_old_energy(j, m_image_list[cur_image], cur_image == 0);
+                                        }
+                                    }
+                                }
+                            else
+                                {
+                                // skip ahead
+                                cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                                }
+                            }  // end loop over AABB nodes
+                        } // end loop over images
+                    } // end if (m_patch)
+                }
 
             // Add external energetic contribution
             if (m_external)
@@ -855,9 +1319,17 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                     }
 
                 // update the position of the particle in the tree for future updates
-                detail::AABB aabb = aabb_i_local;
-                aabb.translate(pos_i);
-                m_aabb_tree.update(i, aabb);
+                if (tree_updates)
+                    {
+                    // the tree is shared between threads, defer the update until the end of the pass
+                    tree_updates->push_back(std::make_pair(i, R_query));
+                    }
+                else
+                    {
+                    detail::AABB aabb = aabb_i_local;
+                    aabb.translate(pos_i);
+                    m_aabb_tree.update(i, aabb);
+                    }
 
                 // update position of particle
                 h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
@@ -878,9 +1350,81 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                         counters.rotate_reject_count++;
                     }
                 }
-            } // end loop over all particles
+            };
+
+        #ifdef ENABLE_TBB
+        if (threaded)
+            {
+            // shift the grid by a random fraction of a cell so that every cell boundary is eventually crossed
+            hoomd::RandomGenerator rng(hoomd::RNGIdentifier::HPMCMonoCheckerboard, m_seed, timestep,
+                m_exec_conf->getRank()*m_nselect + i_nselect);
+            Scalar3 shift;
+            shift.x = hoomd::detail::generate_canonical<Scalar>(rng);
+            shift.y = hoomd::detail::generate_canonical<Scalar>(rng);
+            shift.z = hoomd::detail::generate_canonical<Scalar>(rng);
+
+            // cells must be wider than the interaction range
+            m_checkerboard.setGrid(box, m_nominal_width, ndim, shift);
+            m_checkerboard.bin(h_postype.data, m_update_order, m_pdata->getN());
+
+            // visit the cell sets in a random permutation, drawn independently of the particle update order
+            hoomd::RandomGenerator rng_sets(hoomd::RNGIdentifier::HPMCMonoCheckerboardSets, m_seed, timestep,
+                m_exec_conf->getRank()*m_nselect + i_nselect);
+            const unsigned int n_sets = m_checkerboard.getNumSets();
+            m_cell_set_order.resize(n_sets);
+            for (unsigned int s = 0; s < n_sets; s++)
+                m_cell_set_order[s] = s;
+            for (unsigned int s = n_sets-1; s > 0; s--)
+                std::swap(m_cell_set_order[s], m_cell_set_order[hoomd::UniformIntDistribution(s)(rng_sets)]);
+
+            for (unsigned int cur_set = 0; cur_set < n_sets; cur_set++)
+                {
+                unsigned int set = m_cell_set_order[cur_set];
+                const std::vector<unsigned int>& cells = m_checkerboard.getCellsInSet(set);
+                m_checkerboard.setActiveSet(set);
+
+                // cells in the same set do not interact
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, cells.size()),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                    hpmc_counters_t& local_counters = thread_counters.local();
+                    std::vector< std::pair<unsigned int, OverlapReal> >& local_tree_updates = thread_tree_updates.local();
+
+                    for (unsigned int cur_cell = r.begin(); cur_cell != r.end(); ++cur_cell)
+                        {
+                        unsigned int cell = cells[cur_cell];
+                        for (const unsigned int *p = m_checkerboard.beginCell(cell); p != m_checkerboard.endCell(cell); ++p)
+                            trial_move(*p, local_counters, &m_checkerboard, &local_tree_updates);
+                        }
+                    });
+
+                // move the accepted particles in the tree before the next set is processed
+                for (auto it = thread_tree_updates.begin(); it != thread_tree_updates.end(); ++it)
+                    {
+                    for (const auto& update : *it)
+                        {
+                        detail::AABB aabb(vec3<Scalar>(h_postype.data[update.first]), update.second);
+                        m_aabb_tree.update(update.first, aabb);
+                        }
+                    it->clear();
+                    }
+                }
+            }
+        else
+        #endif
+            {
+            // loop through N particles in a shuffled order
+            for (unsigned int cur_particle = 0; cur_particle < m_pdata->getN(); cur_particle++)
+                trial_move(m_update_order[cur_particle], counters_total, NULL, NULL);
+            }
         } // end loop over nselect
 
+    #ifdef ENABLE_TBB
+    // reduce the counters of the individual threads
+    for (auto it = thread_counters.begin(); it != thread_counters.end(); ++it)
+        counters_total = counters_total + *it;
+    #endif
+
         {
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
         ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
@@ -926,8 +1470,8 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     // migrate and exchange particles
     communicate(true);
 
-    // all particle have been moved, the aabb tree is now invalid
-    m_aabb_tree_invalid = true;
+    // all particle have been moved, the aabb tree needs to be refit
+    m_aabb_tree_stale = true;
     }
 
 /*! \param timestep current step
@@ -1469,6 +2013,7 @@ void IntegratorHPMCMono<Shape>::updateCellWidth()
     // image list and aabb tree
     m_image_list_valid = false;
     m_aabb_tree_invalid = true;
+    m_verlet_list_invalid = true;
     }
 
 template <class Shape>
@@ -1499,6 +2044,10 @@ void IntegratorHPMCMono<Shape>::growAABBList(unsigned int N)
     this is on the next timestep. But in some cases (i.e. NPT), the tree may need to be rebuilt several times in a
     single step because of box volume moves.
 
+    When particles have only been displaced, without changing their order, set m_aabb_tree_stale instead. The existing
+    tree is then refit to the new positions, and only rebuilt when its total surface area has grown by more than a
+    factor of m_aabb_tree_refit_threshold since the last build.
+
     Subclasses that override update() or other methods must be user to set m_aabb_tree_invalid appropriately, or
     erroneous simulations will result.
 
@@ -1507,7 +2056,7 @@ void IntegratorHPMCMono<Shape>::growAABBList(unsigned int N)
 template <class Shape>
 const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
     {
-    if (m_aabb_tree_invalid)
+    if (m_aabb_tree_invalid || m_aabb_tree_stale)
         {
         m_exec_conf->msg->notice(8) << "Building AABB tree: " << m_pdata->getN() << " ptls " << m_pdata->getNGhosts() << " ghosts" << std::endl;
         if (this->m_prof) this->m_prof->push(this->m_exec_conf, "AABB tree build");
@@ -1527,16 +2076,39 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                     unsigned int typ_i = __scalar_as_int(h_postype.data[i].w);
                     Shape shape(quat<Scalar>(h_orientation.data[i]), m_params[typ_i]);
 
-                    if (!this->m_patch)
+                    if (!this->m_patch && !m_threaded && m_verlet_skin <= Scalar(0.0))
                         m_aabbs[i] = shape.getAABB(vec3<Scalar>(h_postype.data[i]));
                     else
                         {
-                        Scalar radius = std::max(0.5*shape.getCircumsphereDiameter(),
-                            0.5*this->m_patch->getAdditiveCutoff(typ_i));
+                        // threaded sweeps defer tree updates and require a bounding box that does not depend on
+                        // the orientation. The Verlet list build requires boxes centered on the particles.
+                        Scalar radius = 0.5*shape.getCircumsphereDiameter();
+                        if (this->m_patch)
+                            radius = std::max(radius, Scalar(0.5*this->m_patch->getAdditiveCutoff(typ_i)));
                         m_aabbs[i] = detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
                         }
                     }
-                m_aabb_tree.buildTree(m_aabbs, n_aabb);
+
+                // refit the existing tree if the particle list is unchanged
+                bool rebuild = m_aabb_tree_invalid || m_aabb_tree_refit_threshold <= Scalar(0.0)
+                    || m_aabb_tree.getNumParticles() != n_aabb;
+                if (!rebuild)
+                    {
+                    m_aabb_tree.refit(m_aabbs);
+
+                    // rebuild when the tree quality has degraded too far
+                    if (m_aabb_tree.getSurfaceArea() > m_aabb_tree_refit_threshold*m_aabb_tree_build_area)
+                        rebuild = true;
+                    else
+                        m_aabb_tree_refits++;
+                    }
+
+                if (rebuild)
+                    {
+                    m_aabb_tree.buildTree(m_aabbs, n_aabb);
+                    m_aabb_tree_build_area = m_aabb_tree.getSurfaceArea();
+                    m_aabb_tree_builds++;
+                    }
                 }
             }
 
@@ -1544,9 +2116,110 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
         }
 
     m_aabb_tree_invalid = false;
+    m_aabb_tree_stale = false;
     return m_aabb_tree;
     }
 
+/*! \returns true if the Verlet list must be rebuilt before the trial moves of this step
+
+    The Verlet list is valid as long as no particle has moved more than half the skin since it was built. Each of the
+    nselect trial moves in this step may displace a particle by up to the largest move size, so the list is rebuilt
+    when the displacement so far plus that bound exceeds half the skin.
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::verletDistanceCheck()
+    {
+    unsigned int N = m_pdata->getN();
+    if (m_verlet_list_invalid || m_verlet_width != m_nominal_width
+        || m_verlet_head.size() != N+1 || m_verlet_pos.size() != N+m_pdata->getNGhosts())
+        return true;
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+    const BoxDim& box = m_pdata->getBox();
+
+    Scalar d_max = 0.0;
+    for (unsigned int typ = 0; typ < m_pdata->getNTypes(); typ++)
+        d_max = std::max(d_max, h_d.data[typ]);
+
+    Scalar max_disp_sq = 0.0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        vec3<Scalar> dr = vec3<Scalar>(box.minImage(vec_to_scalar3(vec3<Scalar>(h_postype.data[i]) - m_verlet_pos[i])));
+        max_disp_sq = std::max(max_disp_sq, dot(dr,dr));
+        }
+
+    return sqrt(max_disp_sq) + Scalar(m_nselect)*d_max > m_verlet_skin/Scalar(2.0);
+    }
+
+/*! Every local particle caches the particles (local or ghost) and periodic images within the interaction range plus
+    the skin. The AABB tree and image list must be up to date when this method is called.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::buildVerletList()
+    {
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, "Verlet list build");
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+
+    unsigned int N = m_pdata->getN();
+    unsigned int n_all = N + m_pdata->getNGhosts();
+
+    // save the reference configuration
+    m_verlet_pos.resize(n_all);
+    m_verlet_image.resize(n_all);
+    for (unsigned int i = 0; i < n_all; i++)
+        {
+        m_verlet_pos[i] = vec3<Scalar>(h_postype.data[i]);
+        m_verlet_image[i] = h_image.data[i];
+        }
+
+    m_verlet_width = m_nominal_width;
+    Scalar r_list = m_nominal_width + m_verlet_skin;
+    Scalar r_list_sq = r_list*r_list;
+
+    m_verlet_head.resize(N+1);
+    m_verlet_nbr.clear();
+    m_verlet_shift.clear();
+
+    std::vector<unsigned int> hits;
+    const unsigned int n_images = m_image_list.size();
+    for (unsigned int i = 0; i < N; i++)
+        {
+        m_verlet_head[i] = m_verlet_nbr.size();
+
+        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+            {
+            vec3<Scalar> pos_i_image = m_verlet_pos[i] + m_image_list[cur_image];
+
+            // the tree holds boxes centered on the particles, so it finds every particle within r_list
+            hits.clear();
+            m_aabb_tree.query(hits, detail::AABB(pos_i_image, r_list));
+
+            for (unsigned int cur_hit = 0; cur_hit < hits.size(); cur_hit++)
+                {
+                unsigned int j = hits[cur_hit];
+                if (j == i && cur_image == 0)
+                    continue;
+
+                vec3<Scalar> r_ij = m_verlet_pos[j] - pos_i_image;
+                if (dot(r_ij,r_ij) <= r_list_sq)
+                    {
+                    m_verlet_nbr.push_back(j);
+                    m_verlet_shift.push_back(m_image_hkl[cur_image]);
+                    }
+                }
+            }
+        }
+    m_verlet_head[N] = m_verlet_nbr.size();
+
+    m_verlet_list_invalid = false;
+    m_verlet_builds++;
+
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
+    }
+
 /*! Call to reduce the m_d values down to safe levels for the bvh tree + small box limitations. That code path
     will not work if particles can wander more than one image in a time step.
 
@@ -1855,6 +2528,7 @@ template < class Shape > void export_IntegratorHPMCMono(pybind11::module& m, con
           .def("restoreStateGSD", &IntegratorHPMCMono<Shape>::restoreStateGSD)
           .def("py_test_overlap", &IntegratorHPMCMono<Shape>::py_test_overlap)
           .def("getTypeShapesPy", &IntegratorHPMCMono<Shape>::getTypeShapesPy)
+          .def("setAABBTreeRefitThreshold", &IntegratorHPMCMono<Shape>::setAABBTreeRefitThreshold)
           ;
     }
 
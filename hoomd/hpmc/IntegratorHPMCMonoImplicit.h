@@ -815,8 +815,8 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
     // migrate and exchange particles
     this->communicate(true);
 
-    // all particle have been moved, the aabb tree is now invalid
-    this->m_aabb_tree_invalid = true;
+    // all particle have been moved, the aabb tree needs to be refit
+    this->m_aabb_tree_stale = true;
     }
 
 
@@ -26,6 +26,9 @@
 #else
 #define DEVICE
 #define HOSTDEVICE
+#if defined (__SSE__)
+#include <immintrin.h>
+#endif
 #endif
 
 #define SMALL 1e-5
@@ -217,6 +220,84 @@ DEVICE inline bool check_circumsphere_overlap(const vec3<Scalar>& r_ab, const Sh
     return true;
     }
 
+#ifndef NVCC
+//! Check a packet of candidate neighbors for circumsphere overlap
+/*! \param dx x components of the vectors r_j - r_i from shape i to each candidate j
+    \param dy y components of the vectors r_j - r_i
+    \param dz z components of the vectors r_j - r_i
+    \param diameter Circumsphere diameters of the candidates
+    \param diameter_i Circumsphere diameter of shape i
+    \param n Number of candidates
+    \param hits Output list (with room for \a n entries) of the candidates whose circumspheres overlap with shape i
+    \returns The number of entries written to \a hits
+
+    This performs the test of check_circumsphere_overlap() on many candidates at once. The candidates are stored as a
+    structure of arrays and processed with AVX 8 (float) or 4 (double) at a time on the CPU. Only the candidates listed
+    in \a hits need the narrow phase test_overlap().
+
+    \ingroup shape
+*/
+inline unsigned int check_circumsphere_overlap_batch(const OverlapReal *dx, const OverlapReal *dy,
+    const OverlapReal *dz, const OverlapReal *diameter, OverlapReal diameter_i, unsigned int n, unsigned int *hits)
+    {
+    unsigned int n_hits = 0;
+    unsigned int k = 0;
+
+    #if defined(__AVX__) && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
+    __m256 four_v = _mm256_set1_ps(4.0f);
+    __m256 diameter_i_v = _mm256_set1_ps(diameter_i);
+    for (; k + 8 <= n; k += 8)
+        {
+        __m256 x_v = _mm256_loadu_ps(dx + k);
+        __m256 y_v = _mm256_loadu_ps(dy + k);
+        __m256 z_v = _mm256_loadu_ps(dz + k);
+        __m256 rsq_v = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x_v, x_v), _mm256_mul_ps(y_v, y_v)),
+                                     _mm256_mul_ps(z_v, z_v));
+        __m256 DaDb_v = _mm256_add_ps(diameter_i_v, _mm256_loadu_ps(diameter + k));
+
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_mul_ps(rsq_v, four_v), _mm256_mul_ps(DaDb_v, DaDb_v),
+                                                    _CMP_LE_OQ));
+        while (mask)
+            {
+            hits[n_hits++] = k + __builtin_ctz(mask);
+            mask &= mask - 1;
+            }
+        }
+    #elif defined(__AVX__)
+    __m256d four_v = _mm256_set1_pd(4.0);
+    __m256d diameter_i_v = _mm256_set1_pd(diameter_i);
+    for (; k + 4 <= n; k += 4)
+        {
+        __m256d x_v = _mm256_loadu_pd(dx + k);
+        __m256d y_v = _mm256_loadu_pd(dy + k);
+        __m256d z_v = _mm256_loadu_pd(dz + k);
+        __m256d rsq_v = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x_v, x_v), _mm256_mul_pd(y_v, y_v)),
+                                      _mm256_mul_pd(z_v, z_v));
+        __m256d DaDb_v = _mm256_add_pd(diameter_i_v, _mm256_loadu_pd(diameter + k));
+
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_mul_pd(rsq_v, four_v), _mm256_mul_pd(DaDb_v, DaDb_v),
+                                                    _CMP_LE_OQ));
+        while (mask)
+            {
+            hits[n_hits++] = k + __builtin_ctz(mask);
+            mask &= mask - 1;
+            }
+        }
+    #endif
+
+    // remaining candidates, or all of them without AVX
+    for (; k < n; k++)
+        {
+        OverlapReal rsq = dx[k]*dx[k] + dy[k]*dy[k] + dz[k]*dz[k];
+        OverlapReal DaDb = diameter_i + diameter[k];
+        if (rsq*OverlapReal(4.0) <= DaDb * DaDb)
+            hits[n_hits++] = k;
+        }
+
+    return n_hits;
+    }
+#endif
+
 //! Define the general overlap function
 /*! This is just a convenient spot to put this to make sure it is defined early
     \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
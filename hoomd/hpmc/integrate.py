@@ -391,7 +391,9 @@ class mode_hpmc(_integrator):
                    nR=None,
                    depletant_type=None,
                    ntrial=None,
-                   deterministic=None):
+                   deterministic=None,
+                   threaded=None,
+                   verlet_skin=None):
         R""" Changes parameters of an existing integration mode.
 
         Args:
@@ -404,6 +406,21 @@ class mode_hpmc(_integrator):
             ntrial (int): (if set) **Implicit depletants only**: Number of re-insertion attempts per overlapping depletant.
                 (Only supported with **depletant_mode='circumsphere'**)
             deterministic (bool): (if set) Make HPMC integration deterministic on the GPU by sorting the cell list.
+            threaded (bool): (if set) Perform trial moves in independent cells concurrently on the CPU.
+            verlet_skin (float): (if set) Skin of the cached neighbor list used by trial moves on the CPU, 0 to disable.
+
+        When *threaded* is True, the local box is divided into a checkerboard of cells at least one interaction range
+        wide and non-adjacent cells are swept concurrently with the threads set by :py:func:`hoomd.option.set_num_threads()`
+        or ``--nthreads``. Trial moves that take a particle out of its cell are rejected, and the grid is shifted randomly
+        every sweep to maintain detailed balance. Threaded execution requires HOOMD compiled with TBB. It has no effect
+        on the GPU, with implicit depletants, or when an external field is set.
+
+        When *verlet_skin* is greater than 0, HPMC caches for every particle the neighbors within the interaction
+        range plus *verlet_skin* and trial moves only test the cached neighbors instead of searching the AABB tree.
+        The list is rebuilt when a particle may have moved by more than half the skin by the end of the step, assuming
+        *nselect* moves of the largest size *d*, so choose *verlet_skin* several times larger than *nselect* times *d*.
+        Dense fluids of complex shapes benefit most. In MPI simulations the list is rebuilt every step. The Verlet list
+        has no effect on the GPU or with implicit depletants.
 
         .. note:: Simulations are only deterministic with respect to the same execution configuration (CPU or GPU) and
                   number of MPI ranks. Simulation output will not be identical if either of these is changed.
@@ -458,6 +475,15 @@ class mode_hpmc(_integrator):
         if deterministic is not None:
             self.cpp_integrator.setDeterministic(deterministic);
 
+        if threaded is not None:
+            if threaded and not _hoomd.is_TBB_available():
+                hoomd.context.msg.warning("HOOMD was compiled without thread support, ignoring request for threaded execution.\n");
+            else:
+                self.cpp_integrator.setThreaded(bool(threaded));
+
+        if verlet_skin is not None:
+            self.cpp_integrator.setVerletSkin(float(verlet_skin));
+
     def map_overlaps(self):
         R""" Build an overlap map of the system
 
@@ -0,0 +1,57 @@
+from __future__ import division, print_function
+from hoomd import *
+from hoomd import hpmc
+import unittest
+
+context.initialize()
+
+# Run threaded trial moves on dense systems and verify that no overlaps are introduced and that moves are both
+# accepted and rejected.
+
+class threaded_sphere(unittest.TestCase):
+    def setUp(self):
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.05), n=8);
+        self.mc = hpmc.integrate.sphere(seed=23, d=0.1);
+        self.mc.shape_param.set('A', diameter=1.0);
+        self.mc.set_params(threaded=True);
+
+    def test_overlaps(self):
+        run(100);
+        self.assertEqual(self.mc.count_overlaps(), 0);
+
+        counters = self.mc.get_counters();
+        self.assertGreater(counters['translate_acceptance'], 0);
+        self.assertLess(counters['translate_acceptance'], 1);
+
+    def test_nselect(self):
+        self.mc.set_params(nselect=4);
+        run(20);
+        self.assertEqual(self.mc.count_overlaps(), 0);
+
+    def tearDown(self):
+        del self.mc
+        del self.system
+        context.initialize();
+
+class threaded_cube(unittest.TestCase):
+    def setUp(self):
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.3), n=6);
+        self.mc = hpmc.integrate.convex_polyhedron(seed=42, d=0.1, a=0.1);
+        self.mc.shape_param.set('A', vertices=[(-0.5, -0.5, -0.5), (-0.5, -0.5, 0.5), (-0.5, 0.5, -0.5), (-0.5, 0.5, 0.5),
+                                               (0.5, -0.5, -0.5), (0.5, -0.5, 0.5), (0.5, 0.5, -0.5), (0.5, 0.5, 0.5)]);
+        self.mc.set_params(threaded=True);
+
+    def test_overlaps(self):
+        run(100);
+        self.assertEqual(self.mc.count_overlaps(), 0);
+
+        counters = self.mc.get_counters();
+        self.assertGreater(counters['rotate_acceptance'], 0);
+
+    def tearDown(self):
+        del self.mc
+        del self.system
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,66 @@
+from __future__ import division, print_function
+from hoomd import *
+from hoomd import hpmc
+import numpy
+import unittest
+
+context.initialize()
+
+# Trial moves that test the cached Verlet list neighbors must accept and reject exactly the same moves as trial moves
+# that search the AABB tree, so both produce the same trajectory.
+
+cube_verts = [(-0.5, -0.5, -0.5), (-0.5, -0.5, 0.5), (-0.5, 0.5, -0.5), (-0.5, 0.5, 0.5),
+              (0.5, -0.5, -0.5), (0.5, -0.5, 0.5), (0.5, 0.5, -0.5), (0.5, 0.5, 0.5)];
+
+class verlet_sphere(unittest.TestCase):
+    def simulate(self, verlet_skin, nselect=1):
+        system = init.create_lattice(unitcell=lattice.sc(a=1.05), n=5);
+        mc = hpmc.integrate.sphere(seed=7, d=0.05, nselect=nselect);
+        mc.shape_param.set('A', diameter=1.0);
+        mc.set_params(verlet_skin=verlet_skin);
+        run(200);
+
+        self.assertEqual(mc.count_overlaps(), 0);
+        snap = system.take_snapshot();
+
+        del mc
+        del system
+        context.initialize();
+        return snap
+
+    def test_trajectory(self):
+        ref = self.simulate(verlet_skin=0);
+        snap = self.simulate(verlet_skin=0.4);
+        numpy.testing.assert_array_equal(snap.particles.position, ref.particles.position);
+        numpy.testing.assert_array_equal(snap.particles.image, ref.particles.image);
+
+    def test_rebuild_every_step(self):
+        # the skin is too small to reuse the list between steps
+        ref = self.simulate(verlet_skin=0, nselect=4);
+        snap = self.simulate(verlet_skin=0.1, nselect=4);
+        numpy.testing.assert_array_equal(snap.particles.position, ref.particles.position);
+
+class verlet_cube(unittest.TestCase):
+    def simulate(self, verlet_skin):
+        system = init.create_lattice(unitcell=lattice.sc(a=1.3), n=4);
+        mc = hpmc.integrate.convex_polyhedron(seed=42, d=0.05, a=0.05);
+        mc.shape_param.set('A', vertices=cube_verts);
+        mc.set_params(verlet_skin=verlet_skin);
+        run(200);
+
+        self.assertEqual(mc.count_overlaps(), 0);
+        snap = system.take_snapshot();
+
+        del mc
+        del system
+        context.initialize();
+        return snap
+
+    def test_trajectory(self):
+        ref = self.simulate(verlet_skin=0);
+        snap = self.simulate(verlet_skin=0.5);
+        numpy.testing.assert_array_equal(snap.particles.position, ref.particles.position);
+        numpy.testing.assert_array_equal(snap.particles.orientation, ref.particles.orientation);
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,87 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <memory>
+
+#include "hoomd/hpmc/IntegratorHPMCMono.h"
+#include "hoomd/hpmc/ShapeSphere.h"
+#include "hoomd/hpmc/ShapeConvexPolyhedron.h"
+
+#include "hoomd/test/benchmark_util.h"
+
+using namespace std;
+using namespace hpmc;
+using namespace hpmc::detail;
+
+/*! \file benchmark_hpmc.cc
+    \brief Benchmarks the IntegratorHPMCMono sweep for spheres and convex polyhedra
+    \ingroup unit_tests
+*/
+HOOMD_BENCHMARK_MAIN("hpmc");
+
+//! Number of trial moves per particle in one call to update()
+const unsigned int nselect = 4;
+
+//! Benchmark the sweep of one integrator
+/*! The reported time is per call to update(), i.e. per nselect trial moves per particle.
+*/
+template <class Shape>
+void benchmark_sweep(BenchmarkRunner& runner,
+                     const std::string& name,
+                     const typename Shape::param_type& param,
+                     unsigned int N,
+                     Scalar density,
+                     Scalar verlet_skin)
+    {
+    std::shared_ptr<SystemDefinition> sysdef = make_lattice_system(N, density, runner.getExecConf());
+
+    std::shared_ptr< IntegratorHPMCMono<Shape> > mc(new IntegratorHPMCMono<Shape>(sysdef, 12345));
+    mc->setParam(0, param);
+    mc->setNSelect(nselect);
+    mc->setD(Scalar(0.05), 0);
+    mc->setA(Scalar(0.05), 0);
+    mc->setVerletSkin(verlet_skin);
+
+    unsigned int timestep = 0;
+    runner.measure(name, N, density,
+        [mc, &timestep, &runner](unsigned int num_iters)
+            {
+            return benchmark_calls([mc, &timestep]() { mc->update(timestep++); },
+                                   num_iters, runner.getExecConf());
+            });
+    }
+
+void run_benchmarks(BenchmarkRunner& runner)
+    {
+    sph_params sphere;
+    sphere.radius = OverlapReal(0.5);
+    sphere.ignore = 0;
+    sphere.isOriented = false;
+
+    // cube with edge length 0.7, small enough not to overlap on the initial lattice
+    poly3d_verts cube(8, false);
+    OverlapReal h = OverlapReal(0.35);
+    for (unsigned int i = 0; i < 8; i++)
+        {
+        cube.x[i] = (i & 1) ? h : -h;
+        cube.y[i] = (i & 2) ? h : -h;
+        cube.z[i] = (i & 4) ? h : -h;
+        }
+    cube.diameter = OverlapReal(2.0) * sqrt(OverlapReal(3.0)) * h;
+    cube.ignore = 0;
+
+    for (unsigned int N : runner.getN())
+        for (Scalar density : runner.getDensities())
+            {
+            benchmark_sweep<ShapeSphere>(runner, "IntegratorHPMCMono<ShapeSphere>::update",
+                sphere, N, density, Scalar(0.0));
+            benchmark_sweep<ShapeSphere>(runner, "IntegratorHPMCMono<ShapeSphere>::update (Verlet list)",
+                sphere, N, density, Scalar(0.3));
+            benchmark_sweep<ShapeConvexPolyhedron>(runner, "IntegratorHPMCMono<ShapeConvexPolyhedron>::update",
+                cube, N, density, Scalar(0.0));
+            }
+    }
@@ -106,3 +106,137 @@ UP_TEST( bigger )
         UP_ASSERT(in(i, hits));
         }
     }
+
+UP_TEST( refit )
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(2);
+
+    std::vector< vec3<Scalar> > points(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng))
+                                  * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+    UP_ASSERT_EQUAL(tree.getNumParticles(), N);
+    Scalar build_area = tree.getSurfaceArea();
+
+    // move all the points and refit the tree with the new AABBs (buildTree reorders the input list)
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] += vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng),
+                                  hoomd::detail::generate_canonical<float>(rng));
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+    tree.refit(aabbs);
+
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+
+    // small displacements only change the tree quality slightly
+    UP_ASSERT(tree.getSurfaceArea() < Scalar(1.5)*build_area);
+
+    // refitting to smaller AABBs shrinks the nodes, which update() can not do
+    for (unsigned int i = 0; i < N; i++)
+        aabbs[i] = AABB(points[i], Scalar(0.5));
+    tree.refit(aabbs);
+    UP_ASSERT(tree.getSurfaceArea() < build_area);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+    }
+
+UP_TEST( clustered )
+    {
+    // two dense clusters far apart, large enough to exercise the concurrent build
+    const unsigned int N = 8192;
+    hoomd::RandomGenerator rng(3);
+
+    std::vector< vec3<Scalar> > points(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        vec3<Scalar> origin = (i % 2 == 0) ? vec3<Scalar>(0,0,0) : vec3<Scalar>(1000,0,0);
+        points[i] = origin + vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                          hoomd::detail::generate_canonical<float>(rng),
+                                          hoomd::detail::generate_canonical<float>(rng))
+                                          * Scalar(20);
+        aabbs[i] = AABB(points[i], Scalar(0.5));
+        }
+
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+
+    // every particle is stored in exactly one leaf
+    std::vector<unsigned int> count(N, 0);
+    for (unsigned int node = 0; node < tree.getNumNodes(); node++)
+        {
+        UP_ASSERT(tree.getNodeNumParticles(node) <= NODE_CAPACITY);
+        for (unsigned int j = 0; j < tree.getNodeNumParticles(node); j++)
+            count[tree.getNodeParticle(node, j)]++;
+        }
+
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        UP_ASSERT_EQUAL(count[i], 1);
+
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+
+    // the root splits the clusters, so the gap between them is not covered by any child
+    hits.clear();
+    tree.query(hits, AABB(vec3<Scalar>(500,10,10), Scalar(1.0)));
+    UP_ASSERT_EQUAL(hits.size(), 0);
+
+    // queries of all sizes in and around both clusters find every overlapping AABB, buildTree() reorders aabbs so
+    // the brute force check uses the points
+    for (unsigned int q = 0; q < 200; q++)
+        {
+        Scalar origin = (q % 2 == 0) ? Scalar(0) : Scalar(1000);
+        vec3<Scalar> center(origin + hoomd::detail::generate_canonical<float>(rng) * Scalar(30) - Scalar(5),
+                            hoomd::detail::generate_canonical<float>(rng) * Scalar(30) - Scalar(5),
+                            hoomd::detail::generate_canonical<float>(rng) * Scalar(30) - Scalar(5));
+        AABB query(center, hoomd::detail::generate_canonical<float>(rng) * Scalar(10));
+
+        std::vector<unsigned int> expected;
+        for (unsigned int i = 0; i < N; i++)
+            {
+            if (overlap(AABB(points[i], Scalar(0.5)), query))
+                expected.push_back(i);
+            }
+
+        hits.clear();
+        tree.query(hits, query);
+        std::sort(hits.begin(), hits.end());
+        UP_ASSERT(std::includes(hits.begin(), hits.end(), expected.begin(), expected.end()));
+        }
+
+    // coincident particles can not be separated by a plane, but must still be stored
+    for (unsigned int i = 0; i < 100; i++)
+        aabbs[i] = AABB(vec3<Scalar>(1,2,3), Scalar(0.5));
+    tree.buildTree(aabbs, 100);
+
+    hits.clear();
+    tree.query(hits, AABB(vec3<Scalar>(1,2,3), Scalar(0.01)));
+    UP_ASSERT_EQUAL(hits.size(), 100);
+    }
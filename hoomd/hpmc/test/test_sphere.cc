@@ -109,3 +109,37 @@ UP_TEST( overlap_boundaries )
     UP_ASSERT(test_overlap(rij,a,c,err_count));
     UP_ASSERT(test_overlap(-rij,c,a,err_count));
     }
+
+UP_TEST( overlap_batch )
+    {
+    // candidates at increasing distance, with a count that is not a multiple of the SIMD width
+    const unsigned int n = 37;
+    OverlapReal dx[n], dy[n], dz[n], diameter[n];
+    for (unsigned int k = 0; k < n; k++)
+        {
+        dx[k] = OverlapReal(0.1)*k*cos(OverlapReal(k));
+        dy[k] = OverlapReal(0.1)*k*sin(OverlapReal(k));
+        dz[k] = OverlapReal(0.05)*k - OverlapReal(0.5);
+        diameter[k] = OverlapReal(0.5) + OverlapReal(k % 5)*OverlapReal(0.25);
+        }
+
+    unsigned int hits[n];
+    unsigned int n_hits = check_circumsphere_overlap_batch(dx, dy, dz, diameter, OverlapReal(2.0), n, hits);
+
+    // compare with the one at a time test
+    unsigned int n_expected = 0;
+    for (unsigned int k = 0; k < n; k++)
+        {
+        OverlapReal rsq = dx[k]*dx[k] + dy[k]*dy[k] + dz[k]*dz[k];
+        OverlapReal DaDb = OverlapReal(2.0) + diameter[k];
+        if (rsq*OverlapReal(4.0) <= DaDb*DaDb)
+            {
+            UP_ASSERT(n_expected < n_hits);
+            UP_ASSERT_EQUAL(hits[n_expected], k);
+            n_expected++;
+            }
+        }
+    UP_ASSERT_EQUAL(n_hits, n_expected);
+    UP_ASSERT(n_hits > 0);
+    UP_ASSERT(n_hits < n);
+    }
@@ -250,7 +250,7 @@ def read_snapshot(snapshot):
     _perform_common_init_tasks();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
-def read_gsd(filename, restart = None, frame = 0, time_step = None):
+def read_gsd(filename, restart = None, frame = 0, time_step = None, parallel = False):
     R""" Read initial system state from an GSD file.
 
     Args:
@@ -258,6 +258,7 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
         restart (str): If it exists, read the file *restart* instead of *filename*.
         frame (int): Index of the frame to read from the GSD file. Negative values index from the end of the file.
         time_step (int): (if specified) Time step number to initialize instead of the one stored in the GSD file.
+        parallel (bool): When True, read the particles on all MPI ranks (added in version 2.9).
 
     All particles, bonds, angles, dihedrals, impropers, constraints, and box information
     are read from the given GSD file at the given frame index. To read and write GSD files
@@ -273,6 +274,12 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     The result of :py:func:`hoomd.init.read_gsd` can be saved in a variable and later used to read and/or
     change particle properties later in the script. See :py:mod:`hoomd.data` for more information.
 
+    In MPI simulations, the root rank reads the whole frame and scatters the particles to the other ranks. With
+    *parallel=True*, every rank reads a contiguous slice of the particles from the file and sends each particle to
+    the rank whose domain holds it, so that no rank holds all particles. Use it to restart large simulations, it
+    requires a file system where all ranks can read *filename* at the same path. Topology, and chunks written with
+    ``dump.gsd(precision=...)``, are still read on the root rank.
+
     See Also:
         :py:class:`hoomd.dump.gsd`
     """
@@ -288,10 +295,10 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     restart = _hoomd.mpi_bcast_str(restart, hoomd.context.exec_conf);
 
     if restart is not None and os.path.exists(restart):
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, abs(frame), frame < 0, parallel);
         time_step = reader.getTimeStep();
     else:
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0);
+        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0, parallel);
         if time_step is None:
             time_step = reader.getTimeStep();
 
@@ -301,7 +308,9 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     snapshot._broadcast_box(hoomd.context.exec_conf);
     my_domain_decomposition = _create_domain_decomposition(snapshot._global_box);
 
-    if my_domain_decomposition is not None:
+    if reader.isParallel():
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(reader, hoomd.context.exec_conf, my_domain_decomposition);
+    elif my_domain_decomposition is not None:
         hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf, my_domain_decomposition);
     else:
         hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf);
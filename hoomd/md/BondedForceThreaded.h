@@ -0,0 +1,97 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BondedForceThreaded.h
+    \brief Defines a helper that computes bonded forces per particle on the TBB threads
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __BONDED_FORCE_THREADED_H__
+#define __BONDED_FORCE_THREADED_H__
+
+#include "hoomd/BondedGroupData.h"
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+
+//! Compute the forces of bonded groups on each particle, distributing the particles over the TBB threads
+/*! \param gdata Bonded group data
+    \param n Number of particles (starting at index 0) to compute the force on
+    \param h_force Force array to write
+    \param h_virial Virial array to write
+    \param virial_pitch Pitch of the virial array
+    \param eval Evaluates a single group
+
+    \a eval is called as eval(idx, type, f, energy, virial) with the particle indices \a idx of the group members in
+    group order and the group \a type. It returns the force on each member in \a f and the share of the group energy
+    and virial of a single member.
+
+    Each particle loops over the groups it belongs to with the group-by-particle lookup table of \a gdata, the same
+    table that the GPU kernels use, and writes only its own force and virial. No two threads write to the same element
+    and no per-thread buffers are needed, at the cost of evaluating every group once per member. The table is rebuilt
+    after the particles are sorted and after the groups change.
+
+    Request the lookup table (e.g. with getGPUTableIndexer()) before acquiring the particle rtags, since rebuilding it
+    accesses them.
+*/
+template<class group_data, class Eval>
+void computeBondedForcesThreaded(group_data& gdata,
+                                 unsigned int n,
+                                 Scalar4 *h_force,
+                                 Scalar *h_virial,
+                                 unsigned int virial_pitch,
+                                 const Eval& eval)
+    {
+    const unsigned int group_size = group_data::size;
+
+    const Index2D& table_indexer = gdata.getGPUTableIndexer();
+    ArrayHandle<typename group_data::members_t> h_table(gdata.getGPUTable(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_pos_table(gdata.getGPUPosTable(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_groups(gdata.getNGroupsArray(), access_location::host, access_mode::read);
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        unsigned int idx[group_size];
+        Scalar3 f[group_size];
+        Scalar group_virial[6];
+
+        for (unsigned int i = r.begin(); i != r.end(); ++i)
+            {
+            Scalar4 force = make_scalar4(0.0, 0.0, 0.0, 0.0);
+            Scalar virial[6];
+            for (unsigned int k = 0; k < 6; ++k)
+                virial[k] = Scalar(0.0);
+
+            for (unsigned int g = 0; g < h_n_groups.data[i]; ++g)
+                {
+                const typename group_data::members_t& entry = h_table.data[table_indexer(i, g)];
+                unsigned int pos = h_pos_table.data[table_indexer(i, g)];
+
+                // the table lists the other members in group order, followed by the group type
+                for (unsigned int j = 0, m = 0; j < group_size; ++j)
+                    idx[j] = (j == pos) ? i : entry.idx[m++];
+
+                Scalar energy;
+                eval(idx, entry.idx[group_size-1], f, energy, group_virial);
+
+                force.x += f[pos].x;
+                force.y += f[pos].y;
+                force.z += f[pos].z;
+                force.w += energy;
+                for (unsigned int k = 0; k < 6; ++k)
+                    virial[k] += group_virial[k];
+                }
+
+            h_force[i] = force;
+            for (unsigned int k = 0; k < 6; ++k)
+                h_virial[k*virial_pitch+i] = virial[k];
+            }
+        });
+    }
+#endif
+
+#endif // __BONDED_FORCE_THREADED_H__
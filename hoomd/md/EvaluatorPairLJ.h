@@ -9,6 +9,7 @@
 
 #ifndef NVCC
 #include <string>
+#include "PairEvaluatorBatch.h"
 #endif
 
 #include "hoomd/HOOMDMath.h"
@@ -158,6 +159,56 @@ class EvaluatorPairLJ
             }
 
         #ifndef NVCC
+        //! Evaluate the force and energy of a batch of pairs with SIMD instructions
+        /*! \param rsq Squared distances of detail::ScalarBatch::width pairs
+            \param typpair Type pair index of each pair
+            \param rcutsq Squared cutoff per type pair
+            \param params Parameters per type pair
+            \param force_divr Output array to write the computed forces divided by r
+            \param pair_eng Output array to write the computed pair energies
+            \param energy_shift If true, the potential must be shifted so that V(r) is continuous at the cutoff
+
+            \return Bit mask with bit l set if pair l was evaluated, the same test as evalForceAndEnergy()
+        */
+        static unsigned int evalForceAndEnergyBatch(const Scalar *rsq, const unsigned int *typpair,
+                                                    const Scalar *rcutsq, const param_type *params,
+                                                    Scalar *force_divr, Scalar *pair_eng, bool energy_shift)
+            {
+            typedef detail::ScalarBatch batch;
+            const unsigned int W = batch::width;
+
+            // gather the per type pair parameters
+            Scalar rcutsq_l[W], lj1_l[W], lj2_l[W];
+            for (unsigned int l = 0; l < W; l++)
+                {
+                rcutsq_l[l] = rcutsq[typpair[l]];
+                lj1_l[l] = params[typpair[l]].x;
+                lj2_l[l] = params[typpair[l]].y;
+                }
+
+            batch r2 = batch::load(rsq);
+            batch rc2 = batch::load(rcutsq_l);
+            batch lj1 = batch::load(lj1_l);
+            batch lj2 = batch::load(lj2_l);
+            batch::mask_type active = batch::mask_and(batch::lt(r2, rc2), batch::neq(lj1, batch(Scalar(0.0))));
+
+            batch r2inv = batch(Scalar(1.0))/r2;
+            batch r6inv = r2inv * r2inv * r2inv;
+            batch force = r2inv * r6inv * (batch(Scalar(12.0))*lj1*r6inv - batch(Scalar(6.0))*lj2);
+            batch eng = r6inv * (lj1*r6inv - lj2);
+
+            if (energy_shift)
+                {
+                batch rcut2inv = batch(Scalar(1.0))/rc2;
+                batch rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+                eng = eng - rcut6inv * (lj1*rcut6inv - lj2);
+                }
+
+            batch::zeroUnless(active, force).store(force_divr);
+            batch::zeroUnless(active, eng).store(pair_eng);
+            return batch::bits(active);
+            }
+
         //! Get the name of this potential
         /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
             via analyze.log.
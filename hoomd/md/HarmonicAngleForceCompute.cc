@@ -7,6 +7,7 @@
 
 
 #include "HarmonicAngleForceCompute.h"
+#include "BondedForceThreaded.h"
 
 namespace py = pybind11;
 
@@ -28,7 +29,7 @@ using namespace std;
     \post Memory is allocated, and forces are zeroed.
 */
 HarmonicAngleForceCompute::HarmonicAngleForceCompute(std::shared_ptr<SystemDefinition> sysdef)
-    :  ForceCompute(sysdef), m_K(NULL), m_t_0(NULL)
+    :  ForceCompute(sysdef), m_K(NULL), m_t_0(NULL), m_threaded(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing HarmonicAngleForceCompute" << endl;
 
@@ -82,6 +83,23 @@ void HarmonicAngleForceCompute::setParams(unsigned int type, Scalar K, Scalar t_
         m_exec_conf->msg->warning() << "angle.harmonic: specified t_0 <= 0" << endl;
     }
 
+/*! \param threaded True if the particles should be split over the TBB threads
+
+    Threaded execution only applies to the CPU code path and requires a build with TBB.
+*/
+void HarmonicAngleForceCompute::setThreaded(bool threaded)
+    {
+    #ifndef ENABLE_TBB
+    if (threaded)
+        {
+        m_exec_conf->msg->warning() << "angle.harmonic: HOOMD was compiled without TBB, ignoring request for threaded "
+            << "execution" << endl;
+        threaded = false;
+        }
+    #endif
+    m_threaded = threaded;
+    }
+
 /*! AngleForceCompute provides
     - \c angle_harmonic_energy
 */
@@ -119,7 +137,6 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
@@ -129,7 +146,6 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
     // Zero data for force calculation.
     memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
@@ -138,33 +154,13 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
 
-    // for each of the angles
-    const unsigned int size = (unsigned int)m_angle_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // evaluate the angle between the particles idx[0], idx[1], and idx[2]
+    auto eval_angle = [&](const unsigned int *idx, unsigned int angle_type, Scalar3 *f, Scalar& angle_eng,
+        Scalar *angle_virial)
         {
-        // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
-        assert(angle.tag[0] <= m_pdata->getMaximumTag());
-        assert(angle.tag[1] <= m_pdata->getMaximumTag());
-        assert(angle.tag[2] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[angle.tag[0]];
-        unsigned int idx_b = h_rtag.data[angle.tag[1]];
-        unsigned int idx_c = h_rtag.data[angle.tag[2]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "angle.harmonic: angle " <<
-                angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in angle calculation");
-            }
-
-        assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN()+m_pdata->getNGhosts());
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
+        unsigned int idx_c = idx[2];
 
         // calculate d\vec{r}
         Scalar3 dab;
@@ -177,15 +173,9 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
         dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
 
-        Scalar3 dac;
-        dac.x = h_pos.data[idx_a].x - h_pos.data[idx_c].x; // used for the 1-3 JL interaction
-        dac.y = h_pos.data[idx_a].y - h_pos.data[idx_c].y;
-        dac.z = h_pos.data[idx_a].z - h_pos.data[idx_c].z;
-
-        // apply minimum image conventions to all 3 vectors
+        // apply minimum image conventions to both vectors
         dab = box.minImage(dab);
         dcb = box.minImage(dcb);
-        dac = box.minImage(dac);
 
         // on paper, the formula turns out to be: F = K*\vec{r} * (r_0/r - 1)
         // FLOPS: 14 / MEM TRANSFER: 2 Scalars
@@ -208,7 +198,6 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         s_abbc = 1.0/s_abbc;
 
         // actually calculate the force
-        unsigned int angle_type = m_angle_data->getTypeByIndex(i);
         Scalar dth = acos(c_abbc) - m_t_0[angle_type];
         Scalar tk = m_K[angle_type]*dth;
 
@@ -228,11 +217,10 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         fcb[2] = a22*dcb.z + a12*dab.z;
 
         // compute 1/3 of the energy, 1/3 for each atom in the angle
-        Scalar angle_eng = (tk*dth)*Scalar(1.0/6.0);
+        angle_eng = (tk*dth)*Scalar(1.0/6.0);
 
         // compute 1/3 of the virial, 1/3 for each atom in the angle
         // upper triangular version of virial tensor
-        Scalar angle_virial[6];
         angle_virial[0] = Scalar(1./3.) * ( dab.x*fab[0] + dcb.x*fcb[0] );
         angle_virial[1] = Scalar(1./3.) * ( dab.y*fab[0] + dcb.y*fcb[0] );
         angle_virial[2] = Scalar(1./3.) * ( dab.z*fab[0] + dcb.z*fcb[0] );
@@ -240,36 +228,73 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
         angle_virial[4] = Scalar(1./3.) * ( dab.z*fab[1] + dcb.z*fcb[1] );
         angle_virial[5] = Scalar(1./3.) * ( dab.z*fab[2] + dcb.z*fcb[2] );
 
-        // Now, apply the force to each individual atom a,b,c, and accumulate the energy/virial
-        // do not update ghost particles
-        if (idx_a < m_pdata->getN())
-            {
-            h_force.data[idx_a].x += fab[0];
-            h_force.data[idx_a].y += fab[1];
-            h_force.data[idx_a].z += fab[2];
-            h_force.data[idx_a].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_a]  += angle_virial[j];
-            }
+        f[0] = make_scalar3(fab[0], fab[1], fab[2]);
+        f[1] = make_scalar3(-fab[0] - fcb[0], -fab[1] - fcb[1], -fab[2] - fcb[2]);
+        f[2] = make_scalar3(fcb[0], fcb[1], fcb[2]);
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_threaded)
+        {
+        // sum the angles of each particle, do not update ghost particles
+        computeBondedForcesThreaded(*m_angle_data, m_pdata->getN(), h_force.data, h_virial.data, virial_pitch,
+            eval_angle);
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+    #endif
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    assert(h_rtag.data);
 
-        if (idx_b < m_pdata->getN())
+    // for each of the angles
+    const unsigned int size = (unsigned int)m_angle_data->getN();
+    for (unsigned int i = 0; i < size; i++)
+        {
+        // lookup the tag of each of the particles participating in the angle
+        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
+        assert(angle.tag[0] <= m_pdata->getMaximumTag());
+        assert(angle.tag[1] <= m_pdata->getMaximumTag());
+        assert(angle.tag[2] <= m_pdata->getMaximumTag());
+
+        // transform a, b, and c into indices into the particle data arrays
+        // MEM TRANSFER: 6 ints
+        unsigned int idx[3];
+        idx[0] = h_rtag.data[angle.tag[0]];
+        idx[1] = h_rtag.data[angle.tag[1]];
+        idx[2] = h_rtag.data[angle.tag[2]];
+
+        // throw an error if this angle is incomplete
+        if (idx[0] == NOT_LOCAL|| idx[1] == NOT_LOCAL || idx[2] == NOT_LOCAL)
             {
-            h_force.data[idx_b].x -= fab[0] + fcb[0];
-            h_force.data[idx_b].y -= fab[1] + fcb[1];
-            h_force.data[idx_b].z -= fab[2] + fcb[2];
-            h_force.data[idx_b].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_b]  += angle_virial[j];
+            this->m_exec_conf->msg->error() << "angle.harmonic: angle " <<
+                angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
+            throw std::runtime_error("Error in angle calculation");
             }
 
-        if (idx_c < m_pdata->getN())
+        assert(idx[0] < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx[1] < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx[2] < m_pdata->getN()+m_pdata->getNGhosts());
+
+        Scalar3 f[3];
+        Scalar angle_eng;
+        Scalar angle_virial[6];
+        eval_angle(idx, m_angle_data->getTypeByIndex(i), f, angle_eng, angle_virial);
+
+        // Now, apply the force to each individual atom a,b,c, and accumulate the energy/virial
+        // do not update ghost particles
+        for (unsigned int k = 0; k < 3; k++)
             {
-            h_force.data[idx_c].x += fcb[0];
-            h_force.data[idx_c].y += fcb[1];
-            h_force.data[idx_c].z += fcb[2];
-            h_force.data[idx_c].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_c]  += angle_virial[j];
+            if (idx[k] < m_pdata->getN())
+                {
+                h_force.data[idx[k]].x += f[k].x;
+                h_force.data[idx[k]].y += f[k].y;
+                h_force.data[idx[k]].z += f[k].z;
+                h_force.data[idx[k]].w += angle_eng;
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[j*virial_pitch+idx[k]]  += angle_virial[j];
+                }
             }
         }
 
@@ -281,5 +306,7 @@ void export_HarmonicAngleForceCompute(py::module& m)
     py::class_<HarmonicAngleForceCompute, std::shared_ptr<HarmonicAngleForceCompute> >(m, "HarmonicAngleForceCompute", py::base<ForceCompute>())
     .def(py::init< std::shared_ptr<SystemDefinition> >())
     .def("setParams", &HarmonicAngleForceCompute::setParams)
+    .def("setThreaded", &HarmonicAngleForceCompute::setThreaded)
+    .def("getThreaded", &HarmonicAngleForceCompute::getThreaded)
     ;
     }
@@ -47,6 +47,15 @@ class PYBIND11_EXPORT HarmonicAngleForceCompute : public ForceCompute
         //! Calculates the requested log value and returns it
         virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
 
+        //! Enable or disable threaded evaluation of the forces on the CPU
+        void setThreaded(bool threaded);
+
+        //! Get whether threaded evaluation of the forces is enabled
+        bool getThreaded() const
+            {
+            return m_threaded;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         /*! \param timestep Current time step
@@ -65,6 +74,7 @@ class PYBIND11_EXPORT HarmonicAngleForceCompute : public ForceCompute
         Scalar* m_t_0;  //!< r_0 parameter for multiple angle types
 
         std::shared_ptr<AngleData> m_angle_data;  //!< Angle data to use in computing angles
+        bool m_threaded;                            //!< True if the CPU force loop is split over TBB threads
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
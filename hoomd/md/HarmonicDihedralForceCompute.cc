@@ -7,6 +7,7 @@
 
 
 #include "HarmonicDihedralForceCompute.h"
+#include "BondedForceThreaded.h"
 
 namespace py = pybind11;
 
@@ -28,7 +29,7 @@ using namespace std;
     \post Memory is allocated, and forces are zeroed.
 */
 HarmonicDihedralForceCompute::HarmonicDihedralForceCompute(std::shared_ptr<SystemDefinition> sysdef)
-    : ForceCompute(sysdef), m_K(NULL), m_sign(NULL), m_multi(NULL), m_phi_0(NULL)
+    : ForceCompute(sysdef), m_K(NULL), m_sign(NULL), m_multi(NULL), m_phi_0(NULL), m_threaded(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing HarmonicDihedralForceCompute" << endl;
 
@@ -94,6 +95,23 @@ void HarmonicDihedralForceCompute::setParams(unsigned int type, Scalar K, int si
         m_exec_conf->msg->warning() << "dihedral.harmonic: specified phi_0 outside [0, 2pi)" << endl;
     }
 
+/*! \param threaded True if the particles should be split over the TBB threads
+
+    Threaded execution only applies to the CPU code path and requires a build with TBB.
+*/
+void HarmonicDihedralForceCompute::setThreaded(bool threaded)
+    {
+    #ifndef ENABLE_TBB
+    if (threaded)
+        {
+        m_exec_conf->msg->warning() << "dihedral.harmonic: HOOMD was compiled without TBB, ignoring request for "
+            << "threaded execution" << endl;
+        threaded = false;
+        }
+    #endif
+    m_threaded = threaded;
+    }
+
 /*! DihedralForceCompute provides
     - \c dihedral_harmonic_energy
 */
@@ -131,7 +149,6 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
@@ -144,44 +161,20 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
     unsigned int virial_pitch = m_virial.getPitch();
 
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
-    // for each of the dihedrals
-    const unsigned int size = (unsigned int)m_dihedral_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // evaluate the dihedral between the particles idx[0], idx[1], idx[2], and idx[3]
+    auto eval_dihedral = [&](const unsigned int *idx, unsigned int dihedral_type, Scalar3 *f, Scalar& dihedral_eng,
+        Scalar *dihedral_virial)
         {
-        // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
-        assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[3] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[dihedral.tag[0]];
-        unsigned int idx_b = h_rtag.data[dihedral.tag[1]];
-        unsigned int idx_c = h_rtag.data[dihedral.tag[2]];
-        unsigned int idx_d = h_rtag.data[dihedral.tag[3]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
-                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in dihedral calculation");
-            }
-
-        assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_d < m_pdata->getN() + m_pdata->getNGhosts());
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
+        unsigned int idx_c = idx[2];
+        unsigned int idx_d = idx[3];
 
         // calculate d\vec{r}
         Scalar3 dab;
@@ -237,7 +230,6 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
         if (c_abcd > 1.0) c_abcd = 1.0;
         if (c_abcd < -1.0) c_abcd = -1.0;
 
-        unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
         int multi = (int)m_multi[dihedral_type];
         Scalar p = Scalar(1.0);
         Scalar dfab = Scalar(0.0);
@@ -319,11 +311,10 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
         // and accumulate the energy/virial
         // compute 1/4 of the energy, 1/4 for each atom in the dihedral
         //Scalar dihedral_eng = p*m_K[dihedral.type]*Scalar(1.0/4.0);
-        Scalar dihedral_eng = p*m_K[dihedral_type]*Scalar(0.125);  // the .125 term is (1/2)K * 1/4
+        dihedral_eng = p*m_K[dihedral_type]*Scalar(0.125);  // the .125 term is (1/2)K * 1/4
 
         // compute 1/4 of the virial, 1/4 for each atom in the dihedral
         // upper triangular version of virial tensor
-        Scalar dihedral_virial[6];
         dihedral_virial[0] = (1./4.)*(dab.x*ffax + dcb.x*ffcx + (ddc.x+dcb.x)*ffdx);
         dihedral_virial[1] = (1./4.)*(dab.y*ffax + dcb.y*ffcx + (ddc.y+dcb.y)*ffdx);
         dihedral_virial[2] = (1./4.)*(dab.z*ffax + dcb.z*ffcx + (ddc.z+dcb.z)*ffdx);
@@ -331,34 +322,77 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
         dihedral_virial[4] = (1./4.)*(dab.z*ffay + dcb.z*ffcy + (ddc.z+dcb.z)*ffdy);
         dihedral_virial[5] = (1./4.)*(dab.z*ffaz + dcb.z*ffcz + (ddc.z+dcb.z)*ffdz);
 
-        h_force.data[idx_a].x += ffax;
-        h_force.data[idx_a].y += ffay;
-        h_force.data[idx_a].z += ffaz;
-        h_force.data[idx_a].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_a]  += dihedral_virial[k];
-
-        h_force.data[idx_b].x += ffbx;
-        h_force.data[idx_b].y += ffby;
-        h_force.data[idx_b].z += ffbz;
-        h_force.data[idx_b].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_b]  += dihedral_virial[k];
-
-        h_force.data[idx_c].x += ffcx;
-        h_force.data[idx_c].y += ffcy;
-        h_force.data[idx_c].z += ffcz;
-        h_force.data[idx_c].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_c]  += dihedral_virial[k];
-
-        h_force.data[idx_d].x += ffdx;
-        h_force.data[idx_d].y += ffdy;
-        h_force.data[idx_d].z += ffdz;
-        h_force.data[idx_d].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_d]  += dihedral_virial[k];
-       }
+        f[0] = make_scalar3(ffax, ffay, ffaz);
+        f[1] = make_scalar3(ffbx, ffby, ffbz);
+        f[2] = make_scalar3(ffcx, ffcy, ffcz);
+        f[3] = make_scalar3(ffdx, ffdy, ffdz);
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_threaded)
+        {
+        // sum the dihedrals of each particle, ghost particles receive forces as in the serial loop
+        computeBondedForcesThreaded(*m_dihedral_data, m_pdata->getN() + m_pdata->getNGhosts(), h_force.data,
+            h_virial.data, virial_pitch, eval_dihedral);
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+    #endif
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    assert(h_rtag.data);
+
+    // for each of the dihedrals
+    const unsigned int size = (unsigned int)m_dihedral_data->getN();
+    for (unsigned int i = 0; i < size; i++)
+        {
+        // lookup the tag of each of the particles participating in the dihedral
+        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
+        assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
+        assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
+        assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
+        assert(dihedral.tag[3] <= m_pdata->getMaximumTag());
+
+        // transform a, b, and c into indices into the particle data arrays
+        // MEM TRANSFER: 6 ints
+        unsigned int idx[4];
+        idx[0] = h_rtag.data[dihedral.tag[0]];
+        idx[1] = h_rtag.data[dihedral.tag[1]];
+        idx[2] = h_rtag.data[dihedral.tag[2]];
+        idx[3] = h_rtag.data[dihedral.tag[3]];
+
+        // throw an error if this angle is incomplete
+        if (idx[0] == NOT_LOCAL|| idx[1] == NOT_LOCAL || idx[2] == NOT_LOCAL || idx[3] == NOT_LOCAL)
+            {
+            this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
+                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
+                << " incomplete." << endl << endl;
+            throw std::runtime_error("Error in dihedral calculation");
+            }
+
+        assert(idx[0] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[1] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[2] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[3] < m_pdata->getN() + m_pdata->getNGhosts());
+
+        Scalar3 f[4];
+        Scalar dihedral_eng;
+        Scalar dihedral_virial[6];
+        eval_dihedral(idx, m_dihedral_data->getTypeByIndex(i), f, dihedral_eng, dihedral_virial);
+
+        // Now, apply the force to each individual atom a,b,c,d
+        // and accumulate the energy/virial
+        for (unsigned int j = 0; j < 4; j++)
+            {
+            h_force.data[idx[j]].x += f[j].x;
+            h_force.data[idx[j]].y += f[j].y;
+            h_force.data[idx[j]].z += f[j].z;
+            h_force.data[idx[j]].w += dihedral_eng;
+            for (int k = 0; k < 6; k++)
+               h_virial.data[virial_pitch*k+idx[j]]  += dihedral_virial[k];
+            }
+        }
 
     if (m_prof) m_prof->pop();
     }
@@ -368,5 +402,7 @@ void export_HarmonicDihedralForceCompute(py::module& m)
     py::class_<HarmonicDihedralForceCompute, std::shared_ptr<HarmonicDihedralForceCompute> >(m, "HarmonicDihedralForceCompute", py::base<ForceCompute>())
     .def(py::init< std::shared_ptr<SystemDefinition> >())
     .def("setParams", &HarmonicDihedralForceCompute::setParams)
+    .def("setThreaded", &HarmonicDihedralForceCompute::setThreaded)
+    .def("getThreaded", &HarmonicDihedralForceCompute::getThreaded)
     ;
     }
@@ -48,6 +48,15 @@ class PYBIND11_EXPORT HarmonicDihedralForceCompute : public ForceCompute
         //! Calculates the requested log value and returns it
         virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
 
+        //! Enable or disable threaded evaluation of the forces on the CPU
+        void setThreaded(bool threaded);
+
+        //! Get whether threaded evaluation of the forces is enabled
+        bool getThreaded() const
+            {
+            return m_threaded;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         /*! \param timestep Current time step
@@ -68,6 +77,7 @@ class PYBIND11_EXPORT HarmonicDihedralForceCompute : public ForceCompute
         Scalar *m_phi_0; //!< phi_0 parameter for multiple dihedral types
 
         std::shared_ptr<DihedralData> m_dihedral_data;    //!< Dihedral data to use in computing dihedrals
+        bool m_threaded;                                    //!< True if the CPU force loop is split over TBB threads
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
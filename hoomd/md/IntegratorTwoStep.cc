@@ -437,6 +437,16 @@ void IntegratorTwoStep::setCommunicator(std::shared_ptr<Communicator> comm)
 
     Integrator::setCommunicator(comm);
     }
+
+/*! Rigid body constituents are only placed after the ghost update, so no forces are computed early with rigid bodies.
+ */
+void IntegratorTwoStep::computeInteriorCallback(unsigned int timestep)
+    {
+    if (m_composite_forces.size())
+        return;
+
+    Integrator::computeInteriorCallback(timestep);
+    }
 #endif
 
 //! Updates the rigid body constituent particles
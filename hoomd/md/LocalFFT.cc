@@ -0,0 +1,181 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LocalFFT.cc
+    \brief Defines the LocalFFT class
+*/
+
+#include "LocalFFT.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+using namespace std;
+
+#ifdef ENABLE_FFTW
+static_assert(sizeof(kiss_fft_cpx) == sizeof(fftwf_complex), "FFTW requires a single precision kiss_fft_cpx");
+
+#ifdef ENABLE_FFTW_THREADS
+//! True once the FFTW thread support has been initialized for this process
+static bool fftw_threads_initialized = false;
+#endif
+#endif
+
+/*! \param exec_conf Execution configuration
+    \param dim Number of mesh points along x, y, and z
+    \param threaded True if the transforms should use the TBB threads
+*/
+LocalFFT::LocalFFT(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint3 dim, bool threaded)
+    : m_exec_conf(exec_conf), m_dim(dim), m_threaded(threaded)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing LocalFFT (" << getBackendName() << ") " << dim.x << "x" << dim.y
+        << "x" << dim.z << std::endl;
+
+    #ifndef ENABLE_TBB
+    m_threaded = false;
+    #endif
+
+    #ifdef ENABLE_FFTW
+    #ifdef ENABLE_FFTW_THREADS
+    if (!fftw_threads_initialized)
+        {
+        if (!fftwf_init_threads())
+            {
+            m_exec_conf->msg->error() << "Error initializing FFTW threads" << std::endl;
+            throw runtime_error("Error initializing LocalFFT");
+            }
+        fftw_threads_initialized = true;
+        }
+
+    // the thread count is a property of the plan
+    fftwf_plan_with_nthreads(m_threaded ? std::max(m_exec_conf->getNumThreads(), 1u) : 1);
+    #endif
+
+    // FFTW_ESTIMATE does not touch the arrays, the plans may be executed on any array with FFTW_UNALIGNED
+    size_t n = size_t(dim.x)*size_t(dim.y)*size_t(dim.z);
+    fftwf_complex *in = fftwf_alloc_complex(n);
+    fftwf_complex *out = fftwf_alloc_complex(n);
+
+    m_plan_forward = fftwf_plan_dft_3d(dim.z, dim.y, dim.x, in, out, FFTW_FORWARD, FFTW_ESTIMATE | FFTW_UNALIGNED);
+    m_plan_inverse = fftwf_plan_dft_3d(dim.z, dim.y, dim.x, in, out, FFTW_BACKWARD, FFTW_ESTIMATE | FFTW_UNALIGNED);
+
+    fftwf_free(in);
+    fftwf_free(out);
+
+    if (!m_plan_forward || !m_plan_inverse)
+        {
+        m_exec_conf->msg->error() << "Error creating FFTW plans" << std::endl;
+        throw runtime_error("Error initializing LocalFFT");
+        }
+    #else
+    int dims[3];
+    dims[0] = dim.z;
+    dims[1] = dim.y;
+    dims[2] = dim.x;
+
+    m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
+    m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+
+    for (unsigned int d = 0; d < 2; ++d)
+        {
+        m_kiss_line[d][0] = kiss_fft_alloc(dim.x, d, NULL, NULL);
+        m_kiss_line[d][1] = kiss_fft_alloc(dim.y, d, NULL, NULL);
+        m_kiss_line[d][2] = kiss_fft_alloc(dim.z, d, NULL, NULL);
+        }
+    #endif
+    }
+
+LocalFFT::~LocalFFT()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying LocalFFT" << std::endl;
+
+    #ifdef ENABLE_FFTW
+    fftwf_destroy_plan(m_plan_forward);
+    fftwf_destroy_plan(m_plan_inverse);
+    #else
+    free(m_kiss_fft);
+    free(m_kiss_ifft);
+    for (unsigned int d = 0; d < 2; ++d)
+        {
+        for (unsigned int i = 0; i < 3; ++i)
+            kiss_fft_free(m_kiss_line[d][i]);
+        }
+    kiss_fft_cleanup();
+    #endif
+    }
+
+std::string LocalFFT::getBackendName()
+    {
+    #ifdef ENABLE_FFTW
+    return "FFTW";
+    #else
+    return "kiss_fft";
+    #endif
+    }
+
+/*! \param in Input mesh
+    \param out Output mesh, must not overlap the input
+    \param inverse True for the inverse transform
+*/
+void LocalFFT::execute(kiss_fft_cpx *in, kiss_fft_cpx *out, bool inverse)
+    {
+    assert(in != out);
+
+    #ifdef ENABLE_FFTW
+    fftwf_execute_dft(inverse ? m_plan_inverse : m_plan_forward, (fftwf_complex *)in, (fftwf_complex *)out);
+    #else
+    if (!m_threaded)
+        {
+        kiss_fftnd(inverse ? m_kiss_ifft : m_kiss_fft, in, out);
+        return;
+        }
+
+    #ifdef ENABLE_TBB
+    const unsigned int d = inverse ? 1 : 0;
+    const unsigned int nx = m_dim.x;
+    const unsigned int ny = m_dim.y;
+    const unsigned int nz = m_dim.z;
+
+    // transform along x, the lines are contiguous
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, ny*nz),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        for (unsigned int l = r.begin(); l != r.end(); ++l)
+            kiss_fft_stride(m_kiss_line[d][0], in + l*nx, out + l*nx, 1);
+        });
+
+    // transform a strided line of the output in place through a per-thread buffer
+    auto transform_line = [&](kiss_fft_cfg cfg, unsigned int n, unsigned int stride, unsigned int base)
+        {
+        std::vector<kiss_fft_cpx>& buf = m_line_buf.local();
+        buf.resize(n);
+        kiss_fft_stride(cfg, out + base, buf.data(), stride);
+        for (unsigned int j = 0; j < n; ++j)
+            out[base + j*stride] = buf[j];
+        };
+
+    // transform along y
+    if (ny > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nx*nz),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int l = r.begin(); l != r.end(); ++l)
+                transform_line(m_kiss_line[d][1], ny, nx, l % nx + (l / nx)*nx*ny);
+            });
+        }
+
+    // transform along z
+    if (nz > 1)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nx*ny),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int l = r.begin(); l != r.end(); ++l)
+                transform_line(m_kiss_line[d][2], nz, nx*ny, l);
+            });
+        }
+    #endif
+    #endif
+    }
@@ -0,0 +1,103 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LocalFFT.h
+    \brief Declares the LocalFFT class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __LOCAL_FFT_H__
+#define __LOCAL_FFT_H__
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/extern/kiss_fft.h"
+#include "hoomd/extern/kiss_fftnd.h"
+
+#ifdef ENABLE_FFTW
+#include <fftw3.h>
+#endif
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
+
+//! Three dimensional complex FFT of a mesh that is local to this rank
+/*! The mesh is stored in row major order with the x index varying fastest, the same layout as kiss_fftnd with the
+    dimensions given as {z, y, x}. Transforms are out-of-place and unnormalized, the inverse transform carries the
+    opposite sign in the exponent.
+
+    The backend is chosen at compile time. With ENABLE_FFTW, the single precision FFTW3 library is used (MKL provides
+    the same interface). Otherwise, the transform uses kiss_fft, which HOOMD bundles.
+
+    When threaded, FFTW plans are created for the TBB thread count (this requires the fftw3f_threads library), and
+    the kiss_fft backend splits the transform into 1D transforms along each axis that are distributed over the TBB
+    threads. The serial kiss_fft backend uses kiss_fftnd, exactly as in previous versions.
+*/
+class PYBIND11_EXPORT LocalFFT
+    {
+    public:
+        //! Constructor
+        LocalFFT(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint3 dim, bool threaded = false);
+
+        //! Destructor
+        ~LocalFFT();
+
+        //! Get the mesh dimensions
+        uint3 getDimensions() const
+            {
+            return m_dim;
+            }
+
+        //! Test if the transforms are threaded
+        bool getThreaded() const
+            {
+            return m_threaded;
+            }
+
+        //! Perform a forward transform
+        void forward(kiss_fft_cpx *in, kiss_fft_cpx *out)
+            {
+            execute(in, out, false);
+            }
+
+        //! Perform an inverse transform
+        void inverse(kiss_fft_cpx *in, kiss_fft_cpx *out)
+            {
+            execute(in, out, true);
+            }
+
+        //! Get the name of the compiled in backend
+        static std::string getBackendName();
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+        uint3 m_dim;                        //!< Mesh dimensions
+        bool m_threaded;                    //!< True if the transforms use the TBB threads
+
+        #ifdef ENABLE_FFTW
+        fftwf_plan m_plan_forward;          //!< Forward plan
+        fftwf_plan m_plan_inverse;          //!< Inverse plan
+        #else
+        kiss_fftnd_cfg m_kiss_fft;          //!< Forward configuration for serial transforms
+        kiss_fftnd_cfg m_kiss_ifft;         //!< Inverse configuration for serial transforms
+        kiss_fft_cfg m_kiss_line[2][3];     //!< 1D configurations along x, y, and z (forward, inverse)
+
+        #ifdef ENABLE_TBB
+        tbb::enumerable_thread_specific< std::vector<kiss_fft_cpx> > m_line_buf; //!< Per-thread line buffer
+        #endif
+        #endif
+
+        //! Perform a transform
+        void execute(kiss_fft_cpx *in, kiss_fft_cpx *out, bool inverse);
+    };
+
+#endif // __LOCAL_FFT_H__
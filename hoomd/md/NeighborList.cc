@@ -13,6 +13,9 @@
 
 namespace py = pybind11;
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
 
@@ -34,9 +37,14 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     : Compute(sysdef), m_typpair_idx(m_pdata->getNTypes()), m_rcut_max_max(_r_cut), m_rcut_min(_r_cut),
       m_r_buff(r_buff), m_d_max(1.0), m_filter_body(false), m_diameter_shift(false), m_storage_mode(half),
       m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_force_update(true),
-      m_dist_check(true), m_has_been_updated_once(false)
+      m_dist_check(true), m_has_been_updated_once(false), m_num_builds(0), m_tune(false), m_tune_every(true),
+      m_tune_r_min(0.05), m_tune_r_max(1.0), m_tune_period(1000), m_tune_tolerance(0.02), m_tune_window_valid(false),
+      m_tune_window_start(0), m_tune_window_tstep(0), m_tune_last_tstep(0), m_tune_dangerous_start(0),
+      m_tune_min_period(UINT_MAX), m_tune_state(tune_base), m_tune_base_cost(0.0), m_tune_base_r_buff(r_buff),
+      m_tune_direction(1), m_tune_failures(0), m_tune_hold(0), m_tune_pending_r_buff(-1.0)
     {
     m_exec_conf->msg->notice(5) << "Constructing Neighborlist" << endl;
+    m_call_timer->setName("time_nlist");
 
     // r_buff must be non-negative or it is not physical
     if (m_r_buff < 0.0)
@@ -48,12 +56,19 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     // initialize values
     m_last_updated_tstep = 0;
     m_last_checked_tstep = 0;
+    #ifdef ENABLE_MPI
+    m_n_interior = 0;
+    m_ghost_partition_valid = false;
+    #endif
     m_last_check_result = false;
     m_every = 0;
     m_exclusions_set = false;
 
     m_need_reallocate_exlist = false;
 
+    m_cluster_pairs = false;
+    m_cluster_fill = 0.0;
+
     // initialize box length at last update
     m_last_L = m_pdata->getGlobalBox().getNearestPlaneDistance();
     m_last_L_local = m_pdata->getBox().getNearestPlaneDistance();
@@ -317,6 +332,12 @@ NeighborList::~NeighborList()
 */
 void NeighborList::compute(unsigned int timestep)
     {
+    // with a communicator, the tuned r_buff is set in peekUpdate() before the ghost layer width is requested
+#ifdef ENABLE_MPI
+    if (!m_comm)
+#endif
+        applyTunedRBuff();
+
     // check if the rcut array has changed and update it
     if (m_rcut_changed)
         {
@@ -327,6 +348,11 @@ void NeighborList::compute(unsigned int timestep)
     if (!shouldCompute(timestep) && !m_force_update)
         return;
 
+    if (m_tune)
+        autotune(timestep);
+
+    CallTimer::Scope timer(*m_call_timer);
+
     if (m_prof) m_prof->push("Neighbor");
 
     // take care of some updates if things have changed since construction
@@ -366,8 +392,16 @@ void NeighborList::compute(unsigned int timestep)
         if (m_exclusions_set)
             filterNlist();
 
+        if (m_cluster_pairs)
+            buildClusterPairs();
+
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+        m_num_builds++;
+
+        #ifdef ENABLE_MPI
+        m_ghost_partition_valid = false;
+        #endif
         }
     if (m_prof) m_prof->pop();
     }
@@ -471,6 +505,359 @@ void NeighborList::setRBuff(Scalar r_buff)
     forceUpdate();
     }
 
+/*! \param enable Set to true to enable tuning
+    \param r_min Smallest r_buff to set
+    \param r_max Largest r_buff to set
+    \param period Number of consecutive time steps timed for each r_buff
+    \param tolerance Relative speedup a trial r_buff needs to be accepted
+    \param tune_every Set to true to also tune the check period
+
+    Tuning starts from the current r_buff, which is clamped to the range.
+*/
+void NeighborList::setAutotune(bool enable, Scalar r_min, Scalar r_max, unsigned int period, Scalar tolerance,
+                               bool tune_every)
+    {
+    if (r_min < 0.0 || r_max < r_min)
+        {
+        m_exec_conf->msg->error() << "nlist: Invalid r_buff range " << r_min << " to " << r_max << " for tuning"
+                                  << endl;
+        throw runtime_error("Error changing NeighborList parameters");
+        }
+    if (period == 0)
+        {
+        m_exec_conf->msg->error() << "nlist: The tuning period must be positive" << endl;
+        throw runtime_error("Error changing NeighborList parameters");
+        }
+    if (tolerance < 0.0 || tolerance >= 1.0)
+        {
+        m_exec_conf->msg->error() << "nlist: The tuning tolerance must be in [0,1)" << endl;
+        throw runtime_error("Error changing NeighborList parameters");
+        }
+
+    m_tune = enable;
+    m_tune_r_min = r_min;
+    m_tune_r_max = r_max;
+    m_tune_period = period;
+    m_tune_tolerance = tolerance;
+    m_tune_every = tune_every;
+
+    m_tune_window_valid = false;
+    m_tune_state = tune_base;
+    m_tune_direction = 1;
+    m_tune_failures = 0;
+    m_tune_hold = 0;
+    m_tune_pending_r_buff = -1.0;
+
+    if (m_tune && (m_r_buff < r_min || m_r_buff > r_max))
+        m_tune_pending_r_buff = std::min(std::max(m_r_buff, r_min), r_max);
+    }
+
+/*! The new r_buff is set at the start of a time step, so that the ghost layer width and the neighbor list agree on
+    it for the whole step.
+*/
+void NeighborList::applyTunedRBuff()
+    {
+    if (m_tune_pending_r_buff < Scalar(0.0))
+        return;
+
+    setRBuff(m_tune_pending_r_buff);
+    m_tune_pending_r_buff = -1.0;
+    }
+
+/*! \param timestep Current time step
+
+    Windows span m_tune_period consecutive time steps. A gap in the time steps (e.g. between runs) or a reset of the
+    statistics starts a new window, so that the time spent outside of the run is not counted.
+*/
+void NeighborList::autotune(unsigned int timestep)
+    {
+    // multiple calls in one step are counted once
+    if (m_tune_window_valid && timestep == m_tune_last_tstep)
+        return;
+
+    if (!m_tune_window_valid || timestep != m_tune_last_tstep + 1)
+        {
+        m_tune_window_valid = true;
+        m_tune_window_start = m_tune_clk.getTime();
+        m_tune_window_tstep = timestep;
+        m_tune_last_tstep = timestep;
+        m_tune_dangerous_start = m_dangerous_updates;
+        m_tune_min_period = UINT_MAX;
+        return;
+        }
+
+    m_tune_last_tstep = timestep;
+    if (timestep - m_tune_window_tstep < m_tune_period)
+        return;
+
+    // largest r_buff that fits in the box, see checkBoxSize() and Communicator::checkBoxSize()
+    Scalar3 L = m_pdata->getBox().getNearestPlaneDistance();
+    Scalar L_min = std::min(L.x, L.y);
+    if (m_sysdef->getNDimensions() == 3)
+        L_min = std::min(L_min, L.z);
+    Scalar r_other = m_rcut_max_max;
+    if (m_diameter_shift)
+        r_other += m_d_max - Scalar(1.0);
+    if (m_filter_body)
+        r_other += Scalar(0.5)*m_pdata->getMaxCompositeParticleDiameter();
+
+    // the slowest rank and the most restrictive box decide, so that all ranks make the same choice
+    double window[4];
+    window[0] = double(m_tune_clk.getTime() - m_tune_window_start) / 1e9 / double(timestep - m_tune_window_tstep);
+    window[1] = double(m_dangerous_updates - m_tune_dangerous_start);
+    window[2] = -double(m_tune_min_period);
+    window[3] = -double(Scalar(0.49)*L_min - r_other);
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, window, 4, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+    #endif
+
+    double cost = window[0];
+    bool dangerous = window[1] > 0.0;
+    unsigned int min_period = (unsigned int)(-window[2]);
+    Scalar r_limit = std::min(m_tune_r_max, Scalar(-window[3]));
+
+    // start the next window
+    m_tune_window_start = m_tune_clk.getTime();
+    m_tune_window_tstep = timestep;
+    m_tune_dangerous_start = m_dangerous_updates;
+    m_tune_min_period = UINT_MAX;
+
+    // check period: halve it after a dangerous build, grow it slowly while the builds are far apart
+    if (m_tune_every && m_dist_check)
+        {
+        unsigned int every = m_every;
+        if (dangerous && m_every > 1)
+            every = m_every / 2;
+        else if (!dangerous && min_period != UINT_MAX && 3*(m_every+1) <= min_period)
+            every = m_every + 1;
+
+        if (every != m_every)
+            {
+            m_exec_conf->msg->notice(3) << "nlist: Tuner set check_period = " << every << endl;
+            m_every = every;
+            }
+        }
+
+    // buffer radius: hill climbing with a tolerance against the noise of the timing
+    switch (m_tune_state)
+        {
+        case tune_hold:
+            if (--m_tune_hold == 0)
+                m_tune_state = tune_base;
+            break;
+
+        case tune_base:
+            m_tune_base_cost = cost;
+            m_tune_base_r_buff = m_r_buff;
+            proposeRBuff(r_limit);
+            break;
+
+        case tune_trial:
+            if (cost < m_tune_base_cost * (1.0 - m_tune_tolerance))
+                {
+                // keep going in the same direction
+                m_exec_conf->msg->notice(3) << "nlist: Tuner set r_buff = " << m_r_buff << " (" << cost
+                                            << " s/step vs. " << m_tune_base_cost << " s/step)" << endl;
+                m_tune_base_cost = cost;
+                m_tune_base_r_buff = m_r_buff;
+                m_tune_failures = 0;
+                proposeRBuff(r_limit);
+                }
+            else
+                {
+                // go back, measure again, and try the other direction
+                m_tune_pending_r_buff = m_tune_base_r_buff;
+                m_tune_direction = -m_tune_direction;
+                m_tune_state = tune_base;
+
+                if (++m_tune_failures >= 2)
+                    {
+                    m_tune_failures = 0;
+                    m_tune_hold = 4;
+                    m_tune_state = tune_hold;
+                    }
+                }
+            break;
+        }
+    }
+
+/*! \param r_limit Largest r_buff allowed
+
+    The step size is 1/16 of the tuning range. When the range ends in the current direction, the other direction is
+    tried. When r_buff cannot move at all, the tuner waits.
+*/
+void NeighborList::proposeRBuff(Scalar r_limit)
+    {
+    Scalar dr = (m_tune_r_max - m_tune_r_min) / Scalar(16.0);
+    Scalar r_hi = std::max(std::min(m_tune_r_max, r_limit), m_tune_r_min);
+
+    for (unsigned int i = 0; i < 2; i++)
+        {
+        Scalar r = std::min(std::max(m_tune_base_r_buff + m_tune_direction*dr, m_tune_r_min), r_hi);
+        if (std::abs(r - m_tune_base_r_buff) > Scalar(0.5)*dr)
+            {
+            m_tune_pending_r_buff = r;
+            m_tune_state = tune_trial;
+            return;
+            }
+        m_tune_direction = -m_tune_direction;
+        }
+
+    m_tune_hold = 4;
+    m_tune_state = tune_hold;
+    }
+
+/*! \param enable Set to true to build the cluster pair list after every build
+
+    The cluster pair list is only used by the CPU code path, requests are ignored on the GPU.
+*/
+void NeighborList::setClusterPairs(bool enable)
+    {
+    #ifdef ENABLE_CUDA
+    if (enable && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->warning() << "nlist: Cluster pairs are not supported on the GPU, ignoring request" << endl;
+        enable = false;
+        }
+    #endif
+
+    m_cluster_pairs = enable;
+    if (!m_cluster_pairs)
+        {
+        m_cluster_members.clear();
+        m_particle_lane.clear();
+        m_cluster_pair_head.clear();
+        m_cluster_pair_j.clear();
+        m_cluster_pair_mask.clear();
+        }
+
+    forceUpdate();
+    }
+
+/*! Clusters are formed from columns as in the cluster pair scheme of GROMACS: the column width is chosen so that
+    cluster_size particles at the average local density fill a cube of that width. Particles are sorted by column and
+    then along the column, which takes O(N log N) time on each build.
+*/
+void NeighborList::buildClusterPairs()
+    {
+    if (m_prof) m_prof->push("cluster pairs");
+
+    const unsigned int W = cluster_size;
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_all = N + m_pdata->getNGhosts();
+    const bool twod = m_sysdef->getNDimensions() == 2;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+
+    // column width for cubic clusters at the local density
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar3 L = global_box.getL();
+    Scalar width = twod ? L.x : std::min(L.x, L.y);
+    if (N > 0)
+        {
+        Scalar per_cluster = m_pdata->getBox().getVolume(twod) * Scalar(W) / Scalar(N);
+        width = twod ? sqrt(per_cluster) : cbrt(per_cluster);
+        }
+    const unsigned int nx = std::max(1u, (unsigned int)(L.x / width));
+    const unsigned int ny = twod ? 1u : std::max(1u, (unsigned int)(L.y / width));
+
+    // sort by column, then along the column
+    struct lane_key
+        {
+        unsigned int column;
+        Scalar axial;
+        unsigned int idx;
+        };
+    std::vector<lane_key> keys(n_all);
+    for (unsigned int i = 0; i < n_all; i++)
+        {
+        Scalar3 pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        Scalar3 f = global_box.makeFraction(pos);
+
+        // ghosts may lie slightly outside of the box
+        int cx = std::min(std::max(int(f.x * Scalar(nx)), 0), int(nx) - 1);
+        int cy = std::min(std::max(int(f.y * Scalar(ny)), 0), int(ny) - 1);
+
+        keys[i].column = twod ? (unsigned int)cx : (unsigned int)cx + nx * (unsigned int)cy;
+        keys[i].axial = twod ? pos.y : pos.z;
+        keys[i].idx = i;
+        }
+    std::sort(keys.begin(), keys.end(), [](const lane_key& a, const lane_key& b)
+        {
+        return a.column < b.column || (a.column == b.column && a.axial < b.axial);
+        });
+
+    // split the columns into clusters, the last cluster of a column is padded
+    m_cluster_members.clear();
+    m_particle_lane.resize(n_all);
+    unsigned int lane = W;
+    for (unsigned int k = 0; k < n_all; k++)
+        {
+        if (lane == W || keys[k].column != keys[k-1].column)
+            {
+            m_cluster_members.resize(m_cluster_members.size() + W, UINT_MAX);
+            lane = 0;
+            }
+        unsigned int slot = (unsigned int)m_cluster_members.size() - W + lane;
+        m_cluster_members[slot] = keys[k].idx;
+        m_particle_lane[keys[k].idx] = slot;
+        lane++;
+        }
+
+    // collect the neighbors of each i cluster by j cluster
+    const unsigned int n_clusters = getNClusters();
+    std::vector<unsigned int> pair_of(n_clusters, UINT_MAX);
+    m_cluster_pair_head.resize(n_clusters + 1);
+    m_cluster_pair_j.clear();
+    m_cluster_pair_mask.clear();
+    uint64_t n_neighbors = 0;
+
+    for (unsigned int ci = 0; ci < n_clusters; ci++)
+        {
+        const unsigned int first = (unsigned int)m_cluster_pair_j.size();
+        m_cluster_pair_head[ci] = first;
+
+        for (unsigned int li = 0; li < W; li++)
+            {
+            // only local particles have neighbors
+            const unsigned int i = m_cluster_members[ci*W + li];
+            if (i >= N)
+                continue;
+
+            const unsigned int head = h_head_list.data[i];
+            for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+                {
+                const unsigned int j_lane = m_particle_lane[h_nlist.data[head + k]];
+                const unsigned int cj = j_lane / W;
+
+                if (pair_of[cj] == UINT_MAX)
+                    {
+                    pair_of[cj] = (unsigned int)m_cluster_pair_j.size();
+                    m_cluster_pair_j.push_back(cj);
+                    m_cluster_pair_mask.resize(m_cluster_pair_mask.size() + W, 0);
+                    }
+                m_cluster_pair_mask[pair_of[cj]*W + li] |= 1u << (j_lane % W);
+                n_neighbors++;
+                }
+            }
+
+        for (unsigned int p = first; p < m_cluster_pair_j.size(); p++)
+            pair_of[m_cluster_pair_j[p]] = UINT_MAX;
+        }
+    m_cluster_pair_head[n_clusters] = (unsigned int)m_cluster_pair_j.size();
+
+    m_cluster_fill = 0.0;
+    if (!m_cluster_pair_j.empty())
+        m_cluster_fill = double(n_neighbors) / double(m_cluster_pair_j.size() * W * W);
+
+    if (m_prof) m_prof->pop();
+    }
+
 void NeighborList::updateRList()
     {
     // only need a read on the real cutoff
@@ -1292,6 +1679,8 @@ bool NeighborList::needsUpdating(unsigned int timestep)
             if (timestep > m_last_updated_tstep)
                 {
                 unsigned int period = timestep - m_last_updated_tstep;
+                if (period < m_tune_min_period)
+                    m_tune_min_period = period;
                 if (period >= m_update_periods.size())
                     period = m_update_periods.size()-1;
                 m_update_periods[period]++;
@@ -1352,6 +1741,13 @@ void NeighborList::printStats()
     m_exec_conf->msg->notice(1) << "n_neigh_min: " << n_neigh_min << " / n_neigh_max: " << n_neigh_max << " / n_neigh_avg: " << n_neigh_avg << endl;
 
     m_exec_conf->msg->notice(1) << "shortest rebuild period: " << getSmallestRebuild() << endl;
+
+    if (m_tune)
+        m_exec_conf->msg->notice(1) << "tuned r_buff: " << m_r_buff << " / check_period: " << m_every << endl;
+
+    if (m_cluster_pairs)
+        m_exec_conf->msg->notice(1) << "cluster pairs: " << m_cluster_pair_j.size() << " of " << cluster_size << "x"
+                                    << cluster_size << " / neighbor fraction: " << m_cluster_fill << endl;
     }
 
 void NeighborList::resetStats()
@@ -1360,6 +1756,9 @@ void NeighborList::resetStats()
 
     for (unsigned int i = 0; i < m_update_periods.size(); i++)
         m_update_periods[i] = 0;
+
+    // the time between runs is not part of any window
+    m_tune_window_valid = false;
     }
 
 unsigned int NeighborList::getSmallestRebuild()
@@ -1603,6 +2002,8 @@ void NeighborList::setCommunicator(std::shared_ptr<Communicator> comm)
  */
 bool NeighborList::peekUpdate(unsigned int timestep)
     {
+    applyTunedRBuff();
+
     if (m_prof) m_prof->push("Neighbor");
 
     bool result = needsUpdating(timestep);
@@ -1611,6 +2012,50 @@ bool NeighborList::peekUpdate(unsigned int timestep)
 
     return result;
     }
+
+/*! Pair forces of the particles without ghost neighbors can be evaluated before the ghost positions are current.
+ */
+const std::vector<unsigned int>& NeighborList::getGhostPartition(unsigned int& n_interior)
+    {
+    if (!m_ghost_partition_valid)
+        {
+        ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+
+        const unsigned int N = m_pdata->getN();
+        m_ghost_partition.resize(N);
+
+        // interior particles are placed in order from the front, the others are appended after them
+        m_ghost_boundary.clear();
+        unsigned int n = 0;
+        for (unsigned int i = 0; i < N; i++)
+            {
+            const unsigned int head = h_head_list.data[i];
+            bool has_ghost = false;
+            for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+                {
+                if (h_nlist.data[head + k] >= N)
+                    {
+                    has_ghost = true;
+                    break;
+                    }
+                }
+
+            if (has_ghost)
+                m_ghost_boundary.push_back(i);
+            else
+                m_ghost_partition[n++] = i;
+            }
+
+        m_n_interior = n;
+        std::copy(m_ghost_boundary.begin(), m_ghost_boundary.end(), m_ghost_partition.begin() + n);
+        m_ghost_partition_valid = true;
+        }
+
+    n_interior = m_n_interior;
+    return m_ghost_partition;
+    }
 #endif
 
 #ifdef ENABLE_CUDA
@@ -1677,6 +2122,11 @@ void export_NeighborList(py::module& m)
         .def("setRCutPair", &NeighborList::setRCutPair)
         .def("setRBuff", &NeighborList::setRBuff)
         .def("setEvery", &NeighborList::setEvery)
+        .def("getEvery", &NeighborList::getEvery)
+        .def("getRBuff", &NeighborList::getRBuff)
+        .def("setAutotune", &NeighborList::setAutotune)
+        .def("setClusterPairs", &NeighborList::setClusterPairs)
+        .def("getClusterPairs", &NeighborList::getClusterPairs)
         .def("setStorageMode", &NeighborList::setStorageMode)
         .def("addExclusion", &NeighborList::addExclusion)
         .def("clearExclusions", &NeighborList::clearExclusions)
@@ -9,6 +9,8 @@
 #include "hoomd/GPUVector.h"
 #include "hoomd/GPUFlags.h"
 #include "hoomd/Index1D.h"
+#include "hoomd/ClockSource.h"
+#include "PairEvaluatorBatch.h"
 
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
@@ -91,6 +93,29 @@
     setEvery takes a dist_check parameter. When dist_check=True, the above described behavior is followed. When
     dist_check is false, the nlist is built exactly m_every steps. This is intended for use in profiling only.
 
+    <b>Online tuning:</b>
+
+    A larger buffer radius means fewer builds but more pairs to evaluate in every force computation. setAutotune()
+    enables a tuner that searches for the fastest r_buff while the simulation runs, so that it can follow changes in
+    the density. The tuner measures the wall time per step over windows of a given number of consecutive steps, which
+    includes both the build and the force evaluation cost. It steps r_buff up or down and keeps a new value only when
+    it is faster by more than the tolerance, otherwise it returns to the previous value and tries the other direction.
+    When neither direction is faster, it waits a few windows before searching again. New values are set at the start
+    of the next step, before the ghost layer width is requested for the migration check.
+
+    The tuner also adjusts the check period from the rebuild statistics: it is halved after a dangerous build and
+    grows by one step while the shortest rebuild period in the window is at least three times as long.
+
+    <b>Cluster pairs:</b>
+
+    With setClusterPairs(), the list is also stored as pairs of clusters of cluster_size particles for SIMD force
+    evaluation on the CPU. Local and ghost particles are sorted into columns of a grid along x (and y in 3D), ordered
+    along the remaining axis, and split into clusters that are about as long as the columns are wide. Each particle
+    belongs to one cluster lane. After every build (and exclusion filtering), the per-particle list is converted into
+    a list of j clusters for each i cluster with one mask per i lane that has bit l set when lane l of the j cluster
+    is a neighbor. Masks carry over the storage mode, exclusions, body filtering, and per type pair r_list of the
+    per-particle list, which stays available to all other consumers.
+
     \b Exclusions:
 
     Exclusions are stored in \a ex_list, a data structure similar in structure to \a nlist, except this time exclusions
@@ -152,6 +177,25 @@ class PYBIND11_EXPORT NeighborList : public Compute
             forceUpdate();
             }
 
+        //! Get the number of time steps between the last update and the first check
+        unsigned int getEvery()
+            {
+            return m_every;
+            }
+
+        //! Enable or disable the cluster pair list
+        void setClusterPairs(bool enable);
+
+        //! Get whether the cluster pair list is built
+        bool getClusterPairs() const
+            {
+            return m_cluster_pairs;
+            }
+
+        //! Enable or disable online tuning of the buffer radius and the check period
+        void setAutotune(bool enable, Scalar r_min, Scalar r_max, unsigned int period, Scalar tolerance,
+                         bool tune_every);
+
         //! Set the storage mode
         /*! \param mode Storage mode to set
             - half only stores neighbors where i < j
@@ -441,8 +485,53 @@ class PYBIND11_EXPORT NeighborList : public Compute
         /*! \param timestep The current timestep
          */
         bool peekUpdate(unsigned int timestep);
+
+        //! Get the local particles ordered by whether they have ghost neighbors
+        /*! \param n_interior Set to the number of leading particles in the returned list without ghost neighbors
+            \returns Indices of all local particles, those without ghost neighbors first
+
+            The partition is computed on the host from the current list and cached until the next build.
+        */
+        const std::vector<unsigned int>& getGhostPartition(unsigned int& n_interior);
 #endif
 
+        //! Number of particles in a cluster, one per SIMD lane
+        /*! \warning The value follows the instruction set each translation unit is compiled for (-march), so code
+            that includes this header must be compiled with the same flags as libhoomd. A plugin built for a
+            different target sees a different cluster_size and misreads the cluster pair list.
+        */
+        static const unsigned int cluster_size = detail::ScalarBatch::width;
+
+        //! Get the number of clusters in the cluster pair list
+        unsigned int getNClusters() const
+            {
+            return (unsigned int)(m_cluster_members.size() / cluster_size);
+            }
+
+        //! Get the particle index of each cluster lane, UINT_MAX for unused lanes (cluster_size per cluster)
+        const std::vector<unsigned int>& getClusterMembers() const
+            {
+            return m_cluster_members;
+            }
+
+        //! Get the index of the first j cluster of each i cluster (number of clusters + 1 elements)
+        const std::vector<unsigned int>& getClusterPairHead() const
+            {
+            return m_cluster_pair_head;
+            }
+
+        //! Get the j cluster of each cluster pair
+        const std::vector<unsigned int>& getClusterPairJ() const
+            {
+            return m_cluster_pair_j;
+            }
+
+        //! Get the neighbor masks of each cluster pair (cluster_size per pair, one per i lane)
+        const std::vector<unsigned int>& getClusterPairMask() const
+            {
+            return m_cluster_pair_mask;
+            }
+
         //! Return true if the neighbor list has been updated this time step
         /*! \param timestep Current time step
          *
@@ -453,6 +542,12 @@ class PYBIND11_EXPORT NeighborList : public Compute
             return m_last_updated_tstep == timestep && m_has_been_updated_once;
             }
 
+        //! Get the number of times the list has been built
+        unsigned int getNumBuilds() const
+            {
+            return m_num_builds;
+            }
+
         Nano::Signal<void ()>& getRCutChangeSignal()
             {
             return m_rcut_signal;
@@ -490,6 +585,14 @@ class PYBIND11_EXPORT NeighborList : public Compute
         bool m_exclusions_set;                 //!< True if any exclusions have been set
         bool m_need_reallocate_exlist;         //!< True if global exclusion list needs to be reallocated
 
+        bool m_cluster_pairs;                          //!< True if the cluster pair list is built
+        std::vector<unsigned int> m_cluster_members;   //!< Particle index of each cluster lane
+        std::vector<unsigned int> m_particle_lane;     //!< Cluster lane (cluster*cluster_size + lane) of each particle
+        std::vector<unsigned int> m_cluster_pair_head; //!< First pair of each i cluster
+        std::vector<unsigned int> m_cluster_pair_j;    //!< j cluster of each pair
+        std::vector<unsigned int> m_cluster_pair_mask; //!< Neighbor mask of each i lane of each pair
+        double m_cluster_fill;                         //!< Fraction of the lane pairs in the tiles that are neighbors
+
         //! Return true if we are supposed to do a distance check in this time step
         bool shouldCheckDistance(unsigned int timestep);
 
@@ -514,6 +617,9 @@ class PYBIND11_EXPORT NeighborList : public Compute
         //! Filter the neighbor list of excluded particles
         virtual void filterNlist();
 
+        //! Build the cluster pair list from the per-particle list
+        void buildClusterPairs();
+
         //! Build the head list to allocated memory
         virtual void buildHeadList();
 
@@ -558,6 +664,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
         bool m_force_update;            //!< Flag to handle the forcing of neighborlist updates
         bool m_dist_check;              //!< Set to false to disable distance checks (nlist always built m_every steps)
         bool m_has_been_updated_once;   //!< True if the neighbor list has been updated at least once
+        unsigned int m_num_builds;      //!< Number of times the list has been built
 
         unsigned int m_last_updated_tstep; //!< Track the last time step we were updated
         unsigned int m_last_checked_tstep; //!< Track the last time step we have checked
@@ -565,9 +672,54 @@ class PYBIND11_EXPORT NeighborList : public Compute
         unsigned int m_every; //!< No update checks will be performed until m_every steps after the last one
         std::vector<unsigned int> m_update_periods;    //!< Steps between updates
 
+        //! States of the online tuner
+        enum tune_state
+            {
+            tune_base,      //!< Measuring the cost at the accepted r_buff
+            tune_trial,     //!< Measuring the cost at a trial r_buff
+            tune_hold       //!< Waiting before the next search
+            };
+
+        bool m_tune;                       //!< True if r_buff and m_every are tuned during the run
+        bool m_tune_every;                 //!< True if the check period is tuned
+        Scalar m_tune_r_min;               //!< Smallest r_buff the tuner sets
+        Scalar m_tune_r_max;               //!< Largest r_buff the tuner sets
+        unsigned int m_tune_period;        //!< Number of time steps per measurement window
+        Scalar m_tune_tolerance;           //!< Relative speedup a trial r_buff needs to be accepted
+        ClockSource m_tune_clk;            //!< Clock to time the windows
+        bool m_tune_window_valid;          //!< False until the first step of a window has been seen
+        int64_t m_tune_window_start;       //!< Wall time at the start of the window
+        unsigned int m_tune_window_tstep;  //!< First time step of the window
+        unsigned int m_tune_last_tstep;    //!< Last time step seen by the tuner
+        int64_t m_tune_dangerous_start;    //!< Number of dangerous builds at the start of the window
+        unsigned int m_tune_min_period;    //!< Shortest rebuild period in the window
+        tune_state m_tune_state;           //!< Current state of the tuner
+        double m_tune_base_cost;           //!< Time per step at the accepted r_buff
+        Scalar m_tune_base_r_buff;         //!< Accepted r_buff
+        int m_tune_direction;              //!< +1 to try a larger r_buff next, -1 to try a smaller one
+        unsigned int m_tune_failures;      //!< Number of trials rejected in a row
+        unsigned int m_tune_hold;          //!< Number of windows left before the next search
+        Scalar m_tune_pending_r_buff;      //!< r_buff to set at the start of the next time step, negative if none
+
+        #ifdef ENABLE_MPI
+        std::vector<unsigned int> m_ghost_partition;   //!< Local particles, those without ghost neighbors first
+        std::vector<unsigned int> m_ghost_boundary;    //!< Temporary list of the particles with ghost neighbors
+        unsigned int m_n_interior;                     //!< Number of particles without ghost neighbors
+        bool m_ghost_partition_valid;                  //!< True if the partition matches the current list
+        #endif
+
         //! Test if the list needs updating
         bool needsUpdating(unsigned int timestep);
 
+        //! Time the steps and adjust r_buff and m_every at the end of each window
+        void autotune(unsigned int timestep);
+
+        //! Propose the next trial r_buff
+        void proposeRBuff(Scalar r_limit);
+
+        //! Set the r_buff chosen by the tuner
+        void applyTunedRBuff();
+
         //! Reallocate internal neighbor list data structures
         void reallocate();
 
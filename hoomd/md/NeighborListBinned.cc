@@ -14,6 +14,10 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 
 using namespace std;
 namespace py = pybind11;
@@ -133,7 +137,8 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
-    for (int i = 0; i < (int)nparticles; i++)
+    // finds the neighbors of particle i, recording per-type overflows in conditions
+    auto build_particle = [&](int i, unsigned int *conditions)
         {
         unsigned int cur_n_neigh = 0;
 
@@ -216,7 +221,7 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
                             h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
                             }
                         else
-                            h_conditions.data[type_i] = max(h_conditions.data[type_i], cur_n_neigh+1);
+                            conditions[type_i] = max(conditions[type_i], cur_n_neigh+1);
 
                         cur_n_neigh++;
                         }
@@ -225,6 +230,35 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
             }
 
         h_n_neigh.data[i] = cur_n_neigh;
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        // particles only write to their own section of the neighbor list, the overflow conditions are per thread
+        const unsigned int ntypes = m_pdata->getNTypes();
+        tbb::enumerable_thread_specific< std::vector<unsigned int> > thread_conditions(
+            std::vector<unsigned int>(ntypes, 0));
+
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nparticles),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            std::vector<unsigned int>& conditions = thread_conditions.local();
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                build_particle(i, conditions.data());
+            });
+
+        for (auto it = thread_conditions.begin(); it != thread_conditions.end(); ++it)
+            {
+            for (unsigned int t = 0; t < ntypes; t++)
+                h_conditions.data[t] = max(h_conditions.data[t], (*it)[t]);
+            }
+        }
+    else
+    #endif
+        {
+        for (int i = 0; i < (int)nparticles; i++)
+            build_particle(i, h_conditions.data);
         }
 
     if (m_prof)
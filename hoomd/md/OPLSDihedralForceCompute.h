@@ -47,6 +47,15 @@ class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
         //! Calculates the requested log value and returns it
         virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
 
+        //! Enable or disable threaded evaluation of the forces on the CPU
+        void setThreaded(bool threaded);
+
+        //! Get whether threaded evaluation of the forces is enabled
+        bool getThreaded() const
+            {
+            return m_threaded;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         /*! \param timestep Current time step
@@ -66,6 +75,8 @@ class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
         //!< Dihedral data to use in computing dihedrals
         std::shared_ptr<DihedralData> m_dihedral_data;
 
+        bool m_threaded;    //!< True if the CPU force loop is split over TBB threads
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
     };
@@ -44,9 +44,12 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
       m_q2(0.0),
       m_body_energy(0.0),
       m_ptls_added_removed(false),
-      m_kiss_fft_initialized(false),
+      m_threaded(false),
       m_dfft_initialized(false)
     {
+    #ifdef ENABLE_TBB
+    m_thread_mesh_epoch = 0;
+    #endif
 
     m_pdata->getBoxChangeSignal().connect<PPPMForceCompute, &PPPMForceCompute::setBoxChange>(this);
     // reset virial
@@ -145,12 +148,6 @@ PPPMForceCompute::~PPPMForceCompute()
     {
     m_pdata->getGlobalParticleNumberChangeSignal().disconnect<PPPMForceCompute, &PPPMForceCompute::slotGlobalParticleNumberChange>(this);
 
-    if (m_kiss_fft_initialized)
-        {
-        free(m_kiss_fft);
-        free(m_kiss_ifft);
-        kiss_fft_cleanup();
-        }
     #ifdef ENABLE_MPI
     if (m_dfft_initialized)
         {
@@ -481,15 +478,7 @@ void PPPMForceCompute::initializeFFT()
 
     if (local_fft)
         {
-        int dims[3];
-        dims[0] = m_mesh_points.z;
-        dims[1] = m_mesh_points.y;
-        dims[2] = m_mesh_points.x;
-
-        m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
-        m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
-
-        m_kiss_fft_initialized = true;
+        m_local_fft = std::unique_ptr<LocalFFT>(new LocalFFT(m_exec_conf, m_mesh_points, m_threaded));
         }
 
     // allocate mesh and transformed mesh
@@ -568,7 +557,7 @@ void PPPMForceCompute::computeInfluenceFunction()
     Scalar3 b3 = Scalar(2.0*M_PI)*make_scalar3(a1.y*a2.z-a1.z*a2.y, a1.z*a2.x-a1.x*a2.z, a1.x*a2.y-a1.y*a2.x)/V_box;
 
     #ifdef ENABLE_MPI
-    bool local_fft = m_kiss_fft_initialized;
+    bool local_fft = bool(m_local_fft);
 
     uint3 pdim=make_uint3(0,0,0);
     uint3 pidx=make_uint3(0,0,0);
@@ -715,6 +704,9 @@ void PPPMForceCompute::assignParticles()
     {
     if (m_prof) m_prof->push("assign");
 
+    unsigned int group_size = m_group->getNumMembers();
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(), access_location::host, access_mode::read);
+
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
@@ -728,11 +720,10 @@ void PPPMForceCompute::assignParticles()
 
     Scalar V_cell = box.getVolume()/(Scalar)(m_mesh_points.x*m_mesh_points.y*m_mesh_points.z);
 
-    // loop over group
-    unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    // spread the charge of a group member onto a mesh
+    auto assign_particle = [&](unsigned int group_idx, kiss_fft_cpx *mesh)
         {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
+        unsigned int idx = h_index_array.data[group_idx];
 
         Scalar4 postype = h_postype.data[idx];
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -740,7 +731,7 @@ void PPPMForceCompute::assignParticles()
         // ignore if NaN
         if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
             {
-            continue;
+            return;
             }
 
         Scalar qi = h_charge.data[idx];
@@ -791,7 +782,7 @@ void PPPMForceCompute::assignParticles()
             iz < 0 || iz >= (int)m_grid_dim.z)
             {
             // ignore, error will be thrown elsewhere (in CellList)
-            continue;
+            return;
             }
 
         int mult_fact = 2*m_order+1;
@@ -859,25 +850,75 @@ void PPPMForceCompute::assignParticles()
                     // store in row major order
                     unsigned int neigh_idx = neighi + m_grid_dim.x * (neighj + m_grid_dim.y*neighk);
 
-                    h_mesh.data[neigh_idx].r += qi*W/V_cell;
+                    mesh[neigh_idx].r += qi*W/V_cell;
                     }
                 }
             }
-        } // end loop over particles
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_threaded)
+        {
+        // particles may overlap on the mesh, spread onto per-thread meshes first
+        const unsigned int n_mesh = m_mesh.getNumElements();
+        const unsigned int epoch = ++m_thread_mesh_epoch;
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, group_size),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            ThreadMesh& buf = m_thread_meshes.local();
+            if (buf.epoch != epoch)
+                {
+                // first use of this mesh in this assignment, clear it
+                kiss_fft_cpx zero = {0, 0};
+                buf.mesh.assign(n_mesh, zero);
+                buf.epoch = epoch;
+                }
+
+            for (unsigned int group_idx = r.begin(); group_idx != r.end(); ++group_idx)
+                assign_particle(group_idx, buf.mesh.data());
+            });
+
+        // collect the meshes that were written in this assignment
+        std::vector<const ThreadMesh *> active;
+        for (auto it = m_thread_meshes.begin(); it != m_thread_meshes.end(); ++it)
+            {
+            if (it->epoch == epoch)
+                active.push_back(&(*it));
+            }
+
+        // sum the per-thread meshes
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_mesh),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                kiss_fft_scalar rho(0.0);
+                for (const ThreadMesh *buf : active)
+                    rho += buf->mesh[i].r;
+                h_mesh.data[i].r = rho;
+                }
+            });
+        }
+    else
+    #endif
+        {
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            assign_particle(group_idx, h_mesh.data);
+        }
 
     if (m_prof) m_prof->pop();
     }
 
 void PPPMForceCompute::updateMeshes()
     {
-    if (m_kiss_fft_initialized)
+    if (m_local_fft)
         {
         if (m_prof) m_prof->push("FFT");
         // transform the particle mesh locally (forward transform)
         ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
 
-        kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
+        m_local_fft->forward(h_mesh.data, h_fourier_mesh.data);
         if (m_prof) m_prof->pop();
         }
 
@@ -915,7 +956,7 @@ void PPPMForceCompute::updateMeshes()
         unsigned int NNN = m_global_dim.x*m_global_dim.y*m_global_dim.z;
 
         // multiply with influence function and I*k
-        for (unsigned int k = 0; k < m_n_inner_cells; ++k)
+        auto update_cell = [&](unsigned int k)
             {
             kiss_fft_cpx f = h_fourier_mesh.data[k];
 
@@ -931,12 +972,29 @@ void PPPMForceCompute::updateMeshes()
 
             h_fourier_mesh_G_z.data[k].r = f.i * kvec.z * scaled_inf_f;
             h_fourier_mesh_G_z.data[k].i = -f.r * kvec.z * scaled_inf_f;
+            };
+
+        #ifdef ENABLE_TBB
+        if (m_threaded)
+            {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_n_inner_cells),
+                [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                for (unsigned int k = r.begin(); k != r.end(); ++k)
+                    update_cell(k);
+                });
+            }
+        else
+        #endif
+            {
+            for (unsigned int k = 0; k < m_n_inner_cells; ++k)
+                update_cell(k);
             }
         }
 
     if (m_prof) m_prof->pop();
 
-    if (m_kiss_fft_initialized)
+    if (m_local_fft)
         {
         if (m_prof) m_prof->push("FFT");
         // do a local inverse transform of the force mesh
@@ -946,9 +1004,9 @@ void PPPMForceCompute::updateMeshes()
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::overwrite);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+        m_local_fft->inverse(h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
+        m_local_fft->inverse(h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
+        m_local_fft->inverse(h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
         if (m_prof) m_prof->pop();
         }
 
@@ -993,6 +1051,9 @@ void PPPMForceCompute::interpolateForces()
     {
     if (m_prof) m_prof->push("interpolate");
 
+    unsigned int group_size = m_group->getNumMembers();
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(), access_location::host, access_mode::read);
+
     // access particle data
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
@@ -1012,11 +1073,10 @@ void PPPMForceCompute::interpolateForces()
 
     const BoxDim& box = m_pdata->getBox();
 
-    // loop over group
-    unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    // interpolate the force on a group member, members only write their own force
+    auto interpolate_particle = [&](unsigned int group_idx)
         {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
+        unsigned int idx = h_index_array.data[group_idx];
         Scalar4 postype = h_postype.data[idx];
 
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -1024,7 +1084,7 @@ void PPPMForceCompute::interpolateForces()
         // ignore if NaN
         if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
             {
-            continue;
+            return;
             }
 
         Scalar qi = h_charge.data[idx];
@@ -1074,7 +1134,7 @@ void PPPMForceCompute::interpolateForces()
             iz < 0 || iz >= (int)m_grid_dim.z)
             {
             // ignore, error will be thrown elsewhere (in CellList)
-            continue;
+            return;
             }
 
         Scalar3 force = make_scalar3(0.0,0.0,0.0);
@@ -1155,7 +1215,24 @@ void PPPMForceCompute::interpolateForces()
             }
 
         h_force.data[idx] = make_scalar4(force.x,force.y,force.z,0.0);
-        }  // end of loop over particles
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_threaded)
+        {
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, group_size),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int group_idx = r.begin(); group_idx != r.end(); ++group_idx)
+                interpolate_particle(group_idx);
+            });
+        }
+    else
+    #endif
+        {
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            interpolate_particle(group_idx);
+        }
 
     if (m_prof) m_prof->pop();
     }
@@ -1667,6 +1744,32 @@ Scalar PPPMForceCompute::getQ2Sum()
     return q2;
     }
 
+/*! \param threaded True if charge assignment, force interpolation, and local FFTs should use the TBB threads
+
+    Threaded execution only applies to the CPU code path and requires a build with TBB. Distributed FFTs are not
+    affected.
+*/
+void PPPMForceCompute::setThreaded(bool threaded)
+    {
+    #ifndef ENABLE_TBB
+    if (threaded)
+        {
+        m_exec_conf->msg->warning() << "charge.pppm: HOOMD was compiled without TBB, ignoring request for threaded "
+            << "execution" << std::endl;
+        threaded = false;
+        }
+    #endif
+
+    if (threaded == m_threaded)
+        return;
+
+    m_threaded = threaded;
+
+    // FFT plans are created for a fixed number of threads
+    if (m_local_fft)
+        m_local_fft = std::unique_ptr<LocalFFT>(new LocalFFT(m_exec_conf, m_mesh_points, m_threaded));
+    }
+
 void export_PPPMForceCompute(py::module& m)
     {
     py::class_<PPPMForceCompute, std::shared_ptr<PPPMForceCompute> >(m, "PPPMForceCompute", py::base<ForceCompute>())
@@ -1674,5 +1777,7 @@ void export_PPPMForceCompute(py::module& m)
         .def("setParams", &PPPMForceCompute::setParams)
         .def("getQSum", &PPPMForceCompute::getQSum)
         .def("getQ2Sum", &PPPMForceCompute::getQ2Sum)
+        .def("setThreaded", &PPPMForceCompute::setThreaded)
+        .def("getThreaded", &PPPMForceCompute::getThreaded)
         ;
     }
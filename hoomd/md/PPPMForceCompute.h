@@ -13,7 +13,11 @@
 #include "hoomd/extern/dfftlib/src/dfft_host.h"
 #endif
 
-#include "hoomd/extern/kiss_fftnd.h"
+#include "LocalFFT.h"
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
 
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
@@ -63,6 +67,15 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         //! Get sum of squares of charges
         Scalar getQ2Sum();
 
+        //! Enable or disable threaded execution on the CPU
+        void setThreaded(bool threaded);
+
+        //! Get whether threaded execution is enabled
+        bool getThreaded() const
+            {
+            return m_threaded;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         /*! \param timestep Current time step
@@ -177,9 +190,10 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         //! Compute rigid body correction
         virtual void computeBodyCorrection();
 
+        bool m_threaded;                    //!< True if the CPU code path uses the TBB threads
+
     private:
-        kiss_fftnd_cfg m_kiss_fft;         //!< The FFT configuration
-        kiss_fftnd_cfg m_kiss_ifft;        //!< Inverse FFT configuration
+        std::unique_ptr<LocalFFT> m_local_fft;  //!< The FFT of a mesh that is not distributed
 
         #ifdef ENABLE_MPI
         dfft_plan m_dfft_plan_forward;     //!< Distributed FFT for forward transform
@@ -188,8 +202,6 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         std::unique_ptr<CommunicatorGrid<kiss_fft_cpx> > m_grid_comm_reverse; //!< Communicator for inv fourier mesh
         #endif
 
-        bool m_kiss_fft_initialized;               //!< True if a local KISS FFT has been set up
-
         GlobalArray<kiss_fft_cpx> m_mesh;             //!< The particle density mesh
         GlobalArray<kiss_fft_cpx> m_fourier_mesh;     //!< The fourier transformed mesh
         GlobalArray<kiss_fft_cpx> m_fourier_mesh_G_x;   //!< Fourier transformed mesh times the influence function, x-component
@@ -203,6 +215,20 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
 
         bool m_dfft_initialized;                   //! True if host dfft has been initialized
 
+        #ifdef ENABLE_TBB
+        //! Charge mesh owned by a single TBB thread
+        struct ThreadMesh
+            {
+            ThreadMesh() : epoch(0) { }
+
+            std::vector<kiss_fft_cpx> mesh; //!< Charge density per mesh point (real part)
+            unsigned int epoch;             //!< Value of m_thread_mesh_epoch when the mesh was last cleared
+            };
+
+        tbb::enumerable_thread_specific<ThreadMesh> m_thread_meshes; //!< Per-thread meshes for charge assignment
+        unsigned int m_thread_mesh_epoch;   //!< Incremented on every threaded charge assignment
+        #endif
+
         //! Compute virial on mesh
         void computeVirialMesh();
 
@@ -0,0 +1,342 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#ifndef __PAIR_EVALUATOR_BATCH_H__
+#define __PAIR_EVALUATOR_BATCH_H__
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/BoxDim.h"
+
+#include <cmath>
+#include <type_traits>
+
+/*! \file PairEvaluatorBatch.h
+    \brief Defines the SIMD helpers used by pair evaluators that evaluate a batch of neighbors at once
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace detail
+{
+
+//! Vector of Scalar values processed together by batched pair evaluators
+/*! ScalarBatch wraps the widest SIMD register type available at compile time (AVX-512, AVX, or a plain array that
+    the compiler may auto-vectorize). Batched evaluators are written once in terms of the operations provided here.
+
+    Comparisons return a mask that can be used to zero out lanes with zeroUnless() and converted to an integer with
+    one bit per lane with bits(). round() rounds to the nearest integer like rint().
+*/
+#if defined(__AVX512F__) && !defined(SINGLE_PRECISION)
+struct ScalarBatch
+    {
+    static const unsigned int width = 8;
+    typedef __mmask8 mask_type;
+
+    ScalarBatch() { }
+    ScalarBatch(__m512d _v) : v(_v) { }
+    explicit ScalarBatch(Scalar s) : v(_mm512_set1_pd(s)) { }
+
+    static ScalarBatch load(const Scalar *p) { return ScalarBatch(_mm512_loadu_pd(p)); }
+    void store(Scalar *p) const { _mm512_storeu_pd(p, v); }
+
+    friend ScalarBatch operator+(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_add_pd(a.v, b.v); }
+    friend ScalarBatch operator-(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_sub_pd(a.v, b.v); }
+    friend ScalarBatch operator*(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_mul_pd(a.v, b.v); }
+    friend ScalarBatch operator/(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_div_pd(a.v, b.v); }
+
+    static mask_type lt(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ); }
+    static mask_type neq(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_NEQ_UQ); }
+    static mask_type mask_and(mask_type a, mask_type b) { return a & b; }
+    static ScalarBatch zeroUnless(mask_type m, const ScalarBatch& a) { return _mm512_maskz_mov_pd(m, a.v); }
+    static ScalarBatch round(const ScalarBatch& a)
+        {
+        return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+    static unsigned int bits(mask_type m) { return (unsigned int)m; }
+
+    __m512d v;
+    };
+#elif defined(__AVX512F__) && defined(SINGLE_PRECISION)
+struct ScalarBatch
+    {
+    static const unsigned int width = 16;
+    typedef __mmask16 mask_type;
+
+    ScalarBatch() { }
+    ScalarBatch(__m512 _v) : v(_v) { }
+    explicit ScalarBatch(Scalar s) : v(_mm512_set1_ps(s)) { }
+
+    static ScalarBatch load(const Scalar *p) { return ScalarBatch(_mm512_loadu_ps(p)); }
+    void store(Scalar *p) const { _mm512_storeu_ps(p, v); }
+
+    friend ScalarBatch operator+(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_add_ps(a.v, b.v); }
+    friend ScalarBatch operator-(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_sub_ps(a.v, b.v); }
+    friend ScalarBatch operator*(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_mul_ps(a.v, b.v); }
+    friend ScalarBatch operator/(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_div_ps(a.v, b.v); }
+
+    static mask_type lt(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ); }
+    static mask_type neq(const ScalarBatch& a, const ScalarBatch& b) { return _mm512_cmp_ps_mask(a.v, b.v, _CMP_NEQ_UQ); }
+    static mask_type mask_and(mask_type a, mask_type b) { return a & b; }
+    static ScalarBatch zeroUnless(mask_type m, const ScalarBatch& a) { return _mm512_maskz_mov_ps(m, a.v); }
+    static ScalarBatch round(const ScalarBatch& a)
+        {
+        return _mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+    static unsigned int bits(mask_type m) { return (unsigned int)m; }
+
+    __m512 v;
+    };
+#elif defined(__AVX__) && !defined(SINGLE_PRECISION)
+struct ScalarBatch
+    {
+    static const unsigned int width = 4;
+    typedef __m256d mask_type;
+
+    ScalarBatch() { }
+    ScalarBatch(__m256d _v) : v(_v) { }
+    explicit ScalarBatch(Scalar s) : v(_mm256_set1_pd(s)) { }
+
+    static ScalarBatch load(const Scalar *p) { return ScalarBatch(_mm256_loadu_pd(p)); }
+    void store(Scalar *p) const { _mm256_storeu_pd(p, v); }
+
+    friend ScalarBatch operator+(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_add_pd(a.v, b.v); }
+    friend ScalarBatch operator-(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_sub_pd(a.v, b.v); }
+    friend ScalarBatch operator*(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_mul_pd(a.v, b.v); }
+    friend ScalarBatch operator/(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_div_pd(a.v, b.v); }
+
+    static mask_type lt(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+    static mask_type neq(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_cmp_pd(a.v, b.v, _CMP_NEQ_UQ); }
+    static mask_type mask_and(mask_type a, mask_type b) { return _mm256_and_pd(a, b); }
+    static ScalarBatch zeroUnless(mask_type m, const ScalarBatch& a) { return _mm256_and_pd(m, a.v); }
+    static ScalarBatch round(const ScalarBatch& a)
+        {
+        return _mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+    static unsigned int bits(mask_type m) { return (unsigned int)_mm256_movemask_pd(m); }
+
+    __m256d v;
+    };
+#elif defined(__AVX__) && defined(SINGLE_PRECISION)
+struct ScalarBatch
+    {
+    static const unsigned int width = 8;
+    typedef __m256 mask_type;
+
+    ScalarBatch() { }
+    ScalarBatch(__m256 _v) : v(_v) { }
+    explicit ScalarBatch(Scalar s) : v(_mm256_set1_ps(s)) { }
+
+    static ScalarBatch load(const Scalar *p) { return ScalarBatch(_mm256_loadu_ps(p)); }
+    void store(Scalar *p) const { _mm256_storeu_ps(p, v); }
+
+    friend ScalarBatch operator+(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_add_ps(a.v, b.v); }
+    friend ScalarBatch operator-(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_sub_ps(a.v, b.v); }
+    friend ScalarBatch operator*(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_mul_ps(a.v, b.v); }
+    friend ScalarBatch operator/(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_div_ps(a.v, b.v); }
+
+    static mask_type lt(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+    static mask_type neq(const ScalarBatch& a, const ScalarBatch& b) { return _mm256_cmp_ps(a.v, b.v, _CMP_NEQ_UQ); }
+    static mask_type mask_and(mask_type a, mask_type b) { return _mm256_and_ps(a, b); }
+    static ScalarBatch zeroUnless(mask_type m, const ScalarBatch& a) { return _mm256_and_ps(m, a.v); }
+    static ScalarBatch round(const ScalarBatch& a)
+        {
+        return _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+    static unsigned int bits(mask_type m) { return (unsigned int)_mm256_movemask_ps(m); }
+
+    __m256 v;
+    };
+#else
+struct ScalarBatch
+    {
+    static const unsigned int width = 4;
+    typedef unsigned int mask_type;
+
+    ScalarBatch() { }
+    explicit ScalarBatch(Scalar s)
+        {
+        for (unsigned int l = 0; l < width; l++)
+            v[l] = s;
+        }
+
+    static ScalarBatch load(const Scalar *p)
+        {
+        ScalarBatch r;
+        for (unsigned int l = 0; l < width; l++)
+            r.v[l] = p[l];
+        return r;
+        }
+    void store(Scalar *p) const
+        {
+        for (unsigned int l = 0; l < width; l++)
+            p[l] = v[l];
+        }
+
+    friend ScalarBatch operator+(const ScalarBatch& a, const ScalarBatch& b)
+        {
+        ScalarBatch r;
+        for (unsigned int l = 0; l < width; l++)
+            r.v[l] = a.v[l] + b.v[l];
+        return r;
+        }
+    friend ScalarBatch operator-(const ScalarBatch& a, const ScalarBatch& b)
+        {
+        ScalarBatch r;
+        for (unsigned int l = 0; l < width; l++)
+            r.v[l] = a.v[l] - b.v[l];
+        return r;
+        }
+    friend ScalarBatch operator*(const ScalarBatch& a, const ScalarBatch& b)
+        {
+        ScalarBatch r;
+        for (unsigned int l = 0; l < width; l++)
+            r.v[l] = a.v[l] * b.v[l];
+        return r;
+        }
+    friend ScalarBatch operator/(const ScalarBatch& a, const ScalarBatch& b)
+        {
+        ScalarBatch r;
+        for (unsigned int l = 0; l < width; l++)
+            r.v[l] = a.v[l] / b.v[l];
+        return r;
+        }
+
+    static mask_type lt(const ScalarBatch& a, const ScalarBatch& b)
+        {
+        mask_type m = 0;
+        for (unsigned int l = 0; l < width; l++)
+            m |= (a.v[l] < b.v[l]) << l;
+        return m;
+        }
+    static mask_type neq(const ScalarBatch& a, const ScalarBatch& b)
+        {
+        mask_type m = 0;
+        for (unsigned int l = 0; l < width; l++)
+            m |= (a.v[l] != b.v[l]) << l;
+        return m;
+        }
+    static mask_type mask_and(mask_type a, mask_type b) { return a & b; }
+    static ScalarBatch zeroUnless(mask_type m, const ScalarBatch& a)
+        {
+        ScalarBatch r;
+        for (unsigned int l = 0; l < width; l++)
+            r.v[l] = (m & (1 << l)) ? a.v[l] : Scalar(0.0);
+        return r;
+        }
+    static ScalarBatch round(const ScalarBatch& a)
+        {
+        ScalarBatch r;
+        for (unsigned int l = 0; l < width; l++)
+            r.v[l] = std::rint(a.v[l]);
+        return r;
+        }
+    static unsigned int bits(mask_type m) { return m; }
+
+    Scalar v[width];
+    };
+#endif
+
+//! Apply the minimum image convention to a batch of distance vectors
+/*! \param box Simulation box
+    \param dx x components, wrapped in place
+    \param dy y components, wrapped in place
+    \param dz z components, wrapped in place
+
+    Same convention as the GPU code path of BoxDim::minImage(), which rounds instead of branching.
+*/
+inline void minImage(const BoxDim& box, ScalarBatch& dx, ScalarBatch& dy, ScalarBatch& dz)
+    {
+    const Scalar3 L = box.getL();
+    const uchar3 periodic = box.getPeriodic();
+
+    if (periodic.z)
+        {
+        ScalarBatch img = ScalarBatch::round(dz * ScalarBatch(Scalar(1.0)/L.z));
+        dz = dz - ScalarBatch(L.z) * img;
+        dy = dy - ScalarBatch(L.z * box.getTiltFactorYZ()) * img;
+        dx = dx - ScalarBatch(L.z * box.getTiltFactorXZ()) * img;
+        }
+
+    if (periodic.y)
+        {
+        ScalarBatch img = ScalarBatch::round(dy * ScalarBatch(Scalar(1.0)/L.y));
+        dy = dy - ScalarBatch(L.y) * img;
+        dx = dx - ScalarBatch(L.y * box.getTiltFactorXY()) * img;
+        }
+
+    if (periodic.x)
+        {
+        ScalarBatch img = ScalarBatch::round(dx * ScalarBatch(Scalar(1.0)/L.x));
+        dx = dx - ScalarBatch(L.x) * img;
+        }
+    }
+
+//! Detects whether a pair evaluator provides evalForceAndEnergyBatch()
+/*! Evaluators opt in to the batched code path in PotentialPair by implementing
+    \code
+    static unsigned int evalForceAndEnergyBatch(const Scalar *rsq, const unsigned int *typpair,
+                                                const Scalar *rcutsq, const param_type *params,
+                                                Scalar *force_divr, Scalar *pair_eng, bool energy_shift);
+    \endcode
+    which evaluates ScalarBatch::width pairs. \a rsq and \a typpair hold the squared distance and type pair index of
+    each pair, \a rcutsq and \a params are the per type pair tables. The return value is a bit mask of the pairs that
+    were evaluated, with the same meaning as the return value of evalForceAndEnergy().
+*/
+template<class evaluator>
+class has_batch_eval
+    {
+    private:
+        template<class T>
+        static auto test(int) -> decltype(&T::evalForceAndEnergyBatch, std::true_type());
+
+        template<class T>
+        static std::false_type test(...);
+
+    public:
+        static const bool value = decltype(test<evaluator>(0))::value;
+    };
+
+//! Call the batched evaluator (evaluators that implement it)
+template<class evaluator>
+inline unsigned int evalForceAndEnergyBatch(const Scalar *rsq, const unsigned int *typpair, const Scalar *rcutsq,
+                                            const typename evaluator::param_type *params, Scalar *force_divr,
+                                            Scalar *pair_eng, bool energy_shift, std::true_type)
+    {
+    return evaluator::evalForceAndEnergyBatch(rsq, typpair, rcutsq, params, force_divr, pair_eng, energy_shift);
+    }
+
+//! Placeholder for evaluators without a batched implementation, never called by PotentialPair
+template<class evaluator>
+inline unsigned int evalForceAndEnergyBatch(const Scalar *rsq, const unsigned int *typpair, const Scalar *rcutsq,
+                                            const typename evaluator::param_type *params, Scalar *force_divr,
+                                            Scalar *pair_eng, bool energy_shift, std::false_type)
+    {
+    return 0;
+    }
+
+//! Evaluate one batch of pairs with the evaluator's evalForceAndEnergyBatch()
+/*! This wrapper compiles for every evaluator so that PotentialPair can select the batched path at run time.
+    Callers must check has_batch_eval<evaluator>::value first.
+*/
+template<class evaluator>
+inline unsigned int evalForceAndEnergyBatch(const Scalar *rsq, const unsigned int *typpair, const Scalar *rcutsq,
+                                            const typename evaluator::param_type *params, Scalar *force_divr,
+                                            Scalar *pair_eng, bool energy_shift)
+    {
+    return evalForceAndEnergyBatch<evaluator>(rsq, typpair, rcutsq, params, force_divr, pair_eng, energy_shift,
+        std::integral_constant<bool, has_batch_eval<evaluator>::value>());
+    }
+
+} // end namespace detail
+
+#endif // __PAIR_EVALUATOR_BATCH_H__
@@ -4,6 +4,7 @@
 #include <memory>
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
+#include "BondedForceThreaded.h"
 
 #include <vector>
 
@@ -47,6 +48,30 @@ class PotentialBond : public ForceCompute
         //! Calculates the requested log value and returns it
         virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
 
+        //! Enable or disable threaded evaluation of the forces on the CPU
+        /*! \param threaded True if the particles should be split over the TBB threads
+
+            Threaded execution only applies to the CPU code path and requires a build with TBB.
+        */
+        void setThreaded(bool threaded)
+            {
+            #ifndef ENABLE_TBB
+            if (threaded)
+                {
+                m_exec_conf->msg->warning() << "bond." << evaluator::getName()
+                    << ": HOOMD was compiled without TBB, ignoring request for threaded execution" << std::endl;
+                threaded = false;
+                }
+            #endif
+            m_threaded = threaded;
+            }
+
+        //! Get whether threaded evaluation of the forces is enabled
+        bool getThreaded() const
+            {
+            return m_threaded;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
@@ -57,6 +82,7 @@ class PotentialBond : public ForceCompute
         std::shared_ptr<BondData> m_bond_data;    //!< Bond data to use in computing bonds
         std::string m_log_name;                     //!< Cached log name
         std::string m_prof_name;                    //!< Cached profiler name
+        bool m_threaded;                            //!< True if the CPU force loop is split over TBB threads
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -68,7 +94,7 @@ class PotentialBond : public ForceCompute
 template< class evaluator >
 PotentialBond< evaluator >::PotentialBond(std::shared_ptr<SystemDefinition> sysdef,
                       const std::string& log_suffix)
-    : ForceCompute(sysdef)
+    : ForceCompute(sysdef), m_threaded(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing PotentialBond<" << evaluator::getName() << ">" << std::endl;
     assert(m_pdata);
@@ -76,6 +102,7 @@ PotentialBond< evaluator >::PotentialBond(std::shared_ptr<SystemDefinition> sysd
     // access the bond data for later use
     m_bond_data = m_sysdef->getBondData();
     m_log_name = std::string("bond_") + evaluator::getName() + std::string("_energy") + log_suffix;
+    m_call_timer->setName(std::string("time_bond_") + evaluator::getName() + log_suffix);
     m_prof_name = std::string("Bond ") + evaluator::getName();
 
     // allocate the parameters
@@ -149,7 +176,6 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
@@ -178,36 +204,11 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
-    Scalar bond_virial[6];
-    for (unsigned int i = 0; i< 6; i++)
-        bond_virial[i]=Scalar(0.0);
-
-    ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
-    ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
-
-    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
-
-    // for each of the bonds
-    const unsigned int size = (unsigned int)m_bond_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // evaluate the bond between the particles idx[0] and idx[1]
+    auto eval_bond = [&](const unsigned int *idx, unsigned int type, Scalar3 *f, Scalar& bond_eng, Scalar *bond_virial)
         {
-        // lookup the tag of each of the particles participating in the bond
-        const typename BondData::members_t& bond = h_bonds.data[i];
-        assert(bond.tag[0] < m_pdata->getMaximumTag()+1);
-        assert(bond.tag[1] < m_pdata->getMaximumTag()+1);
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
-
-        // throw an error if this bond is incomplete
-        if (idx_a >= max_local || idx_b >= max_local)
-            {
-            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond " <<
-                bond.tag[0] << " " << bond.tag[1] << " incomplete." << std::endl << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
 
         // calculate d\vec{r}
         // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
@@ -241,11 +242,11 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
         Scalar rsq = dot(dx,dx);
 
         // get parameters for this bond type
-        param_type param = h_params.data[h_typeval.data[i].type];
+        param_type param = h_params.data[type];
 
         // compute the force and potential energy
         Scalar force_divr = Scalar(0.0);
-        Scalar bond_eng = Scalar(0.0);
+        bond_eng = Scalar(0.0);
         evaluator eval(rsq, param);
         if (evaluator::needsDiameter())
             eval.setDiameter(diameter_a,diameter_b);
@@ -254,51 +255,88 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
         bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
 
+        if (!evaluated)
+            {
+            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl << std::endl;
+            throw std::runtime_error("Error in bond calculation");
+            }
+
         // Bond energy must be halved
         bond_eng *= Scalar(0.5);
 
-        if (evaluated)
+        // calculate virial
+        Scalar force_div2r = compute_virial ? Scalar(1.0/2.0)*force_divr : Scalar(0.0);
+        bond_virial[0] = dx.x * dx.x * force_div2r; // xx
+        bond_virial[1] = dx.x * dx.y * force_div2r; // xy
+        bond_virial[2] = dx.x * dx.z * force_div2r; // xz
+        bond_virial[3] = dx.y * dx.y * force_div2r; // yy
+        bond_virial[4] = dx.y * dx.z * force_div2r; // yz
+        bond_virial[5] = dx.z * dx.z * force_div2r; // zz
+
+        f[0] = -force_divr * dx;
+        f[1] = force_divr * dx;
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_threaded)
+        {
+        // sum the bonds of each particle, only non-ghost particles receive forces
+        computeBondedForcesThreaded(*m_bond_data, m_pdata->getN(), h_force.data, h_virial.data, m_virial_pitch,
+            eval_bond);
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+    #endif
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // for each of the bonds
+    const unsigned int size = (unsigned int)m_bond_data->getN();
+    for (unsigned int i = 0; i < size; i++)
+        {
+        // lookup the tag of each of the particles participating in the bond
+        const typename BondData::members_t& bond = h_bonds.data[i];
+        assert(bond.tag[0] < m_pdata->getMaximumTag()+1);
+        assert(bond.tag[1] < m_pdata->getMaximumTag()+1);
+
+        // transform a and b into indices into the particle data arrays
+        // (MEM TRANSFER: 4 integers)
+        unsigned int idx[2];
+        idx[0] = h_rtag.data[bond.tag[0]];
+        idx[1] = h_rtag.data[bond.tag[1]];
+
+        // throw an error if this bond is incomplete
+        if (idx[0] >= max_local || idx[1] >= max_local)
             {
-            // calculate virial
-            if (compute_virial)
-                {
-                Scalar force_div2r = Scalar(1.0/2.0)*force_divr;
-                bond_virial[0] = dx.x * dx.x * force_div2r; // xx
-                bond_virial[1] = dx.x * dx.y * force_div2r; // xy
-                bond_virial[2] = dx.x * dx.z * force_div2r; // xz
-                bond_virial[3] = dx.y * dx.y * force_div2r; // yy
-                bond_virial[4] = dx.y * dx.z * force_div2r; // yz
-                bond_virial[5] = dx.z * dx.z * force_div2r; // zz
-                }
+            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond " <<
+                bond.tag[0] << " " << bond.tag[1] << " incomplete." << std::endl << std::endl;
+            throw std::runtime_error("Error in bond calculation");
+            }
 
-            // add the force to the particles (only for non-ghost particles)
-            if (idx_b < m_pdata->getN())
-                {
-                h_force.data[idx_b].x += force_divr * dx.x;
-                h_force.data[idx_b].y += force_divr * dx.y;
-                h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
-                if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
-                }
+        Scalar3 f[2];
+        Scalar bond_eng;
+        Scalar bond_virial[6];
+        eval_bond(idx, h_typeval.data[i].type, f, bond_eng, bond_virial);
 
-            if (idx_a < m_pdata->getN())
+        // add the force to the particles (only for non-ghost particles)
+        for (unsigned int j = 0; j < 2; j++)
+            {
+            if (idx[j] < m_pdata->getN())
                 {
-                h_force.data[idx_a].x -= force_divr * dx.x;
-                h_force.data[idx_a].y -= force_divr * dx.y;
-                h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
+                h_force.data[idx[j]].x += f[j].x;
+                h_force.data[idx[j]].y += f[j].y;
+                h_force.data[idx[j]].z += f[j].z;
+                h_force.data[idx[j]].w += bond_eng;
                 if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
+                    for (unsigned int k = 0; k < 6; k++)
+                        h_virial.data[k*m_virial_pitch+idx[j]]  += bond_virial[k];
                 }
             }
-        else
-            {
-            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
         }
 
     if (m_prof) m_prof->pop();
@@ -335,6 +373,8 @@ template < class T > void export_PotentialBond(pybind11::module& m, const std::s
     pybind11::class_<T, std::shared_ptr<T> >(m, name.c_str(),pybind11::base<ForceCompute>())
         .def(pybind11::init< std::shared_ptr<SystemDefinition>, const std::string& > ())
         .def("setParams", &T::setParams)
+        .def("setThreaded", &T::setThreaded)
+        .def("getThreaded", &T::getThreaded)
         ;
     }
 
@@ -28,6 +28,11 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+#include "PairEvaluatorBatch.h"
 
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
@@ -78,6 +83,20 @@
     potential evaluator class passed in. See the appropriate documentation for the evaluator for the definition of each
     element of the parameters.
 
+    Evaluators that provide a static evalForceAndEnergyBatch() (see detail::has_batch_eval) are evaluated
+    detail::ScalarBatch::width neighbors at a time on the CPU with SIMD instructions. Positions and parameters for a
+    block of neighbors are gathered, evaluated together, and accumulated in the same order as the scalar loop. The
+    remainder of the neighbor list, and all potentials that use XPLOR switching, diameter, or charge, are evaluated one
+    pair at a time.
+
+    When the neighbor list also provides cluster pairs (NeighborList::setClusterPairs()), batched evaluators loop over
+    tiles of an i cluster and a j cluster instead. The positions and types are copied in cluster order once per
+    evaluation, so that the coordinates of a j cluster are read with plain vector loads. Each lane of the i cluster is
+    evaluated against all lanes of the j cluster at once, the neighbor masks select the pairs that are accumulated, and
+    the minimum image is applied with vector rounding. Forces on the j particles of a tile (with a half list) are summed
+    over the i lanes before they are added to the particles. Subsets of the particles, as evaluated with the ghost
+    overlap, use the per-particle list.
+
     For profiling and logging, PotentialPair needs to know the name of the potential. For now, that will be queried from
     the evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independently.
@@ -130,9 +149,52 @@ class PotentialPair : public ForceCompute
             m_shift_mode = mode;
             }
 
+        //! Enable or disable threaded evaluation of the forces on the CPU
+        /*! \param threaded True if the particle loop should be split over the TBB threads
+
+            Threaded execution only applies to the CPU code path and requires a build with TBB.
+        */
+        void setThreaded(bool threaded)
+            {
+            #ifndef ENABLE_TBB
+            if (threaded)
+                {
+                m_exec_conf->msg->warning() << "pair." << evaluator::getName()
+                    << ": HOOMD was compiled without TBB, ignoring request for threaded execution" << std::endl;
+                threaded = false;
+                }
+            #endif
+            m_threaded = threaded;
+            }
+
+        //! Get whether threaded evaluation of the forces is enabled
+        bool getThreaded() const
+            {
+            return m_threaded;
+            }
+
+        //! Enable or disable batched SIMD evaluation of the pair forces
+        /*! \param batched True if neighbors should be evaluated in SIMD batches when the evaluator supports it
+
+            This option has no effect for evaluators that do not implement evalForceAndEnergyBatch().
+        */
+        void setBatched(bool batched)
+            {
+            m_batched = batched;
+            }
+
+        //! Get whether batched evaluation of the pair forces is enabled
+        bool getBatched() const
+            {
+            return m_batched;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+
+        //! Compute the forces of the particles without ghost neighbors
+        virtual void computeInterior(unsigned int timestep);
         #endif
 
         //! Calculates the energy between two lists of particles.
@@ -165,10 +227,38 @@ class PotentialPair : public ForceCompute
         GlobalArray<param_type> m_params;              //!< Pair parameters per type pair
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
+        bool m_threaded;                            //!< True if the CPU force loop is split over TBB threads
+        bool m_batched;                             //!< True if neighbors are evaluated in SIMD batches when possible
+        std::vector<Scalar> m_cluster_pos;          //!< x, y, and z lanes of each cluster, in cluster order
+        std::vector<unsigned int> m_cluster_type;   //!< Type of each cluster lane
+
+        #ifdef ENABLE_TBB
+        //! Force and virial accumulation buffer owned by a single TBB thread
+        struct ThreadBuffer
+            {
+            ThreadBuffer() : epoch(0) { }
+
+            std::vector<Scalar4> force;     //!< Force and energy per local particle
+            std::vector<Scalar> virial;     //!< Virial per local particle (6 components, pitch is the buffer size)
+            unsigned int epoch;             //!< Value of m_thread_buffer_epoch when the buffer was last cleared
+            };
+
+        tbb::enumerable_thread_specific<ThreadBuffer> m_thread_buffers; //!< Per-thread buffers for half neighbor lists
+        unsigned int m_thread_buffer_epoch;         //!< Incremented on every threaded half neighbor list evaluation
+        #endif
+
+        #ifdef ENABLE_MPI
+        bool m_interior_computed;                   //!< True if computeInterior() evaluated part of the forces
+        unsigned int m_interior_timestep;           //!< Timestep of the last interior evaluation
+        unsigned int m_interior_num_builds;         //!< Neighbor list builds at the last interior evaluation
+        #endif
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Compute the forces of a subset of the local particles
+        void computeParticleForces(const unsigned int *idx, unsigned int n, bool zero);
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -220,8 +310,15 @@ template < class evaluator >
 PotentialPair< evaluator >::PotentialPair(std::shared_ptr<SystemDefinition> sysdef,
                                                 std::shared_ptr<NeighborList> nlist,
                                                 const std::string& log_suffix)
-    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_typpair_idx(m_pdata->getNTypes())
+    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_typpair_idx(m_pdata->getNTypes()),
+      m_threaded(false), m_batched(true)
     {
+    #ifdef ENABLE_MPI
+    m_interior_computed = false;
+    m_interior_timestep = 0;
+    m_interior_num_builds = 0;
+    #endif
+
     m_exec_conf->msg->notice(5) << "Constructing PotentialPair<" << evaluator::getName() << ">" << std::endl;
 
     assert(m_pdata);
@@ -257,6 +354,11 @@ PotentialPair< evaluator >::PotentialPair(std::shared_ptr<SystemDefinition> sysd
     // initialize name
     m_prof_name = std::string("Pair ") + evaluator::getName();
     m_log_name = std::string("pair_") + evaluator::getName() + std::string("_energy") + log_suffix;
+    m_call_timer->setName(std::string("time_pair_") + evaluator::getName() + log_suffix);
+
+    #ifdef ENABLE_TBB
+    m_thread_buffer_epoch = 0;
+    #endif
 
     // connect to the ParticleData to receive notifications when the maximum number of particles changes
     m_pdata->getNumTypesChangeSignal().template connect<PotentialPair<evaluator>, &PotentialPair<evaluator>::slotNumTypesChange>(this);
@@ -396,6 +498,72 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     // start the profile for this compute
     if (m_prof) m_prof->push(m_prof_name);
 
+    #ifdef ENABLE_MPI
+    if (m_interior_computed && m_interior_timestep == timestep && m_interior_num_builds == m_nlist->getNumBuilds())
+        {
+        // the interior particles were evaluated while the ghost positions were communicated,
+        // add the remaining particles to their forces
+        unsigned int n_interior = 0;
+        const std::vector<unsigned int>& partition = m_nlist->getGhostPartition(n_interior);
+        computeParticleForces(partition.data() + n_interior, (unsigned int)partition.size() - n_interior, false);
+        }
+    else
+    #endif
+        {
+        computeParticleForces(NULL, m_pdata->getN(), true);
+        }
+
+    #ifdef ENABLE_MPI
+    m_interior_computed = false;
+    #endif
+
+    if (m_prof) m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+
+    Called by the integrator while the ghost positions are in flight. Interactions between local particles do not
+    depend on the ghosts, so the forces of the particles without ghost neighbors are evaluated here and computeForces()
+    only needs to add the remaining particles. Nothing is done when the neighbor list is going to be rebuilt on this
+    step, since the particles will then be migrated and reordered. If the list is rebuilt anyway, computeForces() falls
+    back to evaluating all particles.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeInterior(unsigned int timestep)
+    {
+    #ifdef ENABLE_CUDA
+    if (m_exec_conf->isCUDAEnabled())
+        return;
+    #endif
+
+    if (m_nlist->peekUpdate(timestep))
+        return;
+
+    if (!peekCompute(timestep))
+        return;
+
+    if (m_prof) m_prof->push(m_prof_name);
+
+    unsigned int n_interior = 0;
+    const std::vector<unsigned int>& partition = m_nlist->getGhostPartition(n_interior);
+    computeParticleForces(partition.data(), n_interior, true);
+
+    m_interior_computed = true;
+    m_interior_timestep = timestep;
+    m_interior_num_builds = m_nlist->getNumBuilds();
+
+    if (m_prof) m_prof->pop();
+    }
+#endif
+
+/*! \param idx Indices of the local particles to compute, or NULL to compute particles 0 to n-1
+    \param n Number of particles to compute
+    \param zero If true, the force and virial arrays are cleared first, otherwise the forces are added to them
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeParticleForces(const unsigned int *idx, unsigned int n, bool zero)
+    {
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
@@ -412,8 +580,9 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
 
 
     //force arrays
-    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
+    const access_mode::Enum force_mode = zero ? access_mode::overwrite : access_mode::readwrite;
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, force_mode);
+    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, force_mode);
 
 
     const BoxDim& box = m_pdata->getGlobalBox();
@@ -425,12 +594,209 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
     // need to start from a zero force, energy and virial
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+    if (zero)
+        {
+        memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+        memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+        }
 
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    const unsigned int N = m_pdata->getN();
+
+    // batched evaluation only supports the plain and shifted potentials of evaluators without per-particle inputs
+    const bool batched = m_batched && detail::has_batch_eval<evaluator>::value && m_shift_mode != xplor
+                         && !evaluator::needsDiameter() && !evaluator::needsCharge();
+
+    // full evaluations of batched evaluators use the cluster pair list when the neighbor list provides it
+    const unsigned int W = NeighborList::cluster_size;
+    const bool use_clusters = batched && !idx && m_nlist->getClusterPairs() && m_nlist->getNClusters() > 0;
+    if (use_clusters)
         {
+        // copy the positions and types in cluster order, unused lanes are masked out
+        const std::vector<unsigned int>& members = m_nlist->getClusterMembers();
+        m_cluster_pos.resize(3*members.size());
+        m_cluster_type.resize(members.size());
+        for (unsigned int c = 0; c < m_nlist->getNClusters(); c++)
+            {
+            for (unsigned int l = 0; l < W; l++)
+                {
+                const unsigned int j = members[c*W + l];
+                Scalar4 postype = j == UINT_MAX ? make_scalar4(0, 0, 0, __int_as_scalar(0)) : h_pos.data[j];
+                m_cluster_pos[3*W*c + l] = postype.x;
+                m_cluster_pos[3*W*c + W + l] = postype.y;
+                m_cluster_pos[3*W*c + 2*W + l] = postype.z;
+                m_cluster_type[W*c + l] = __scalar_as_int(postype.w);
+                }
+            }
+        }
+
+    // computes the interactions of the particles in i cluster ci and accumulates them into the given arrays
+    auto compute_cluster = [&](unsigned int ci, Scalar4 *force, Scalar *virial, unsigned int virial_pitch)
+        {
+        typedef detail::ScalarBatch batch;
+        const std::vector<unsigned int>& members = m_nlist->getClusterMembers();
+        const std::vector<unsigned int>& pair_head = m_nlist->getClusterPairHead();
+        const std::vector<unsigned int>& pair_j = m_nlist->getClusterPairJ();
+        const std::vector<unsigned int>& pair_mask = m_nlist->getClusterPairMask();
+
+        const Scalar *pos_i = &m_cluster_pos[3*W*ci];
+        const unsigned int *type_i = &m_cluster_type[W*ci];
+        const batch zero(Scalar(0.0));
+        const batch half(Scalar(0.5));
+
+        // sums over the j lanes for each i lane
+        batch fxi[W], fyi[W], fzi[W], ei[W], vi[6][W];
+        for (unsigned int li = 0; li < W; li++)
+            {
+            fxi[li] = fyi[li] = fzi[li] = ei[li] = zero;
+            for (unsigned int c = 0; c < 6; c++)
+                vi[c][li] = zero;
+            }
+
+        for (unsigned int p = pair_head[ci]; p < pair_head[ci+1]; p++)
+            {
+            const unsigned int cj = pair_j[p];
+            const unsigned int *mask = &pair_mask[W*p];
+            const unsigned int *type_j = &m_cluster_type[W*cj];
+            const batch xj = batch::load(&m_cluster_pos[3*W*cj]);
+            const batch yj = batch::load(&m_cluster_pos[3*W*cj + W]);
+            const batch zj = batch::load(&m_cluster_pos[3*W*cj + 2*W]);
+
+            // sums over the i lanes for each j lane (third law)
+            batch fxj = zero, fyj = zero, fzj = zero, ej = zero, vj[6];
+            for (unsigned int c = 0; c < 6; c++)
+                vj[c] = zero;
+
+            for (unsigned int li = 0; li < W; li++)
+                {
+                if (!mask[li])
+                    continue;
+
+                batch dx = batch(pos_i[li]) - xj;
+                batch dy = batch(pos_i[W + li]) - yj;
+                batch dz = batch(pos_i[2*W + li]) - zj;
+                detail::minImage(box, dx, dy, dz);
+
+                Scalar rsq[W];
+                (dx*dx + dy*dy + dz*dz).store(rsq);
+
+                unsigned int typpair[W];
+                for (unsigned int l = 0; l < W; l++)
+                    typpair[l] = m_typpair_idx(type_i[li], type_j[l]);
+
+                Scalar force_divr[W];
+                Scalar pair_eng[W];
+                unsigned int evaluated = detail::evalForceAndEnergyBatch<evaluator>(rsq,
+                                                                                   typpair,
+                                                                                   h_rcutsq.data,
+                                                                                   h_params.data,
+                                                                                   force_divr,
+                                                                                   pair_eng,
+                                                                                   m_shift_mode == shift);
+
+                // lanes that are not neighbors (including the particle itself) may hold inf or nan
+                evaluated &= mask[li];
+                for (unsigned int l = 0; l < W; l++)
+                    {
+                    if (!(evaluated & (1u << l)))
+                        force_divr[l] = pair_eng[l] = Scalar(0.0);
+                    }
+
+                const batch f = batch::load(force_divr);
+                const batch e = half * batch::load(pair_eng);
+                const batch fx = dx*f, fy = dy*f, fz = dz*f;
+                fxi[li] = fxi[li] + fx;
+                fyi[li] = fyi[li] + fy;
+                fzi[li] = fzi[li] + fz;
+                ei[li] = ei[li] + e;
+                if (third_law)
+                    {
+                    fxj = fxj - fx;
+                    fyj = fyj - fy;
+                    fzj = fzj - fz;
+                    ej = ej + e;
+                    }
+
+                if (compute_virial)
+                    {
+                    const batch f2 = half * f;
+                    const batch v[6] = {f2*dx*dx, f2*dx*dy, f2*dx*dz, f2*dy*dy, f2*dy*dz, f2*dz*dz};
+                    for (unsigned int c = 0; c < 6; c++)
+                        {
+                        vi[c][li] = vi[c][li] + v[c];
+                        if (third_law)
+                            vj[c] = vj[c] + v[c];
+                        }
+                    }
+                }
+
+            if (third_law)
+                {
+                // only add forces to local particles
+                Scalar fj[4][W], vjl[6][W];
+                fxj.store(fj[0]);
+                fyj.store(fj[1]);
+                fzj.store(fj[2]);
+                ej.store(fj[3]);
+                for (unsigned int c = 0; c < 6; c++)
+                    vj[c].store(vjl[c]);
+
+                for (unsigned int l = 0; l < W; l++)
+                    {
+                    const unsigned int j = members[W*cj + l];
+                    if (j >= N)
+                        continue;
+
+                    force[j].x += fj[0][l];
+                    force[j].y += fj[1][l];
+                    force[j].z += fj[2][l];
+                    force[j].w += fj[3][l];
+                    if (compute_virial)
+                        {
+                        for (unsigned int c = 0; c < 6; c++)
+                            virial[c*virial_pitch + j] += vjl[c][l];
+                        }
+                    }
+                }
+            }
+
+        // reduce the j lanes and add the sums to the i particles
+        for (unsigned int li = 0; li < W; li++)
+            {
+            const unsigned int i = members[W*ci + li];
+            if (i >= N)
+                continue;
+
+            Scalar sum[10][W];
+            fxi[li].store(sum[0]);
+            fyi[li].store(sum[1]);
+            fzi[li].store(sum[2]);
+            ei[li].store(sum[3]);
+            for (unsigned int c = 0; c < 6; c++)
+                vi[c][li].store(sum[4 + c]);
+
+            Scalar total[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+            for (unsigned int c = 0; c < 10; c++)
+                for (unsigned int l = 0; l < W; l++)
+                    total[c] += sum[c][l];
+
+            force[i].x += total[0];
+            force[i].y += total[1];
+            force[i].z += total[2];
+            force[i].w += total[3];
+            if (compute_virial)
+                {
+                for (unsigned int c = 0; c < 6; c++)
+                    virial[c*virial_pitch + i] += total[4 + c];
+                }
+            }
+        };
+
+    // computes the interactions of particle i and accumulates them into the given force and virial arrays
+    auto compute_particle = [&](unsigned int i, Scalar4 *force, Scalar *virial, unsigned int virial_pitch)
+        {
+        if (idx)
+            i = idx[i];
+
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         unsigned int typei = __scalar_as_int(h_pos.data[i].w);
@@ -456,10 +822,98 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
         Scalar virialyzi = 0.0;
         Scalar virialzzi = 0.0;
 
+        // adds the interaction with neighbor j to particle i, and to particle j when using the third law
+        auto accumulate = [&](unsigned int j, const Scalar3& dx, Scalar force_divr, Scalar pair_eng)
+            {
+            Scalar force_div2r = force_divr * Scalar(0.5);
+            // add the force, potential energy and virial to the particle i
+            // (FLOPS: 8)
+            fi += dx*force_divr;
+            pei += pair_eng * Scalar(0.5);
+            if (compute_virial)
+                {
+                virialxxi += force_div2r*dx.x*dx.x;
+                virialxyi += force_div2r*dx.x*dx.y;
+                virialxzi += force_div2r*dx.x*dx.z;
+                virialyyi += force_div2r*dx.y*dx.y;
+                virialyzi += force_div2r*dx.y*dx.z;
+                virialzzi += force_div2r*dx.z*dx.z;
+                }
+
+            // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
+            // only add force to local particles
+            if (third_law && j < N)
+                {
+                unsigned int mem_idx = j;
+                force[mem_idx].x -= dx.x*force_divr;
+                force[mem_idx].y -= dx.y*force_divr;
+                force[mem_idx].z -= dx.z*force_divr;
+                force[mem_idx].w += pair_eng * Scalar(0.5);
+                if (compute_virial)
+                    {
+                    virial[0*virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
+                    virial[1*virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
+                    virial[2*virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
+                    virial[3*virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
+                    virial[4*virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
+                    virial[5*virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                    }
+                }
+            };
+
         // loop over all of the neighbors of this particle
         const unsigned int myHead = h_head_list.data[i];
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
+        unsigned int k = 0;
+
+        if (batched)
+            {
+            // evaluate full blocks of neighbors together, the remainder is handled by the scalar loop below
+            const unsigned int W = detail::ScalarBatch::width;
+            for (; k + W <= size; k += W)
+                {
+                unsigned int j_batch[W];
+                unsigned int typpair_batch[W];
+                Scalar3 dx_batch[W];
+                Scalar rsq_batch[W];
+                Scalar force_divr_batch[W];
+                Scalar pair_eng_batch[W];
+
+                // gather the neighbor positions and type pairs
+                for (unsigned int l = 0; l < W; l++)
+                    {
+                    unsigned int j = h_nlist.data[myHead + k + l];
+                    assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                    Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                    Scalar3 dx = box.minImage(pi - pj);
+
+                    unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                    assert(typej < m_pdata->getNTypes());
+
+                    j_batch[l] = j;
+                    typpair_batch[l] = m_typpair_idx(typei, typej);
+                    dx_batch[l] = dx;
+                    rsq_batch[l] = dot(dx, dx);
+                    }
+
+                unsigned int evaluated = detail::evalForceAndEnergyBatch<evaluator>(rsq_batch,
+                                                                                   typpair_batch,
+                                                                                   h_rcutsq.data,
+                                                                                   h_params.data,
+                                                                                   force_divr_batch,
+                                                                                   pair_eng_batch,
+                                                                                   m_shift_mode == shift);
+
+                for (unsigned int l = 0; l < W; l++)
+                    {
+                    if (evaluated & (1u << l))
+                        accumulate(j_batch[l], dx_batch[l], force_divr_batch[l], pair_eng_batch[l]);
+                    }
+                }
+            }
+
+        for (; k < size; k++)
             {
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
             unsigned int j = h_nlist.data[myHead + k];
@@ -546,61 +1000,114 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
                         }
                     }
 
-                Scalar force_div2r = force_divr * Scalar(0.5);
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += dx*force_divr;
-                pei += pair_eng * Scalar(0.5);
-                if (compute_virial)
-                    {
-                    virialxxi += force_div2r*dx.x*dx.x;
-                    virialxyi += force_div2r*dx.x*dx.y;
-                    virialxzi += force_div2r*dx.x*dx.z;
-                    virialyyi += force_div2r*dx.y*dx.y;
-                    virialyzi += force_div2r*dx.y*dx.z;
-                    virialzzi += force_div2r*dx.z*dx.z;
-                    }
-
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
-                // only add force to local particles
-                if (third_law && j < m_pdata->getN())
-                    {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
-                    if (compute_virial)
-                        {
-                        h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
-                        h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
-                        h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
-                        h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
-                        h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
-                        h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
-                        }
-                    }
+                accumulate(j, dx, force_divr, pair_eng);
                 }
             }
 
         // finally, increment the force, potential energy and virial for particle i
         unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
         if (compute_virial)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
-            h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
-            h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
-            h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
-            h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
-            h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+            virial[0*virial_pitch+mem_idx] += virialxxi;
+            virial[1*virial_pitch+mem_idx] += virialxyi;
+            virial[2*virial_pitch+mem_idx] += virialxzi;
+            virial[3*virial_pitch+mem_idx] += virialyyi;
+            virial[4*virial_pitch+mem_idx] += virialyzi;
+            virial[5*virial_pitch+mem_idx] += virialzzi;
             }
+        };
+
+    // evaluates one i cluster or one particle
+    auto compute_item = [&](unsigned int item, Scalar4 *force, Scalar *virial, unsigned int virial_pitch)
+        {
+        if (use_clusters)
+            compute_cluster(item, force, virial, virial_pitch);
+        else
+            compute_particle(item, force, virial, virial_pitch);
+        };
+    const unsigned int n_items = use_clusters ? m_nlist->getNClusters() : n;
+
+    #ifdef ENABLE_TBB
+    if (m_threaded && !third_law)
+        {
+        // with a full neighbor list each particle only writes to its own force and virial
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_items),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                compute_item(i, h_force.data, h_virial.data, m_virial_pitch);
+            });
         }
+    else if (m_threaded)
+        {
+        // with a half neighbor list, accumulate into per-thread buffers first
+        const unsigned int epoch = ++m_thread_buffer_epoch;
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_items),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            ThreadBuffer& buf = m_thread_buffers.local();
+            if (buf.epoch != epoch)
+                {
+                // first use of this buffer in this evaluation, clear it
+                buf.force.assign(N, make_scalar4(0,0,0,0));
+                buf.virial.assign(6*N, Scalar(0.0));
+                buf.epoch = epoch;
+                }
 
-    if (m_prof) m_prof->pop();
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                compute_item(i, buf.force.data(), buf.virial.data(), N);
+            });
+
+        // collect the buffers that were written in this evaluation
+        std::vector<const ThreadBuffer *> active;
+        for (auto it = m_thread_buffers.begin(); it != m_thread_buffers.end(); ++it)
+            {
+            if (it->epoch == epoch)
+                active.push_back(&(*it));
+            }
+
+        // reduce the per-thread buffers into the force and virial arrays, the third law writes to any local particle
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                Scalar4 f = make_scalar4(0,0,0,0);
+                Scalar v[6] = {0,0,0,0,0,0};
+                for (const ThreadBuffer *buf : active)
+                    {
+                    const Scalar4& fb = buf->force[i];
+                    f.x += fb.x; f.y += fb.y; f.z += fb.z; f.w += fb.w;
+                    if (compute_virial)
+                        {
+                        for (unsigned int l = 0; l < 6; l++)
+                            v[l] += buf->virial[l*N+i];
+                        }
+                    }
+
+                h_force.data[i].x += f.x;
+                h_force.data[i].y += f.y;
+                h_force.data[i].z += f.z;
+                h_force.data[i].w += f.w;
+                if (compute_virial)
+                    {
+                    for (unsigned int l = 0; l < 6; l++)
+                        h_virial.data[l*m_virial_pitch+i] += v[l];
+                    }
+                }
+            });
+        }
+    else
+    #endif
+        {
+        // for each particle or cluster
+        for (unsigned int i = 0; i < n_items; i++)
+            compute_item(i, h_force.data, h_virial.data, m_virial_pitch);
+        }
     }
 
 #ifdef ENABLE_MPI
@@ -822,6 +1329,10 @@ template < class T > void export_PotentialPair(pybind11::module& m, const std::s
         .def("setRcut", &T::setRcut)
         .def("setRon", &T::setRon)
         .def("setShiftMode", &T::setShiftMode)
+        .def("setThreaded", &T::setThreaded)
+        .def("getThreaded", &T::getThreaded)
+        .def("setBatched", &T::setBatched)
+        .def("getBatched", &T::getBatched)
         .def("computeEnergyBetweenSets", &T::computeEnergyBetweenSetsPythonList)
         .def("slotWriteGSDShapeSpec", &T::slotWriteGSDShapeSpec)
         .def("connectGSDShapeSpec", &T::connectGSDShapeSpec)
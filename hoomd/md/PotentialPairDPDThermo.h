@@ -63,6 +63,9 @@ class PotentialPairDPDThermo : public PotentialPair<evaluator>
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+
+        //! The thermostat forces are always computed in one pass
+        virtual void computeInterior(unsigned int timestep) { }
         #endif
 
     protected:
@@ -152,8 +155,10 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
     memset((void*)h_force.data,0,sizeof(Scalar4)*this->m_force.getNumElements());
     memset((void*)h_virial.data,0,sizeof(Scalar)*this->m_virial.getNumElements());
 
-    // for each particle
-    for (int i = 0; i < (int)this->m_pdata->getN(); i++)
+    const unsigned int N = this->m_pdata->getN();
+
+    // computes the interactions of particle i and accumulates them into the given force and virial arrays
+    auto compute_particle = [&](unsigned int i, Scalar4 *force, Scalar *virial, unsigned int virial_pitch)
         {
         // access the particle's position, velocity, and type (MEM TRANSFER: 7 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -254,24 +259,95 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
                 if (third_law)
                     {
                     unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    force[mem_idx].x -= dx.x*force_divr;
+                    force[mem_idx].y -= dx.y*force_divr;
+                    force[mem_idx].z -= dx.z*force_divr;
+                    force[mem_idx].w += pair_eng * Scalar(0.5);
                     for (unsigned int l = 0; l < 6; l++)
-                        h_virial.data[l * this->m_virial_pitch + mem_idx] += pair_virial[l];
+                        virial[l * virial_pitch + mem_idx] += pair_virial[l];
                     }
                 }
             }
 
         // finally, increment the force, potential energy and virial for particle i
         unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
         for (unsigned int l = 0; l < 6; l++)
-            h_virial.data[l * this->m_virial_pitch + mem_idx] += viriali[l];
+            virial[l * virial_pitch + mem_idx] += viriali[l];
+        };
+
+    #ifdef ENABLE_TBB
+    if (this->m_threaded && !third_law)
+        {
+        // with a full neighbor list each particle only writes to its own force and virial
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                compute_particle(i, h_force.data, h_virial.data, this->m_virial_pitch);
+            });
+        }
+    else if (this->m_threaded)
+        {
+        // with a half neighbor list, accumulate into per-thread buffers first
+        typedef typename PotentialPair<evaluator>::ThreadBuffer ThreadBuffer;
+        const unsigned int epoch = ++this->m_thread_buffer_epoch;
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            ThreadBuffer& buf = this->m_thread_buffers.local();
+            if (buf.epoch != epoch)
+                {
+                // ghost particles may receive forces from the third law here, size the buffer to include them
+                buf.force.assign(this->m_force.getNumElements(), make_scalar4(0,0,0,0));
+                buf.virial.assign(6*this->m_force.getNumElements(), Scalar(0.0));
+                buf.epoch = epoch;
+                }
+
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                compute_particle(i, buf.force.data(), buf.virial.data(), this->m_force.getNumElements());
+            });
+
+        // collect the buffers that were written in this evaluation
+        std::vector<const ThreadBuffer *> active;
+        for (auto it = this->m_thread_buffers.begin(); it != this->m_thread_buffers.end(); ++it)
+            {
+            if (it->epoch == epoch)
+                active.push_back(&(*it));
+            }
+
+        // reduce the per-thread buffers into the force and virial arrays
+        const unsigned int n_elem = this->m_force.getNumElements();
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_elem),
+            [&](const tbb::blocked_range<unsigned int>& r)
+            {
+            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                Scalar4 f = make_scalar4(0,0,0,0);
+                Scalar v[6] = {0,0,0,0,0,0};
+                for (const ThreadBuffer *buf : active)
+                    {
+                    const Scalar4& fb = buf->force[i];
+                    f.x += fb.x; f.y += fb.y; f.z += fb.z; f.w += fb.w;
+                    for (unsigned int l = 0; l < 6; l++)
+                        v[l] += buf->virial[l*n_elem+i];
+                    }
+
+                h_force.data[i] = f;
+                for (unsigned int l = 0; l < 6; l++)
+                    h_virial.data[l*this->m_virial_pitch+i] = v[l];
+                }
+            });
+        }
+    else
+    #endif
+        {
+        // for each particle
+        for (unsigned int i = 0; i < N; i++)
+            compute_particle(i, h_force.data, h_virial.data, this->m_virial_pitch);
         }
 
     if (this->m_prof) this->m_prof->pop();
@@ -5,6 +5,7 @@
 // Maintainer: phillicl
 
 #include "TableDihedralForceCompute.h"
+#include "BondedForceThreaded.h"
 #include "hoomd/VectorMath.h"
 
 namespace py = pybind11;
@@ -30,7 +31,7 @@ using namespace std;
 TableDihedralForceCompute::TableDihedralForceCompute(std::shared_ptr<SystemDefinition> sysdef,
                                unsigned int table_width,
                                const std::string& log_suffix)
-        : ForceCompute(sysdef), m_table_width(table_width)
+        : ForceCompute(sysdef), m_table_width(table_width), m_threaded(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing TableDihedralForceCompute" << endl;
 
@@ -98,6 +99,23 @@ void TableDihedralForceCompute::setTable(unsigned int type,
         }
     }
 
+/*! \param threaded True if the particles should be split over the TBB threads
+
+    Threaded execution only applies to the CPU code path and requires a build with TBB.
+*/
+void TableDihedralForceCompute::setThreaded(bool threaded)
+    {
+    #ifndef ENABLE_TBB
+    if (threaded)
+        {
+        m_exec_conf->msg->warning() << "dihedral.table: HOOMD was compiled without TBB, ignoring request for threaded "
+            << "execution" << endl;
+        threaded = false;
+        }
+    #endif
+    m_threaded = threaded;
+    }
+
 /*! TableDihedralForceCompute provides
     - \c dihedral_table_energy
 */
@@ -136,7 +154,6 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
@@ -156,37 +173,14 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
 
-    // for each of the dihedrals
-    const unsigned int size = (unsigned int)m_dihedral_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // evaluate the dihedral between the particles idx[0], idx[1], idx[2], and idx[3]
+    auto eval_dihedral = [&](const unsigned int *idx, unsigned int dihedral_type, Scalar3 *f_abcd,
+        Scalar& dihedral_eng, Scalar *dihedral_virial)
         {
-        // lookup the tag of each of the particles participating in the dihedral
-        const DihedralData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
-        assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[3] <= m_pdata->getMaximumTag());
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[dihedral.tag[0]];
-        unsigned int idx_b = h_rtag.data[dihedral.tag[1]];
-        unsigned int idx_c = h_rtag.data[dihedral.tag[2]];
-        unsigned int idx_d = h_rtag.data[dihedral.tag[3]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
-                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in dihedral calculation");
-            }
-
-        assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_d < m_pdata->getN()+m_pdata->getNGhosts());
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
+        unsigned int idx_c = idx[2];
+        unsigned int idx_d = idx[3];
 
         // calculate d\vec{r}
         Scalar3 dab;
@@ -276,7 +270,6 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         // compute index into the table and read in values
 
         /// Here we use the table!!
-        unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
         unsigned int value_i = value_f;
         Scalar2 VT0 = h_tables.data[m_table_value(value_i, dihedral_type)];
         Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, dihedral_type)];
@@ -308,11 +301,10 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         // Now, apply the force to each individual atom a,b,c,d
         // and accumulate the energy/virial
         // compute 1/4 of the energy, 1/4 for each atom in the dihedral
-        Scalar dihedral_eng = V*Scalar(0.25);  // the .125 term comes from distributing over the four particles
+        dihedral_eng = V*Scalar(0.25);  // the .125 term comes from distributing over the four particles
 
         // compute 1/4 of the virial, 1/4 for each atom in the dihedral
         // upper triangular version of virial tensor
-        Scalar dihedral_virial[6];
         dihedral_virial[0] = (1./4.)*(dab.x*f_a.x + dcb.x*f_c.x + (ddc.x+dcb.x)*f_d.x);
         dihedral_virial[1] = (1./4.)*(dab.y*f_a.x + dcb.y*f_c.x + (ddc.y+dcb.y)*f_d.x);
         dihedral_virial[2] = (1./4.)*(dab.z*f_a.x + dcb.z*f_c.x + (ddc.z+dcb.z)*f_d.x);
@@ -320,34 +312,76 @@ void TableDihedralForceCompute::computeForces(unsigned int timestep)
         dihedral_virial[4] = (1./4.)*(dab.z*f_a.y + dcb.z*f_c.y + (ddc.z+dcb.z)*f_d.y);
         dihedral_virial[5] = (1./4.)*(dab.z*f_a.z + dcb.z*f_c.z + (ddc.z+dcb.z)*f_d.z);
 
-        h_force.data[idx_a].x += f_a.x;
-        h_force.data[idx_a].y += f_a.y;
-        h_force.data[idx_a].z += f_a.z;
-        h_force.data[idx_a].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_a]  += dihedral_virial[k];
-
-        h_force.data[idx_b].x += f_b.x;
-        h_force.data[idx_b].y += f_b.y;
-        h_force.data[idx_b].z += f_b.z;
-        h_force.data[idx_b].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_b]  += dihedral_virial[k];
-
-        h_force.data[idx_c].x += f_c.x;
-        h_force.data[idx_c].y += f_c.y;
-        h_force.data[idx_c].z += f_c.z;
-        h_force.data[idx_c].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_c]  += dihedral_virial[k];
-
-        h_force.data[idx_d].x += f_d.x;
-        h_force.data[idx_d].y += f_d.y;
-        h_force.data[idx_d].z += f_d.z;
-        h_force.data[idx_d].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_d]  += dihedral_virial[k];
-       }
+        f_abcd[0] = f_a;
+        f_abcd[1] = f_b;
+        f_abcd[2] = f_c;
+        f_abcd[3] = f_d;
+        };
+
+    #ifdef ENABLE_TBB
+    if (m_threaded)
+        {
+        // sum the dihedrals of each particle, ghost particles receive forces as in the serial loop
+        computeBondedForcesThreaded(*m_dihedral_data, m_pdata->getN() + m_pdata->getNGhosts(), h_force.data,
+            h_virial.data, virial_pitch, eval_dihedral);
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+    #endif
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    // for each of the dihedrals
+    const unsigned int size = (unsigned int)m_dihedral_data->getN();
+    for (unsigned int i = 0; i < size; i++)
+        {
+        // lookup the tag of each of the particles participating in the dihedral
+        const DihedralData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
+        assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
+        assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
+        assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
+        assert(dihedral.tag[3] <= m_pdata->getMaximumTag());
+
+        // transform a and b into indices into the particle data arrays
+        // (MEM TRANSFER: 4 integers)
+        unsigned int idx[4];
+        idx[0] = h_rtag.data[dihedral.tag[0]];
+        idx[1] = h_rtag.data[dihedral.tag[1]];
+        idx[2] = h_rtag.data[dihedral.tag[2]];
+        idx[3] = h_rtag.data[dihedral.tag[3]];
+
+        // throw an error if this angle is incomplete
+        if (idx[0] == NOT_LOCAL|| idx[1] == NOT_LOCAL || idx[2] == NOT_LOCAL || idx[3] == NOT_LOCAL)
+            {
+            this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
+                dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
+                << " incomplete." << endl << endl;
+            throw std::runtime_error("Error in dihedral calculation");
+            }
+
+        assert(idx[0] < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx[1] < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx[2] < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx[3] < m_pdata->getN()+m_pdata->getNGhosts());
+
+        Scalar3 f_abcd[4];
+        Scalar dihedral_eng;
+        Scalar dihedral_virial[6];
+        eval_dihedral(idx, m_dihedral_data->getTypeByIndex(i), f_abcd, dihedral_eng, dihedral_virial);
+
+        // Now, apply the force to each individual atom a,b,c,d
+        // and accumulate the energy/virial
+        for (unsigned int j = 0; j < 4; j++)
+            {
+            h_force.data[idx[j]].x += f_abcd[j].x;
+            h_force.data[idx[j]].y += f_abcd[j].y;
+            h_force.data[idx[j]].z += f_abcd[j].z;
+            h_force.data[idx[j]].w += dihedral_eng;
+            for (int k = 0; k < 6; k++)
+               h_virial.data[virial_pitch*k+idx[j]]  += dihedral_virial[k];
+            }
+        }
 
     if (m_prof) m_prof->pop();
     }
@@ -359,5 +393,7 @@ void export_TableDihedralForceCompute(py::module& m)
     .def(py::init< std::shared_ptr<SystemDefinition>, unsigned int, const std::string& >())
     .def("setTable", &TableDihedralForceCompute::setTable)
     .def("getEntry", &TableDihedralForceCompute::getEntry)
+    .def("setThreaded", &TableDihedralForceCompute::setThreaded)
+    .def("getThreaded", &TableDihedralForceCompute::getThreaded)
     ;
     }
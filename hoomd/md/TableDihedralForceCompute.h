@@ -73,6 +73,15 @@ class PYBIND11_EXPORT TableDihedralForceCompute : public ForceCompute
         //! Calculates the requested log value and returns it
         virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
 
+        //! Enable or disable threaded evaluation of the forces on the CPU
+        void setThreaded(bool threaded);
+
+        //! Get whether threaded evaluation of the forces is enabled
+        bool getThreaded() const
+            {
+            return m_threaded;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         /*! \param timestep Current time step
@@ -105,6 +114,7 @@ class PYBIND11_EXPORT TableDihedralForceCompute : public ForceCompute
         GPUArray<Scalar2> m_tables;                  //!< Stored V and F tables
         Index2D m_table_value;                      //!< Index table helper
         std::string m_log_name;                     //!< Cached log name
+        bool m_threaded;                            //!< True if the CPU force loop is split over TBB threads
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
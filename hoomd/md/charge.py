@@ -220,6 +220,38 @@ class pppm(force._force):
         # set the parameters for the appropriate type
         self.cpp_force.setParams(Nx, Ny, Nz, order, kappa, rcut, alpha);
 
+    def set_threaded(self, threaded=True):
+        R""" Enable or disable threaded execution on the CPU.
+
+        Args:
+            threaded (bool): Use the TBB threads when True.
+
+        When enabled, charge assignment, force interpolation, the local FFTs, and the short range part of the
+        electrostatics use all threads set with :py:func:`hoomd.option.set_num_threads()` or ``--nthreads``.
+        Each thread assigns charges to a private mesh and the meshes are summed at the end, so results differ from
+        the serial computation by floating point round off. With MPI domain decomposition, the distributed FFT is
+        not threaded.
+
+        Threaded execution is disabled by default and has no effect on the GPU.
+
+        Examples::
+
+            pppm.set_threaded()
+            pppm.set_threaded(False)
+
+        """
+        hoomd.util.print_status_line();
+
+        if threaded and not _hoomd.is_TBB_available():
+            hoomd.context.msg.warning("HOOMD was compiled without thread support, ignoring request for threaded execution.\n");
+            return;
+
+        self.cpp_force.setThreaded(bool(threaded));
+
+        hoomd.util.quiet_status();
+        self.ewald.set_threaded(threaded);
+        hoomd.util.unquiet_status();
+
     def update_coeffs(self):
         if not self.params_set:
             hoomd.context.msg.error("Coefficients for PPPM are not set. Call set_coeff prior to run()\n");
@@ -139,6 +139,75 @@ class _force(hoomd.meta._metadata):
         self.enabled = True;
         self.log = True;
 
+    def set_mts_period(self, period):
+        R""" Apply the force every few time steps (multiple time step integration).
+
+        Args:
+            period (int): Number of time steps between evaluations of the force.
+
+        Examples::
+
+            pppm.set_mts_period(4)
+            table.set_mts_period(2)
+
+        Slowly varying forces, such as the long range part of :py:class:`hoomd.md.charge.pppm`, need not be evaluated
+        as often as the short range forces that limit the time step. With *period* > 1, the force is only computed on
+        time steps that are a multiple of *period*, and the integrator applies it as an impulse *period* times larger
+        on those steps (the impulse form of r-RESPA). All other forces are applied every step. This works with all
+        integration methods in :py:class:`hoomd.md.integrate.mode_standard`.
+
+        Choose *period* so that *period* times the time step remains well below the time scale on which the force
+        varies, otherwise the integration becomes unstable. On the steps in between, the energy and virial of this
+        force are those of its last evaluation, so logged energies and pressures lag by up to *period* steps. The
+        net force of the particles includes the impulse on the steps where the force is applied.
+
+        Note:
+            Multiple time step integration is not supported on the GPU.
+
+        """
+        hoomd.util.print_status_line();
+        self.check_initialization();
+
+        period = int(period);
+        if period < 1:
+            hoomd.context.msg.error("The multiple time step period must be positive\n");
+            raise ValueError("Error setting multiple time step period");
+
+        self.cpp_force.setMTSPeriod(period);
+
+    def set_threaded(self, threaded=True):
+        R""" Enable or disable threaded evaluation of the force on the CPU.
+
+        Args:
+            threaded (bool): Split the loop over particles over the TBB threads when True.
+
+        Examples::
+
+            harmonic.set_threaded()
+            opls.set_threaded(False)
+
+        When enabled, the force computation uses all threads set with :py:func:`hoomd.option.set_num_threads()` or
+        ``--nthreads``. Bond, angle, and dihedral forces that support threading compute the force on each particle from
+        the groups it belongs to, so each group is evaluated once per member and results differ from the serial
+        computation by floating point round off.
+
+        Threaded evaluation is disabled by default and has no effect on the GPU. An error is raised for forces that
+        do not implement it.
+
+        """
+        hoomd.util.print_status_line();
+        self.check_initialization();
+
+        if not hasattr(self.cpp_force, "setThreaded"):
+            hoomd.context.msg.error("Threaded execution is not implemented for {}\n".format(self.__class__.__name__));
+            raise RuntimeError("Error changing parameters in force");
+
+        if threaded and not _hoomd.is_TBB_available():
+            hoomd.context.msg.warning("HOOMD was compiled without thread support, ignoring request for threaded execution.\n");
+            return;
+
+        self.cpp_force.setThreaded(bool(threaded));
+
     def get_energy(self,group):
         R""" Get the energy of a particle group.
 
@@ -195,6 +195,41 @@ class nlist:
         if d_max is not None:
             self.cpp_nlist.setMaximumDiameter(d_max);
 
+    def set_cluster_pairs(self, enable=True):
+        R""" Store the neighbor list as pairs of particle clusters for SIMD pair forces on the CPU.
+
+        Args:
+            enable (bool): Set to True to build the cluster pair list after every neighbor list build.
+
+        Particles that are close in space are grouped into clusters of 4, 8, or 16 (the number of values in a SIMD
+        register of the build: 4 with AVX in double precision or without AVX, 8 with AVX in single precision or
+        AVX-512 in double precision, and 16 with AVX-512 in single precision). The neighbor list then also stores, for each cluster, the clusters that contain its neighbors and
+        a mask of the neighboring particle pairs. Pair potentials that support SIMD evaluation (currently
+        :py:class:`hoomd.md.pair.lj`) evaluate one particle against a whole cluster at once with contiguous memory
+        loads instead of gathering the neighbors one at a time.
+
+        The cluster pair list is built from the regular neighbor list after each update, so all exclusions, filters,
+        and cutoffs apply, and all other forces keep using the regular list. Forces are summed in a different order,
+        so results agree with those of the regular list to within floating point round-off. Check the neighbor
+        fraction reported in the neighbor list statistics: it is the fraction of the evaluated particle pairs that
+        are neighbors.
+
+        The cluster pair list is disabled by default and not supported on the GPU.
+
+        Examples::
+
+            nl.set_cluster_pairs()
+            nl.set_cluster_pairs(False)
+
+        """
+        hoomd.util.print_status_line();
+
+        if self.cpp_nlist is None:
+            hoomd.context.msg.error('Bug in hoomd: cpp_nlist not set, please report\n');
+            raise RuntimeError('Error setting neighbor list parameters');
+
+        self.cpp_nlist.setClusterPairs(bool(enable));
+
     def reset_exclusions(self, exclusions = None):
         R""" Resets all exclusions in the neighborlist.
 
@@ -443,6 +478,51 @@ class nlist:
         # return the results to the script
         return (fastest_r_buff, self.query_update_period());
 
+    def autotune(self, enable=True, r_min=0.05, r_max=1.0, period=1000, tolerance=0.02, check_period=True):
+        R""" Tune r_buff and check_period while the simulation runs.
+
+        Args:
+            enable (bool): Set to False to stop tuning and keep the current values
+            r_min (float): Smallest value of r_buff to set (in distance units)
+            r_max (float): Largest value of r_buff to set (in distance units)
+            period (int): Number of time steps to time each r_buff value
+            tolerance (float): Relative speedup a new r_buff value needs to be kept
+            check_period (bool): Set to False to leave check_period unchanged
+
+        Unlike :py:meth:`tune()`, which scans r_buff with separate :py:func:`hoomd.run()` calls before production,
+        :py:meth:`autotune()` adjusts r_buff during the runs. Use it when the best value changes over a simulation,
+        e.g. when the system moves between dense and dilute states.
+
+        The neighbor list times *period* consecutive time steps, then moves r_buff up or down by
+        ``(r_max - r_min)/16``. It keeps the new value when the time per step drops by more than *tolerance*,
+        otherwise it returns to the previous value and tries the other direction. When neither direction is faster,
+        it waits a few periods before searching again. The timings cover the whole time step, so they include both
+        the neighbor list builds and the extra pairs in the force computations.
+
+        When *check_period* is True, the check period is halved after a dangerous build and grows by one while the
+        shortest rebuild period stays at least three times as long.
+
+        Changes are printed at notice level 3, and the final values are listed in the neighbor list statistics at
+        the end of each :py:func:`hoomd.run()`.
+
+        Note:
+            Every change of r_buff forces a neighbor list build. Choose *period* long enough that this cost and the
+            noise of the timings are small compared to the cost of *period* time steps.
+
+        Examples::
+
+            nl.autotune()
+            nl.autotune(r_min=0.2, r_max=0.8, period=5000)
+            nl.autotune(enable=False)
+        """
+        hoomd.util.print_status_line();
+
+        if self.cpp_nlist is None:
+            hoomd.context.msg.error('Bug in hoomd: cpp_nlist not set, please report\n');
+            raise RuntimeError('Error setting neighbor list parameters');
+
+        self.cpp_nlist.setAutotune(enable, r_min, r_max, int(period), tolerance, check_period);
+
 ## \internal
 # \brief %nlist r_cut matrix
 # \details
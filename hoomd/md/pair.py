@@ -409,6 +409,36 @@ class pair(force._force):
                 hoomd.context.msg.error("Invalid mode\n");
                 raise RuntimeError("Error changing parameters in pair force");
 
+    def set_threaded(self, threaded=True):
+        R""" Enable or disable threaded evaluation of the pair force on the CPU.
+
+        Args:
+            threaded (bool): Split the loop over particles over the TBB threads when True.
+
+        When enabled, the force computation uses all threads set with :py:func:`hoomd.option.set_num_threads()` or
+        ``--nthreads``. With a half neighbor list, each thread accumulates forces in a private buffer which are summed
+        at the end, so results differ from the serial computation by floating point round off.
+
+        Threaded evaluation is disabled by default and has no effect on the GPU.
+
+        Examples::
+
+            lj.set_threaded()
+            lj.set_threaded(False)
+
+        """
+        hoomd.util.print_status_line();
+
+        if not hasattr(self.cpp_force, "setThreaded"):
+            hoomd.context.msg.error("Threaded execution is not implemented for {}\n".format(self.__class__.__name__));
+            raise RuntimeError("Error changing parameters in pair force");
+
+        if threaded and not _hoomd.is_TBB_available():
+            hoomd.context.msg.warning("HOOMD was compiled without thread support, ignoring request for threaded execution.\n");
+            return;
+
+        self.cpp_force.setThreaded(bool(threaded));
+
     def process_coeff(self, coeff):
         hoomd.context.msg.error("Bug in hoomd, please report\n");
         raise RuntimeError("Error processing coefficients");
@@ -131,6 +131,28 @@ class analyze_log_query_tests (unittest.TestCase):
         hoomd.context.initialize();
 
 
+# test the timing quantities
+class analyze_log_time_tests (unittest.TestCase):
+    def setUp(self):
+        self.system = init.create_lattice(lattice.sc(a=1.3),n=[5,5,4]);
+        nl = md.nlist.cell();
+        self.pair = md.pair.lj(r_cut=2.5, nlist = nl);
+        self.pair.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group.all());
+
+    def test_query(self):
+        log = hoomd.analyze.log(quantities = ['time_pair_lj', 'time_nlist', 'time_integrate'], period = 10, filename=None);
+        hoomd.run(20);
+
+        self.assertGreater(log.query('time_pair_lj'), 0);
+        self.assertGreaterEqual(log.query('time_nlist'), 0);
+        self.assertGreater(log.query('time_integrate'), 0);
+
+    def tearDown(self):
+        self.pair = None;
+        hoomd.context.initialize();
+
 try:
     import h5py
 except ImportError:
@@ -177,6 +177,37 @@ class charge_pppm_twoparticle_tests (unittest.TestCase):
         del c
         del log
 
+    # threaded execution gives the same forces
+    def test_threaded(self):
+        all = group.all()
+        nl = md.nlist.cell()
+        c = md.charge.pppm(all, nlist = nl);
+        c.set_params(Nx=128, Ny=128, Nz=128, order=3, rcut=2.0);
+        c.set_threaded()
+        log = analyze.log(quantities = ['pppm_energy'], period = 1, filename=None);
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(all);
+        # trick to allow larger decompositions
+        nl.set_params(r_buff=0.1)
+        run(1);
+
+        self.assertAlmostEqual(c.forces[0].force[0], 0.00904953, 5)
+        self.assertAlmostEqual(c.forces[0].force[1], 0.0101797, 5)
+        self.assertAlmostEqual(c.forces[0].force[2], 0.0124804, 5)
+        self.assertAlmostEqual(c.forces[1].force[0], -0.00904953, 5)
+        self.assertAlmostEqual(c.forces[1].force[1], -0.0101797, 5)
+        self.assertAlmostEqual(c.forces[1].force[2], -0.0124804, 5)
+        self.assertAlmostEqual(log.query('pppm_energy'), -0.2441,4)
+
+        # switching back recreates the FFT plans
+        c.set_threaded(False)
+        run(1);
+        self.assertAlmostEqual(c.forces[0].force[0], 0.00904953, 5)
+
+        del all
+        del c
+        del log
+
     # Cannot test pppm multiple times currently because of implementation limitations
     ## test missing coefficients
     #def test_set_missing_coeff(self):
@@ -0,0 +1,95 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+import hoomd
+from hoomd import md
+hoomd.context.initialize()
+import unittest
+import numpy
+
+# tests comm.set_ghost_overlap
+class comm_overlap_tests (unittest.TestCase):
+    def setUp(self):
+        hoomd.context.initialize()
+
+    def run_lj(self, overlap):
+        hoomd.init.create_lattice(hoomd.lattice.sc(a=1.3),n=[8,8,8]);
+        nl = md.nlist.cell()
+        pair = md.pair.lj(r_cut=2.5, nlist = nl)
+        pair.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.langevin(hoomd.group.all(), seed=1, kT=1.0);
+        hoomd.comm.set_ghost_overlap(overlap)
+
+        log = hoomd.analyze.log(quantities = ['potential_energy', 'pressure'], period = 10, filename=None);
+        hoomd.run(100);
+        U = log.query('potential_energy');
+        P = log.query('pressure');
+
+        hoomd.context.initialize()
+        return U, P
+
+    # the overlap changes only the summation order of the forces
+    def test_same_trajectory(self):
+        U0, P0 = self.run_lj(False)
+        U1, P1 = self.run_lj(True)
+
+        self.assertNotEqual(U0, 0);
+        self.assertAlmostEqual(U0, U1, delta=1e-5*abs(U0));
+        self.assertAlmostEqual(P0, P1, delta=1e-5*abs(P0));
+
+    def run_lj_forces(self, overlap):
+        system = hoomd.init.create_lattice(hoomd.lattice.sc(a=1.3),n=[8,8,8]);
+
+        # displace the particles off the lattice so that the forces do not cancel
+        snap = system.take_snapshot()
+        if hoomd.comm.get_rank() == 0:
+            numpy.random.seed(10)
+            snap.particles.position[:] += numpy.random.uniform(-0.1, 0.1, size=(snap.particles.N, 3))
+        system.restore_snapshot(snap)
+
+        nl = md.nlist.cell()
+        pair = md.pair.lj(r_cut=2.5, nlist = nl)
+        pair.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.001);
+        md.integrate.nve(hoomd.group.all());
+        hoomd.comm.set_ghost_overlap(overlap)
+
+        hoomd.run(20);
+        F = [p.force for p in pair.forces]
+        E = [p.energy for p in pair.forces]
+
+        hoomd.context.initialize()
+        return F, E
+
+    # the particles with ghost neighbors get their forces on the steps the overlap is used
+    def test_same_forces(self):
+        F0, E0 = self.run_lj_forces(False)
+        F1, E1 = self.run_lj_forces(True)
+
+        self.assertEqual(len(F0), len(F1));
+        for f0, f1, e0, e1 in zip(F0, F1, E0, E1):
+            self.assertAlmostEqual(e0, e1, 5);
+            for i in range(3):
+                self.assertAlmostEqual(f0[i], f1[i], 5);
+
+    # the overlap can be toggled between runs
+    def test_toggle(self):
+        hoomd.init.create_lattice(hoomd.lattice.sc(a=1.3),n=[8,8,8]);
+        nl = md.nlist.cell()
+        pair = md.pair.lj(r_cut=2.5, nlist = nl)
+        pair.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(hoomd.group.all());
+
+        hoomd.comm.set_ghost_overlap(True)
+        hoomd.run(10);
+        hoomd.comm.set_ghost_overlap(False)
+        hoomd.run(10);
+
+    # overlap requires an initialized system
+    def test_before_init(self):
+        self.assertRaises(RuntimeError, hoomd.comm.set_ghost_overlap, True)
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -5,6 +5,7 @@ from hoomd import *
 from hoomd import md
 context.initialize()
 import unittest
+import threaded_force
 import os
 import numpy
 
@@ -60,6 +61,21 @@ class dihedral_harmonic_tests (unittest.TestCase):
         md.integrate.nve(all);
         run(100);
 
+    # test threaded execution
+    def test_set_threaded(self):
+        dihedral_harmonic = md.dihedral.harmonic();
+        dihedral_harmonic.dihedral_coeff.set('dihedralA', k=1.0, d=1, n=4, phi_0=0)
+        threaded_force.assert_threaded_matches_serial(self, dihedral_harmonic);
+
+        harmonic.set_threaded();
+        run(1);
+        f_threaded = [p.force for p in harmonic.forces];
+        harmonic.set_threaded(False);
+
+        for a, b in zip(f_serial, f_threaded):
+            for k in range(3):
+                self.assertAlmostEqual(a[k], b[k], 5);
+
     # test coefficient not set checking
     def test_set_coeff_fail(self):
         harmonic = md.dihedral.harmonic();
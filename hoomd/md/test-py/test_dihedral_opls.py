@@ -5,6 +5,7 @@ from hoomd import *
 from hoomd import md
 context.initialize()
 import unittest
+import threaded_force
 import os
 import numpy
 
@@ -52,6 +53,21 @@ class dihedral_opls_tests (unittest.TestCase):
         md.integrate.nve(all);
         run(100);
 
+    # test threaded execution
+    def test_set_threaded(self):
+        dihedral_opls = md.dihedral.opls();
+        dihedral_opls.dihedral_coeff.set('dihedralA', k1=1.0, k2=2.0, k3=3.0, k4=4.0)
+        threaded_force.assert_threaded_matches_serial(self, dihedral_opls);
+
+        oplsdi.set_threaded();
+        run(1);
+        f_threaded = [p.force for p in oplsdi.forces];
+        oplsdi.set_threaded(False);
+
+        for a, b in zip(f_serial, f_threaded):
+            for k in range(3):
+                self.assertAlmostEqual(a[k], b[k], 5);
+
     # test coefficient not set checking
     def test_set_coeff_fail(self):
         oplsdi = md.dihedral.opls();
@@ -5,6 +5,7 @@ from hoomd import *
 from hoomd import md
 context.initialize()
 import unittest
+import threaded_force
 import os
 import math
 import numpy
@@ -59,6 +60,21 @@ class dihedral_table_tests (unittest.TestCase):
         md.integrate.nve(all);
         run(100);
 
+    # test threaded execution
+    def test_set_threaded(self):
+        dihedral_table = md.dihedral.table(width=1000);
+        dihedral_table.dihedral_coeff.set('dihedralA', func=lambda theta: (0.5*(1 + math.cos(theta)), 0.5*math.sin(theta)), coeff=dict())
+        threaded_force.assert_threaded_matches_serial(self, dihedral_table);
+
+        harmonic.set_threaded();
+        run(1);
+        f_threaded = [p.force for p in harmonic.forces];
+        harmonic.set_threaded(False);
+
+        for a, b in zip(f_serial, f_threaded):
+            for k in range(3):
+                self.assertAlmostEqual(a[k], b[k], 5);
+
     # test coefficient not set checking
     def test_set_coeff_fail(self):
         harmonic = md.dihedral.table(width=123)
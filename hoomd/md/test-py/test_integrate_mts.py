@@ -0,0 +1,62 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+from hoomd import md
+context.initialize()
+import unittest
+import os
+
+# tests multiple time step integration with force._force.set_mts_period
+class integrate_mts_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        self.s = init.create_lattice(lattice.sc(a=2.1878096788957757),n=[5,5,4]); #target a packing fraction of 0.05
+
+        context.current.sorter.set_params(grid=8)
+
+    # test that the default period is one
+    def test_default(self):
+        const = md.force.constant(fx=1.0, fy=0.5, fz=0.74);
+        self.assertEqual(const.cpp_force.getMTSPeriod(), 1);
+
+    # test setting the period
+    def test_set_period(self):
+        const = md.force.constant(fx=1.0, fy=0.5, fz=0.74);
+        const.set_mts_period(4);
+        self.assertEqual(const.cpp_force.getMTSPeriod(), 4);
+        self.assertRaises(ValueError, const.set_mts_period, 0);
+
+    # test that the impulse over a whole period matches the force applied every step
+    def test_impulse(self):
+        # multiple time step integration is not supported on the GPU
+        if context.exec_conf.isCUDAEnabled():
+            return;
+
+        const = md.force.constant(fx=1.0, fy=0.5, fz=-0.5);
+        const.set_mts_period(2);
+
+        dt = 0.005;
+        md.integrate.mode_standard(dt=dt);
+        md.integrate.nve(group=group.all());
+
+        # the impulse of the step 0 evaluation is applied in the first half step
+        run(1);
+        v = self.s.particles[0].velocity;
+        self.assertAlmostEqual(v[0], 1.0*dt, 5);
+        self.assertAlmostEqual(v[1], 0.5*dt, 5);
+        self.assertAlmostEqual(v[2], -0.5*dt, 5);
+
+        # after full periods, the velocity is the same as with the force applied every step
+        run(3);
+        v = self.s.particles[0].velocity;
+        self.assertAlmostEqual(v[0], 4*1.0*dt, 5);
+        self.assertAlmostEqual(v[1], 4*0.5*dt, 5);
+        self.assertAlmostEqual(v[2], 4*-0.5*dt, 5);
+
+    def tearDown(self):
+        self.s = None
+        context.initialize();
+
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
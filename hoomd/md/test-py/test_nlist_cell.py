@@ -46,6 +46,48 @@ class nlist_cell_tests (unittest.TestCase):
     def test_tune(self):
         self.nl.tune(warmup=100, r_min=0.1, r_max=0.25, jumps=10, steps=50)
 
+    # test online tuning
+    def test_autotune(self):
+        lj = md.pair.lj(r_cut = 2.5, nlist = self.nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+
+        self.nl.autotune(r_min=0.1, r_max=0.5, period=10)
+        run(200)
+        r_buff = self.nl.cpp_nlist.getRBuff()
+        self.assertGreaterEqual(r_buff, 0.1)
+        self.assertLessEqual(r_buff, 0.5)
+        self.assertGreaterEqual(self.nl.cpp_nlist.getEvery(), 1)
+
+        # values stay fixed once tuning is disabled
+        self.nl.autotune(enable=False)
+        run(50)
+        self.assertAlmostEqual(self.nl.cpp_nlist.getRBuff(), r_buff, places=5)
+
+    # test that the cluster pair list gives the same energy as the regular list
+    def test_cluster_pairs(self):
+        self.nl.set_cluster_pairs()
+        nl2 = md.nlist.cell()
+
+        lj1 = md.pair.lj(r_cut = 2.5, nlist = self.nl)
+        lj1.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        lj2 = md.pair.lj(r_cut = 2.5, nlist = nl2)
+        lj2.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+
+        run(10)
+        self.assertAlmostEqual(lj1.get_energy(group.all()), lj2.get_energy(group.all()), places=3)
+
+        self.nl.set_cluster_pairs(False)
+        run(1)
+
+    # test online tuning error messages
+    def test_autotune_nowork(self):
+        self.assertRaises(RuntimeError, self.nl.autotune, r_min=0.5, r_max=0.1)
+        self.assertRaises(RuntimeError, self.nl.autotune, period=0)
+
     # test multiple neighbor lists can coexist with different parameters
     def test_multi(self):
         self.nl.set_params(r_buff = 0.3)
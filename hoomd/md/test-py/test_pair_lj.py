@@ -40,6 +40,25 @@ class pair_lj_tests (unittest.TestCase):
         lj.set_params(mode="xplor");
         self.assertRaises(RuntimeError, lj.set_params, mode="blah");
 
+    # test threaded execution
+    def test_set_threaded(self):
+        lj = md.pair.lj(r_cut=3.0, nlist = self.nl);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        all = group.all();
+        md.integrate.mode_standard(dt=0);
+        md.integrate.nve(all);
+        run(1);
+        f_serial = [p.force for p in lj.forces];
+
+        lj.set_threaded();
+        run(1);
+        f_threaded = [p.force for p in lj.forces];
+        lj.set_threaded(False);
+
+        for a, b in zip(f_serial, f_threaded):
+            for k in range(3):
+                self.assertAlmostEqual(a[k], b[k], 5);
+
     # test default coefficients
     def test_default_coeff(self):
         lj = md.pair.lj(r_cut=3.0, nlist = self.nl);
@@ -0,0 +1,43 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+# helper shared by the tests of the threaded bonded force computes, not a test itself
+
+from hoomd import *
+from hoomd import md
+
+def assert_threaded_matches_serial(test, force):
+    R""" Check that the threaded force compute gives the same result as the serial one.
+
+    Args:
+        test (unittest.TestCase): Test case that reports the failures.
+        force: Force compute with its coefficients set.
+
+    Compares the forces on all particles, the energy of all particles, and the pressure, which includes the virial
+    of *force*. Sums are accumulated in a different order by the threads, so energy and pressure are compared
+    relative to their magnitude.
+    """
+    all = group.all();
+    md.integrate.mode_standard(dt=0);
+    md.integrate.nve(all);
+    logger = analyze.log(filename=None, quantities=['pressure'], period=1);
+
+    run(1);
+    f_serial = [p.force for p in force.forces];
+    e_serial = force.get_energy(all);
+    p_serial = logger.query('pressure');
+
+    force.set_threaded();
+    run(1);
+    f_threaded = [p.force for p in force.forces];
+    e_threaded = force.get_energy(all);
+    p_threaded = logger.query('pressure');
+    force.set_threaded(False);
+
+    test.assertEqual(len(f_serial), len(f_threaded));
+    for a, b in zip(f_serial, f_threaded):
+        for k in range(3):
+            test.assertAlmostEqual(a[k], b[k], 5);
+
+    test.assertAlmostEqual(e_serial, e_threaded, delta=1e-5*max(1.0, abs(e_serial)));
+    test.assertAlmostEqual(p_serial, p_threaded, delta=1e-5*max(1.0, abs(p_serial)));
@@ -0,0 +1,178 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <memory>
+
+#include "hoomd/Integrator.h"
+#include "hoomd/md/AllPairPotentials.h"
+#include "hoomd/md/NeighborListBinned.h"
+#include "hoomd/md/NeighborListStencil.h"
+#include "hoomd/md/NeighborListTree.h"
+
+#ifdef ENABLE_CUDA
+#include "hoomd/md/NeighborListGPUBinned.h"
+#include "hoomd/md/NeighborListGPUStencil.h"
+#include "hoomd/md/NeighborListGPUTree.h"
+#endif
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+#include "hoomd/test/benchmark_util.h"
+
+using namespace std;
+
+/*! \file benchmark_md.cc
+    \brief Benchmarks the neighbor lists, the LJ pair force, the net force sum, and the ghost exchange
+    \ingroup unit_tests
+*/
+HOOMD_BENCHMARK_MAIN("md");
+
+//! Integrator that exposes the net force summation for benchmarking
+class NetForceIntegrator : public Integrator
+    {
+    public:
+        //! Constructor
+        NetForceIntegrator(std::shared_ptr<SystemDefinition> sysdef)
+            : Integrator(sysdef, Scalar(0.005))
+            {
+            }
+
+        //! Sum the forces of all force computes
+        void sumNetForce(unsigned int timestep)
+            {
+#ifdef ENABLE_CUDA
+            if (m_exec_conf->isCUDAEnabled())
+                {
+                computeNetForceGPU(timestep);
+                return;
+                }
+#endif
+            computeNetForce(timestep);
+            }
+    };
+
+//! Cutoff radius of the LJ potential
+const Scalar r_cut = Scalar(2.5);
+
+//! Neighbor list buffer
+const Scalar r_buff = Scalar(0.4);
+
+//! Set up an LJ pair potential on the given neighbor list
+template <class PP>
+std::shared_ptr<PotentialPairLJ> make_lj(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<NeighborList> nlist)
+    {
+    std::shared_ptr<PotentialPairLJ> lj(new PP(sysdef, nlist));
+    Scalar epsilon = Scalar(1.0);
+    Scalar sigma = Scalar(1.0);
+    Scalar lj1 = Scalar(4.0) * epsilon * pow(sigma,Scalar(12.0));
+    Scalar lj2 = Scalar(4.0) * epsilon * pow(sigma,Scalar(6.0));
+    lj->setParams(0,0,make_scalar2(lj1,lj2));
+    lj->setRcut(0,0,r_cut);
+    return lj;
+    }
+
+//! Benchmark one neighbor list variant
+template <class NL>
+std::shared_ptr<NeighborList> benchmark_nlist(BenchmarkRunner& runner,
+                                              const std::string& name,
+                                              std::shared_ptr<SystemDefinition> sysdef,
+                                              unsigned int N,
+                                              Scalar density)
+    {
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, r_cut, r_buff));
+    nlist->setStorageMode(NeighborList::half);
+
+    runner.measure(name + "::buildNlist", N, density,
+        [nlist](unsigned int num_iters) { return nlist->benchmark(num_iters); });
+
+    return nlist;
+    }
+
+//! Benchmark all code paths at one particle count and density
+template <class NLBinned, class NLStencil, class NLTree, class PP>
+void benchmark_md(BenchmarkRunner& runner, unsigned int N, Scalar density)
+    {
+    std::shared_ptr<SystemDefinition> sysdef = make_lattice_system(N, density, runner.getExecConf());
+
+    std::shared_ptr<NeighborList> nlist
+        = benchmark_nlist<NLBinned>(runner, "NeighborListBinned", sysdef, N, density);
+    benchmark_nlist<NLStencil>(runner, "NeighborListStencil", sysdef, N, density);
+    benchmark_nlist<NLTree>(runner, "NeighborListTree", sysdef, N, density);
+
+    // the pair force reuses the (already built) binned neighbor list at timestep 0
+    std::shared_ptr<PotentialPairLJ> lj = make_lj<PP>(sysdef, nlist);
+    runner.measure("PotentialPairLJ::computeForces", N, density,
+        [lj](unsigned int num_iters) { return lj->benchmark(num_iters); });
+
+    // the force computes are up to date at a fixed timestep, so this times only the summation
+    std::shared_ptr<NetForceIntegrator> integrator(new NetForceIntegrator(sysdef));
+    integrator->addForceCompute(lj);
+    runner.measure("Integrator::computeNetForce", N, density,
+        [integrator, &runner](unsigned int num_iters)
+            {
+            return benchmark_calls([integrator]() { integrator->sumNetForce(0); },
+                                   num_iters, runner.getExecConf());
+            });
+    }
+
+#ifdef ENABLE_MPI
+//! Benchmark the ghost exchange at one particle count and density
+void benchmark_exchange_ghosts(BenchmarkRunner& runner, unsigned int N, Scalar density)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf = runner.getExecConf();
+    Scalar L = pow(Scalar(N) / density, Scalar(1.0/3.0));
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, make_scalar3(L,L,L)));
+    std::shared_ptr<SystemDefinition> sysdef = make_lattice_system(N, density, exec_conf, decomposition);
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+
+    // the neighbor list requests the ghost layer width
+    std::shared_ptr<NeighborList> nlist(new NeighborListTree(sysdef, r_cut, r_buff));
+    nlist->setCommunicator(comm);
+
+    comm->migrateParticles();
+
+    runner.measure("Communicator::exchangeGhosts", N, density,
+        [comm, pdata, &runner](unsigned int num_iters)
+            {
+            return benchmark_calls([comm, pdata]()
+                {
+                pdata->removeAllGhostParticles();
+                comm->exchangeGhosts();
+                }, num_iters, runner.getExecConf());
+            });
+    }
+#endif
+
+void run_benchmarks(BenchmarkRunner& runner)
+    {
+    for (unsigned int N : runner.getN())
+        for (Scalar density : runner.getDensities())
+            {
+#ifdef ENABLE_MPI
+            if (runner.getExecConf()->getNRanks() > 1)
+                {
+                benchmark_exchange_ghosts(runner, N, density);
+                continue;
+                }
+#endif
+
+#ifdef ENABLE_CUDA
+            if (runner.getExecConf()->isCUDAEnabled())
+                {
+                benchmark_md<NeighborListGPUBinned, NeighborListGPUStencil, NeighborListGPUTree, PotentialPairLJGPU>(
+                    runner, N, density);
+                continue;
+                }
+#endif
+            benchmark_md<NeighborListBinned, NeighborListStencil, NeighborListTree, PotentialPairLJ>(
+                runner, N, density);
+            }
+    }
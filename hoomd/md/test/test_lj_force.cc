@@ -538,6 +538,68 @@ std::shared_ptr<PotentialPairLJ> base_class_lj_creator(std::shared_ptr<SystemDef
     return std::shared_ptr<PotentialPairLJ>(new PotentialPairLJ(sysdef, nlist));
     }
 
+//! LJForceCompute creator with batched evaluation disabled
+std::shared_ptr<PotentialPairLJ> scalar_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                  std::shared_ptr<NeighborList> nlist)
+    {
+    std::shared_ptr<PotentialPairLJ> lj(new PotentialPairLJ(sysdef, nlist));
+    lj->setBatched(false);
+    return lj;
+    }
+
+//! LJForceCompute creator with the energy shifted to 0 at the cutoff
+std::shared_ptr<PotentialPairLJ> shift_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                  std::shared_ptr<NeighborList> nlist)
+    {
+    std::shared_ptr<PotentialPairLJ> lj(new PotentialPairLJ(sysdef, nlist));
+    lj->setShiftMode(PotentialPairLJ::shift);
+    return lj;
+    }
+
+//! LJForceCompute creator with the energy shifted to 0 at the cutoff and batched evaluation disabled
+std::shared_ptr<PotentialPairLJ> scalar_shift_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                  std::shared_ptr<NeighborList> nlist)
+    {
+    std::shared_ptr<PotentialPairLJ> lj = shift_lj_creator(sysdef, nlist);
+    lj->setBatched(false);
+    return lj;
+    }
+
+//! LJForceCompute creator that evaluates the cluster pair list
+std::shared_ptr<PotentialPairLJ> cluster_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                   std::shared_ptr<NeighborList> nlist)
+    {
+    nlist->setClusterPairs(true);
+    return std::shared_ptr<PotentialPairLJ>(new PotentialPairLJ(sysdef, nlist));
+    }
+
+//! LJForceCompute creator that evaluates the cluster pair list of a full neighbor list
+std::shared_ptr<PotentialPairLJ> cluster_full_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                        std::shared_ptr<NeighborList> nlist)
+    {
+    nlist->setStorageMode(NeighborList::full);
+    return cluster_lj_creator(sysdef, nlist);
+    }
+
+#ifdef ENABLE_TBB
+//! LJForceCompute creator with threaded execution enabled
+std::shared_ptr<PotentialPairLJ> threaded_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                  std::shared_ptr<NeighborList> nlist)
+    {
+    std::shared_ptr<PotentialPairLJ> lj(new PotentialPairLJ(sysdef, nlist));
+    lj->setThreaded(true);
+    return lj;
+    }
+
+//! LJForceCompute creator with threaded execution and a full neighbor list
+std::shared_ptr<PotentialPairLJ> threaded_full_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                  std::shared_ptr<NeighborList> nlist)
+    {
+    nlist->setStorageMode(NeighborList::full);
+    return threaded_lj_creator(sysdef, nlist);
+    }
+#endif
+
 #ifdef ENABLE_CUDA
 //! LJForceComputeGPU creator for unit tests
 std::shared_ptr<PotentialPairLJGPU> gpu_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
@@ -570,6 +632,70 @@ UP_TEST( PotentialPairLJ_shift )
     lj_force_shift_test(lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for comparing batched and scalar evaluation on the CPU
+UP_TEST( PotentialPairLJ_batch_compare )
+    {
+    ljforce_creator lj_creator_scalar = bind(scalar_lj_creator, _1, _2);
+    ljforce_creator lj_creator_base = bind(base_class_lj_creator, _1, _2);
+    lj_force_comparison_test(lj_creator_scalar, lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for comparing batched and scalar evaluation of the shifted potential on the CPU
+UP_TEST( PotentialPairLJ_batch_shift_compare )
+    {
+    ljforce_creator lj_creator_scalar = bind(scalar_shift_lj_creator, _1, _2);
+    ljforce_creator lj_creator_shift = bind(shift_lj_creator, _1, _2);
+    lj_force_comparison_test(lj_creator_scalar, lj_creator_shift, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for periodic test with the cluster pair list
+UP_TEST( PotentialPairLJ_cluster_periodic )
+    {
+    ljforce_creator lj_creator_cluster = bind(cluster_lj_creator, _1, _2);
+    lj_force_periodic_test(lj_creator_cluster, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for comparing the cluster pair evaluation (half neighbor list) to scalar evaluation
+UP_TEST( PotentialPairLJ_cluster_compare )
+    {
+    ljforce_creator lj_creator_scalar = bind(scalar_lj_creator, _1, _2);
+    ljforce_creator lj_creator_cluster = bind(cluster_lj_creator, _1, _2);
+    lj_force_comparison_test(lj_creator_scalar, lj_creator_cluster, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for comparing the cluster pair evaluation (full neighbor list) to scalar evaluation
+UP_TEST( PotentialPairLJ_cluster_full_compare )
+    {
+    ljforce_creator lj_creator_scalar = bind(scalar_lj_creator, _1, _2);
+    ljforce_creator lj_creator_cluster = bind(cluster_full_lj_creator, _1, _2);
+    lj_force_comparison_test(lj_creator_scalar, lj_creator_cluster, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_TBB
+//! test case for particle test with threaded execution
+UP_TEST( PotentialPairLJ_threaded_particle )
+    {
+    ljforce_creator lj_creator_threaded = bind(threaded_lj_creator, _1, _2);
+    lj_force_particle_test(lj_creator_threaded, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for comparing threaded output (half neighbor list) to the serial output
+UP_TEST( PotentialPairLJ_threaded_compare )
+    {
+    ljforce_creator lj_creator_base = bind(base_class_lj_creator, _1, _2);
+    ljforce_creator lj_creator_threaded = bind(threaded_lj_creator, _1, _2);
+    lj_force_comparison_test(lj_creator_base, lj_creator_threaded, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for comparing threaded output (full neighbor list) to the serial output
+UP_TEST( PotentialPairLJ_threaded_full_compare )
+    {
+    ljforce_creator lj_creator_base = bind(base_class_lj_creator, _1, _2);
+    ljforce_creator lj_creator_threaded = bind(threaded_full_lj_creator, _1, _2);
+    lj_force_comparison_test(lj_creator_base, lj_creator_threaded, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 # ifdef ENABLE_CUDA
 //! test case for particle test on GPU
 UP_TEST( LJForceGPU_particle )
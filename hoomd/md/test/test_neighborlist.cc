@@ -15,6 +15,7 @@
 #include "hoomd/md/NeighborListStencil.h"
 #include "hoomd/md/NeighborListTree.h"
 #include "hoomd/Initializers.h"
+#include "hoomd/SnapshotSystemData.h"
 
 #ifdef ENABLE_CUDA
 #include "hoomd/md/NeighborListGPU.h"
@@ -989,6 +990,83 @@ void neighborlist_comparison_test(std::shared_ptr<ExecutionConfiguration> exec_c
         }
     }
 
+#ifdef ENABLE_TBB
+//! Test that the threaded build of NeighborListBinned and its cell list matches the serial build exactly
+void neighborlist_threaded_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // construct a dense particle system with two types, so that the neighbor list overflows and is reallocated
+    RandomInitializer init(2000, Scalar(0.2), Scalar(0.8), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = init.getSnapshot();
+    snap->particle_data.type_mapping.push_back("B");
+    for (unsigned int i = 0; i < snap->particle_data.size; i += 3)
+        snap->particle_data.type[i] = 1;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<CellList> cl_serial(new CellList(sysdef));
+    std::shared_ptr<CellList> cl_threaded(new CellList(sysdef));
+
+    std::shared_ptr<NeighborList> nlist_serial(new NeighborListBinned(sysdef, Scalar(3.0), Scalar(0.4), cl_serial));
+    std::shared_ptr<NeighborList> nlist_threaded(new NeighborListBinned(sysdef, Scalar(3.0), Scalar(0.4), cl_threaded));
+    std::shared_ptr<NeighborList> nlists[] = {nlist_serial, nlist_threaded};
+    for (unsigned int k = 0; k < 2; k++)
+        {
+        nlists[k]->setRCutPair(0,0,Scalar(3.0));
+        nlists[k]->setRCutPair(0,1,Scalar(2.0));
+        nlists[k]->setRCutPair(1,1,Scalar(1.5));
+        nlists[k]->setStorageMode(NeighborList::full);
+        for (unsigned int i = 0; i < pdata->getN()-1; i++)
+            nlists[k]->addExclusion(i,i+1);
+        }
+
+    exec_conf->setNumThreads(1);
+    nlist_serial->compute(0);
+    exec_conf->setNumThreads(4);
+    nlist_threaded->compute(0);
+    exec_conf->setNumThreads(1);
+
+    // the cell lists are identical, including the order of the particles in the cells
+        {
+        ArrayHandle<unsigned int> h_size_serial(cl_serial->getCellSizeArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_size_threaded(cl_threaded->getCellSizeArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_xyzf_serial(cl_serial->getXYZFArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_xyzf_threaded(cl_threaded->getXYZFArray(), access_location::host, access_mode::read);
+
+        Index2D cli = cl_serial->getCellListIndexer();
+        unsigned int ncell = cl_serial->getCellIndexer().getNumElements();
+        UP_ASSERT_EQUAL(cl_threaded->getCellIndexer().getNumElements(), ncell);
+        for (unsigned int cell = 0; cell < ncell; cell++)
+            {
+            UP_ASSERT_EQUAL(h_size_threaded.data[cell], h_size_serial.data[cell]);
+            for (unsigned int offset = 0; offset < h_size_serial.data[cell]; offset++)
+                UP_ASSERT_EQUAL(__scalar_as_int(h_xyzf_threaded.data[cli(offset, cell)].w),
+                                __scalar_as_int(h_xyzf_serial.data[cli(offset, cell)].w));
+            }
+        }
+
+    // the neighbor lists are identical, including the order of the neighbors
+    ArrayHandle<unsigned int> h_n_neigh_serial(nlist_serial->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist_serial(nlist_serial->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list_serial(nlist_serial->getHeadList(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh_threaded(nlist_threaded->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist_threaded(nlist_threaded->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list_threaded(nlist_threaded->getHeadList(), access_location::host, access_mode::read);
+
+    unsigned int n_pairs = 0;
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        UP_ASSERT_EQUAL(h_n_neigh_threaded.data[i], h_n_neigh_serial.data[i]);
+        for (unsigned int j = 0; j < h_n_neigh_serial.data[i]; j++)
+            UP_ASSERT_EQUAL(h_nlist_threaded.data[h_head_list_threaded.data[i] + j],
+                            h_nlist_serial.data[h_head_list_serial.data[i] + j]);
+        n_pairs += h_n_neigh_serial.data[i];
+        }
+
+    // the test is only meaningful with many neighbors
+    UP_ASSERT(n_pairs > 20*pdata->getN());
+    }
+#endif
+
 //! Test that a NeighborList can successfully exclude a ridiculously large number of particles
 template <class NL>
 void neighborlist_large_ex_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1303,6 +1381,13 @@ UP_TEST( NeighborListBinned_2d )
     {
     neighborlist_2d_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+#ifdef ENABLE_TBB
+//! threaded build test case for binned class
+UP_TEST( NeighborListBinned_threaded )
+    {
+    neighborlist_threaded_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
 
 ////////////////////
 // STENCIL CPU
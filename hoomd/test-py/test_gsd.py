@@ -224,6 +224,49 @@ class gsd_write_tests (unittest.TestCase):
             gsd.log['scalar'] = lambda step: 5
             self.assertRaises(RuntimeError, run, 1);
 
+    # tests asynchronous writes
+    def test_async(self):
+        gsd = dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, async_write=True,
+                       dynamic=['momentum']);
+        gsd.log['float32'] = lambda step: numpy.array([step], dtype=numpy.float32)
+        run(5);
+
+        # run() waits for the last frame
+        snap = data.gsd_snapshot(self.tmp_file, frame=4);
+        if comm.get_rank() == 0:
+            self.assertRaises(RuntimeError, data.gsd_snapshot, self.tmp_file, frame=5);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+
+        # write_restart completes the frame before returning
+        gsd.write_restart();
+        data.gsd_snapshot(self.tmp_file, frame=5);
+        gsd.flush();
+
+    # tests quantized positions and velocities
+    def test_precision(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, dynamic=['momentum'],
+                 precision=dict(position=1e-3, velocity=1e-2));
+        run(2);
+
+        snap = data.gsd_snapshot(self.tmp_file, frame=1);
+        if comm.get_rank() == 0:
+            numpy.testing.assert_allclose(snap.particles.position, self.snapshot.particles.position, rtol=0, atol=0.5e-3 + 1e-6);
+            numpy.testing.assert_allclose(snap.particles.velocity, self.snapshot.particles.velocity, rtol=0, atol=0.5e-2 + 1e-6);
+
+        # quantized frames cannot be appended to a file with exact frames
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True);
+        if comm.get_num_ranks() == 1:
+            self.assertRaises(RuntimeError, dump.gsd, filename=self.tmp_file, group=group.all(), period=None,
+                              precision=dict(position=1e-3));
+
+    # tests invalid precision arguments
+    def test_precision_invalid(self):
+        self.assertRaises(ValueError, dump.gsd, filename=self.tmp_file, group=group.all(), period=1,
+                          precision=dict(image=1));
+        self.assertRaises(ValueError, dump.gsd, filename=self.tmp_file, group=group.all(), period=1,
+                          precision=dict(position=0));
+
 
     def tearDown(self):
         if (hoomd.comm.get_rank()==0):
@@ -438,6 +481,57 @@ class gsd_read_tests (unittest.TestCase):
             numpy.testing.assert_array_equal(snap.pairs.group, self.snapshot.pairs.group);
 
 
+    # test that parallel writes produce the same per-particle data
+    def test_parallel(self):
+        # remove particle so that the particle tags are no longer contiguous
+        self.s.particles.remove(2)
+        self.snapshot = self.s.take_snapshot(all=True)
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True, parallel=True);
+
+        snap = data.gsd_snapshot(self.tmp_file, frame=0);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            self.assertEqual(snap.particles.types, self.snapshot.particles.types);
+
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.charge, self.snapshot.particles.charge);
+            numpy.testing.assert_array_equal(snap.particles.diameter, self.snapshot.particles.diameter);
+            numpy.testing.assert_array_equal(snap.particles.body, self.snapshot.particles.body);
+            numpy.testing.assert_array_equal(snap.particles.moment_inertia, self.snapshot.particles.moment_inertia);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.orientation, self.snapshot.particles.orientation);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.angmom, self.snapshot.particles.angmom);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+
+            self.assertEqual(snap.bonds.N, self.snapshot.bonds.N);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+
+    # test multiple frames written in parallel
+    def test_parallel_frames(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=1, overwrite=True, parallel=True, dynamic=['momentum']);
+        run(3);
+
+        # there is no integrator, every frame holds the initial particles
+        for frame in [0, -1]:
+            snap = data.gsd_snapshot(self.tmp_file, frame=frame);
+            if comm.get_rank() == 0:
+                self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+                self.assertEqual(snap.particles.types, self.snapshot.particles.types);
+                numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+                numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+                numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+
+        context.initialize();
+
+        system = init.read_gsd(filename=self.tmp_file, frame=-1);
+        snap = system.take_snapshot(all=True);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.types, self.snapshot.particles.types);
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+
     # tests init.read_gsd
     def test_read_gsd(self):
         dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True);
@@ -445,6 +539,24 @@ class gsd_read_tests (unittest.TestCase):
 
         init.read_gsd(filename=self.tmp_file, frame=-1);
 
+    # tests init.read_gsd with particles read on every rank
+    def test_read_gsd_parallel(self):
+        dump.gsd(filename=self.tmp_file, group=group.all(), period=None, overwrite=True, dynamic=['momentum']);
+        context.initialize();
+
+        system = init.read_gsd(filename=self.tmp_file, parallel=True);
+        snap = system.take_snapshot(all=True);
+
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, self.snapshot.particles.N);
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.snapshot.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.snapshot.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.position, self.snapshot.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.orientation, self.snapshot.particles.orientation);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.snapshot.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.image, self.snapshot.particles.image);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.snapshot.bonds.group);
+
     def tearDown(self):
         if comm.get_rank() == 0:
             os.remove(self.tmp_file);
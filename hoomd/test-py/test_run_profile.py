@@ -0,0 +1,61 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+import hoomd
+hoomd.context.initialize()
+import unittest
+import tempfile
+import json
+import os
+
+class run_profile_tests(unittest.TestCase):
+
+    def setUp(self):
+        hoomd.context.initialize()
+        sysdef = hoomd.init.create_lattice(unitcell=hoomd.lattice.sq(a=2.0),
+                                           n=[4,4]);
+        if hoomd.comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.test.json');
+            self.tmp_file = tmp[1];
+        else:
+            self.tmp_file = "invalid";
+
+    def read_trace(self):
+        with open(self.tmp_file) as f:
+            text = f.read().rstrip();
+        # the closing bracket is optional in the trace format
+        return json.loads(text.rstrip(',') + ']');
+
+    def test_profile(self):
+        hoomd.run(10, profile=True);
+        hoomd.run(10, profile=True, profile_period=5);
+
+    # hardware counters are optional, runs continue without them
+    def test_profile_counters(self):
+        hoomd.run(10, profile=True, profile_counters=True);
+
+    # only the sampled steps are traced, runs append to the same file
+    def test_trace(self):
+        hoomd.run(20, trace=self.tmp_file, profile_period=5);
+        hoomd.run(10, trace=self.tmp_file, profile_period=5);
+
+        if hoomd.comm.get_rank() == 0:
+            events = self.read_trace();
+            steps = [e for e in events if e['name'] == 'Step'];
+            self.assertEqual(len(steps), 6 * hoomd.comm.get_num_ranks());
+            for e in steps:
+                self.assertEqual(e['ph'], 'X');
+                self.assertGreaterEqual(e['dur'], 0);
+
+            ranks = set(e['pid'] for e in events);
+            self.assertEqual(ranks, set(range(hoomd.comm.get_num_ranks())));
+
+    def test_invalid_period(self):
+        self.assertRaises(ValueError, hoomd.run, 10, profile=True, profile_period=0);
+
+    def tearDown(self):
+        if hoomd.comm.get_rank() == 0:
+            os.remove(self.tmp_file);
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
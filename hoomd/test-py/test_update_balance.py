@@ -22,6 +22,18 @@ class load_balance_tests (unittest.TestCase):
         if hoomd.context.current.decomposition is not None:
             lb.set_params(x=True, y=True, z=True, tolerance=0.95, maxiter=1)
 
+    ## Test the time based cost model
+    def test_cost_time(self):
+        lb = hoomd.update.balance(cost='time', damping=0.5, period=10)
+        if hoomd.context.current.decomposition is not None:
+            lb.set_params(cost='particles', damping=0.0)
+            self.assertRaises(ValueError, lb.set_params, cost='neighbors')
+            self.assertRaises(RuntimeError, lb.set_params, damping=1.0)
+            lb.set_params(cost='time')
+
+        # without an integrator, there is no time measurement and the particle count is balanced
+        hoomd.run(25)
+
     def tearDown(self):
         hoomd.context.initialize()
 
@@ -0,0 +1,55 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <memory>
+
+#include "hoomd/CellList.h"
+
+#ifdef ENABLE_CUDA
+#include "hoomd/CellListGPU.h"
+#endif
+
+#include "benchmark_util.h"
+
+using namespace std;
+
+/*! \file benchmark_cell_list.cc
+    \brief Benchmarks CellList::compute over a range of particle counts and densities
+    \ingroup unit_tests
+*/
+HOOMD_BENCHMARK_MAIN("cell_list");
+
+//! Benchmark the cell list
+template <class CL>
+void benchmark_cell_list(BenchmarkRunner& runner, unsigned int N, Scalar density)
+    {
+    std::shared_ptr<SystemDefinition> sysdef = make_lattice_system(N, density, runner.getExecConf());
+
+    std::shared_ptr<CellList> cl(new CL(sysdef));
+    cl->setNominalWidth(Scalar(1.4));
+    cl->setRadius(1);
+    cl->setFlagIndex();
+
+    runner.measure("CellList::compute", N, density,
+        [cl](unsigned int num_iters) { return cl->benchmark(num_iters); });
+    }
+
+void run_benchmarks(BenchmarkRunner& runner)
+    {
+    for (unsigned int N : runner.getN())
+        for (Scalar density : runner.getDensities())
+            {
+#ifdef ENABLE_CUDA
+            if (runner.getExecConf()->isCUDAEnabled())
+                {
+                benchmark_cell_list<CellListGPU>(runner, N, density);
+                continue;
+                }
+#endif
+            benchmark_cell_list<CellList>(runner, N, density);
+            }
+    }
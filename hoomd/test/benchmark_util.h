@@ -0,0 +1,349 @@
+// Copyright (c) 2009-2019 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+/*! \file benchmark_util.h
+    \brief Helpers shared by the C++ microbenchmark executables
+    \details Each benchmark executable defines run_benchmarks(BenchmarkRunner&) and expands
+        HOOMD_BENCHMARK_MAIN() once. The runner parses the command line, provides the particle
+        counts and densities to sweep over, and collects the timings into a JSON report so that
+        results from different versions can be compared by scripts.
+    \note This file should be included only once and by a file that will
+        compile into a benchmark executable
+*/
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/ClockSource.h"
+#include "hoomd/HOOMDVersion.h"
+#include "hoomd/SystemDefinition.h"
+#include "hoomd/SnapshotSystemData.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//! Time repeated calls to a callable
+/*! \param f Callable to benchmark
+    \param num_iters Number of iterations to average over
+    \param exec_conf Execution configuration (used to synchronize the GPU)
+    \returns Milliseconds of execution time per call
+
+    This mirrors Compute::benchmark() for code paths that do not provide their own benchmark() method.
+    \a f is called once before timing starts to allocate memory and warm the caches.
+*/
+template<class F>
+double benchmark_calls(F f, unsigned int num_iters, std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    ClockSource t;
+
+    // warm up run
+    f();
+
+#ifdef ENABLE_CUDA
+    if(exec_conf->isCUDAEnabled())
+        {
+        cudaDeviceSynchronize();
+        CHECK_CUDA_ERROR();
+        }
+#endif
+
+    // benchmark
+    uint64_t start_time = t.getTime();
+    for (unsigned int i = 0; i < num_iters; i++)
+        f();
+
+#ifdef ENABLE_CUDA
+    if(exec_conf->isCUDAEnabled())
+        cudaDeviceSynchronize();
+#endif
+    uint64_t total_time_ns = t.getTime() - start_time;
+
+    // convert the run time to milliseconds
+    return double(total_time_ns) / 1e6 / double(num_iters);
+    }
+
+//! Options and results of one benchmark executable
+/*! Command line options:
+     - `--output=<file>` write the JSON report to a file instead of stdout
+     - `--iterations=<n>` number of calls to average over for each measurement
+     - `--repeat=<n>` number of measurements per benchmark point (the JSON reports all of them)
+     - `--N=<n1,n2,...>` particle counts to sweep over
+     - `--density=<d1,d2,...>` number densities to sweep over
+     - `--mode=cpu|gpu` execution mode
+     - `--quick` small particle counts and few iterations (for smoke testing)
+
+    Under MPI, every rank takes part in the measurements and rank 0 writes the report.
+*/
+class BenchmarkRunner
+    {
+    public:
+        //! Parse the command line and set up the execution configuration
+        BenchmarkRunner(int argc, char **argv, const std::string& suite)
+            : m_suite(suite), m_iterations(100), m_repeat(3), m_mode(ExecutionConfiguration::CPU)
+            {
+            m_N.push_back(4096);
+            m_N.push_back(32768);
+            m_N.push_back(262144);
+            m_density.push_back(0.4);
+            m_density.push_back(0.8);
+
+            for (int i = 1; i < argc; i++)
+                {
+                std::string arg(argv[i]);
+                if (arg == "--quick")
+                    {
+                    m_N = std::vector<unsigned int>(1, 1000);
+                    m_iterations = 5;
+                    m_repeat = 1;
+                    }
+                else if (startsWith(arg, "--output="))
+                    m_output = value(arg);
+                else if (startsWith(arg, "--iterations="))
+                    m_iterations = std::stoul(value(arg));
+                else if (startsWith(arg, "--repeat="))
+                    m_repeat = std::stoul(value(arg));
+                else if (startsWith(arg, "--N="))
+                    m_N = parseList<unsigned int>(value(arg));
+                else if (startsWith(arg, "--density="))
+                    m_density = parseList<Scalar>(value(arg));
+                else if (arg == "--mode=cpu")
+                    m_mode = ExecutionConfiguration::CPU;
+                else if (arg == "--mode=gpu")
+                    m_mode = ExecutionConfiguration::GPU;
+                else
+                    throw std::runtime_error("Unknown benchmark option " + arg);
+                }
+
+            if (m_iterations == 0 || m_repeat == 0)
+                throw std::runtime_error("Benchmark iterations and repeat must be positive");
+
+            m_exec_conf = std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(m_mode));
+            }
+
+        //! Get the execution configuration
+        std::shared_ptr<ExecutionConfiguration> getExecConf() const
+            {
+            return m_exec_conf;
+            }
+
+        //! Get the particle counts to sweep over
+        const std::vector<unsigned int>& getN() const
+            {
+            return m_N;
+            }
+
+        //! Get the number densities to sweep over
+        const std::vector<Scalar>& getDensities() const
+            {
+            return m_density;
+            }
+
+        //! Get the number of iterations to average over
+        unsigned int getIterations() const
+            {
+            return m_iterations;
+            }
+
+        //! Measure a benchmark point and record the result
+        /*! \param name Name of the benchmarked code path
+            \param N Number of particles
+            \param density Number density
+            \param f Callable that returns the milliseconds per call, measured over \a num_iters calls
+
+            \a f is called once for each of the --repeat measurements.
+        */
+        template<class F>
+        void measure(const std::string& name, unsigned int N, Scalar density, F f)
+            {
+            Result r;
+            r.name = name;
+            r.N = N;
+            r.density = density;
+            for (unsigned int i = 0; i < m_repeat; i++)
+                r.ms_per_call.push_back(f(m_iterations));
+            m_results.push_back(r);
+
+            if (m_exec_conf->isRoot())
+                {
+                std::cerr << m_suite << ": " << name << " N=" << N << " density=" << density
+                          << " " << r.ms_per_call.back() << " ms" << std::endl;
+                }
+            }
+
+        //! Write the JSON report
+        void write() const
+            {
+            if (!m_exec_conf->isRoot())
+                return;
+
+            std::ostringstream s;
+            s.precision(8);
+            s << "{\n";
+            s << "  \"suite\": \"" << m_suite << "\",\n";
+            s << "  \"hoomd_version\": \"" << HOOMD_VERSION << "\",\n";
+            s << "  \"git_sha1\": \"" << HOOMD_GIT_SHA1 << "\",\n";
+            s << "  \"compile_flags\": \"" << escape(hoomd_compile_flags()) << "\",\n";
+            s << "  \"mode\": \"" << (m_exec_conf->isCUDAEnabled() ? "gpu" : "cpu") << "\",\n";
+            s << "  \"num_ranks\": " << m_exec_conf->getNRanks() << ",\n";
+            s << "  \"num_threads\": " << m_exec_conf->getNumThreads() << ",\n";
+            s << "  \"iterations\": " << m_iterations << ",\n";
+            s << "  \"results\": [";
+            for (unsigned int i = 0; i < m_results.size(); i++)
+                {
+                const Result& r = m_results[i];
+                s << (i == 0 ? "\n" : ",\n");
+                s << "    {\"name\": \"" << r.name << "\", \"N\": " << r.N << ", \"density\": " << r.density
+                  << ", \"ms_per_call\": [";
+                for (unsigned int j = 0; j < r.ms_per_call.size(); j++)
+                    s << (j == 0 ? "" : ", ") << r.ms_per_call[j];
+                s << "]}";
+                }
+            s << "\n  ]\n}\n";
+
+            if (m_output.empty())
+                {
+                std::cout << s.str();
+                }
+            else
+                {
+                std::ofstream f(m_output.c_str());
+                if (!f.good())
+                    throw std::runtime_error("Unable to open benchmark output file " + m_output);
+                f << s.str();
+                }
+            }
+
+    private:
+        //! One benchmark point
+        struct Result
+            {
+            std::string name;                   //!< Name of the benchmarked code path
+            unsigned int N;                     //!< Number of particles
+            Scalar density;                     //!< Number density
+            std::vector<double> ms_per_call;    //!< Measured milliseconds per call, one per repeat
+            };
+
+        std::string m_suite;                                  //!< Name of this benchmark suite
+        std::string m_output;                                 //!< Output file name (empty for stdout)
+        unsigned int m_iterations;                            //!< Number of iterations to average over
+        unsigned int m_repeat;                                //!< Number of measurements per point
+        ExecutionConfiguration::executionMode m_mode;         //!< Execution mode
+        std::vector<unsigned int> m_N;                        //!< Particle counts
+        std::vector<Scalar> m_density;                        //!< Number densities
+        std::shared_ptr<ExecutionConfiguration> m_exec_conf;  //!< The execution configuration
+        std::vector<Result> m_results;                        //!< Collected results
+
+        static bool startsWith(const std::string& s, const std::string& prefix)
+            {
+            return s.compare(0, prefix.size(), prefix) == 0;
+            }
+
+        static std::string value(const std::string& arg)
+            {
+            return arg.substr(arg.find('=') + 1);
+            }
+
+        template<class T>
+        static std::vector<T> parseList(const std::string& s)
+            {
+            std::vector<T> result;
+            std::istringstream in(s);
+            std::string item;
+            while (std::getline(in, item, ','))
+                result.push_back(T(std::stod(item)));
+            if (result.empty())
+                throw std::runtime_error("Empty benchmark list " + s);
+            return result;
+            }
+
+        static std::string escape(const std::string& s)
+            {
+            std::string result;
+            for (char c : s)
+                {
+                if (c == '"' || c == '\\')
+                    result.push_back('\\');
+                if (c == '\n')
+                    result += "\\n";
+                else
+                    result.push_back(c);
+                }
+            return result;
+            }
+    };
+
+//! Create a system of N particles on a slightly perturbed simple cubic lattice
+/*! \param N Number of particles
+    \param density Number density
+    \param exec_conf Execution configuration
+    \param decomposition Domain decomposition (may be null)
+
+    Particles have unit diameter. Lattice sites are filled in order, so the system is homogeneous only
+    when N is a perfect cube. The perturbation is small enough that hard spheres do not overlap up to a
+    number density of 0.85.
+*/
+inline std::shared_ptr<SystemDefinition> make_lattice_system(unsigned int N,
+    Scalar density,
+    std::shared_ptr<ExecutionConfiguration> exec_conf,
+    std::shared_ptr<DomainDecomposition> decomposition=std::shared_ptr<DomainDecomposition>())
+    {
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap(new SnapshotSystemData<Scalar>());
+
+    Scalar L = pow(Scalar(N) / density, Scalar(1.0/3.0));
+    unsigned int n = (unsigned int)ceil(pow(Scalar(N), Scalar(1.0/3.0)) - Scalar(1e-6));
+    Scalar a = L / Scalar(n);
+    Scalar jitter = Scalar(0.02) * a;
+
+    snap->global_box = BoxDim(L);
+    snap->particle_data.resize(N);
+    snap->particle_data.type_mapping.push_back("A");
+
+    srand(12345);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        unsigned int ix = i % n;
+        unsigned int iy = (i / n) % n;
+        unsigned int iz = i / (n*n);
+        vec3<Scalar> r(-L/Scalar(2.0) + (Scalar(ix) + Scalar(0.5)) * a,
+                       -L/Scalar(2.0) + (Scalar(iy) + Scalar(0.5)) * a,
+                       -L/Scalar(2.0) + (Scalar(iz) + Scalar(0.5)) * a);
+        r.x += jitter * (Scalar(2.0) * Scalar(rand()) / Scalar(RAND_MAX) - Scalar(1.0));
+        r.y += jitter * (Scalar(2.0) * Scalar(rand()) / Scalar(RAND_MAX) - Scalar(1.0));
+        r.z += jitter * (Scalar(2.0) * Scalar(rand()) / Scalar(RAND_MAX) - Scalar(1.0));
+        snap->particle_data.pos[i] = r;
+        }
+
+    return std::shared_ptr<SystemDefinition>(new SystemDefinition(snap, exec_conf, decomposition));
+    }
+
+//! Entry point implemented by each benchmark executable
+void run_benchmarks(BenchmarkRunner& runner);
+
+#ifdef ENABLE_MPI
+#define HOOMD_BENCHMARK_MAIN(suite) \
+int main(int argc, char **argv) \
+    { \
+    MPI_Init(&argc, &argv); \
+        { \
+        BenchmarkRunner runner(argc, argv, suite); \
+        run_benchmarks(runner); \
+        runner.write(); \
+        } \
+    MPI_Finalize(); \
+    }
+#else
+#define HOOMD_BENCHMARK_MAIN(suite) \
+int main(int argc, char **argv) \
+    { \
+    BenchmarkRunner runner(argc, argv, suite); \
+    run_benchmarks(runner); \
+    runner.write(); \
+    }
+#endif
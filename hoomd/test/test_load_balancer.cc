@@ -359,6 +359,107 @@ void test_load_balancer_ghost(std::shared_ptr<ExecutionConfiguration> exec_conf,
     UP_ASSERT_EQUAL(pdata->getOwnerRank(7), di(1,0,1));
     }
 
+//! Load balancer with a synthetic compute time, particles in the upper half of the box cost three times as much
+template<class LB>
+class TimedLoadBalancer : public LB
+    {
+    public:
+        TimedLoadBalancer(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<DomainDecomposition> decomposition)
+            : LB(sysdef, decomposition)
+            {
+            }
+
+    protected:
+        virtual double getComputeTime()
+            {
+            ArrayHandle<Scalar4> h_pos(this->m_pdata->getPositions(), access_location::host, access_mode::read);
+
+            double t = 0.0;
+            for (unsigned int i = 0; i < this->m_pdata->getN(); ++i)
+                t += (h_pos.data[i].z > Scalar(0.0)) ? 3e-3 : 1e-3;
+            return t;
+            }
+    };
+
+template<class LB>
+void test_load_balancer_time(std::shared_ptr<ExecutionConfiguration> exec_conf)
+{
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    // create a system with a uniform lattice of 4096 particles
+    const unsigned int n = 16;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(n*n*n,        // number of particles
+                                                             BoxDim(2.0),   // box dimensions
+                                                             1,             // number of particle types
+                                                             0,             // number of bond types
+                                                             0,             // number of angle types
+                                                             0,             // number of dihedral types
+                                                             0,             // number of dihedral types
+                                                             exec_conf));
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    SnapshotParticleData<Scalar> snap(n*n*n);
+    pdata->takeSnapshot(snap);
+    for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int j = 0; j < n; ++j)
+            for (unsigned int k = 0; k < n; ++k)
+                {
+                snap.pos[(i*n+j)*n+k] = vec3<Scalar>(Scalar(-1.0) + (Scalar(i)+Scalar(0.5))*Scalar(2.0)/Scalar(n),
+                                                     Scalar(-1.0) + (Scalar(j)+Scalar(0.5))*Scalar(2.0)/Scalar(n),
+                                                     Scalar(-1.0) + (Scalar(k)+Scalar(0.5))*Scalar(2.0)/Scalar(n));
+                }
+
+    // initialize a 2x2x2 domain decomposition on processor with rank 0
+    std::vector<Scalar> fxs(1), fys(1), fzs(1);
+    fxs[0] = Scalar(0.5);
+    fys[0] = Scalar(0.5);
+    fzs[0] = Scalar(0.5);
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL(), fxs, fys, fzs));
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+    comm->migrateParticles();
+
+    // the particle count is balanced already, so only the time based cost model moves the domains
+    std::shared_ptr<LoadBalancer> lb(new TimedLoadBalancer<LB>(sysdef,decomposition));
+    lb->setCommunicator(comm);
+    lb->enableDimension(0, false);
+    lb->enableDimension(1, false);
+    lb->setDamping(Scalar(0.5));
+
+    for (unsigned int t=0; t < 10; ++t)
+        {
+        lb->update(t);
+        }
+    UP_ASSERT_EQUAL(pdata->getN(), 512);
+    MY_CHECK_CLOSE(decomposition->getCumulativeFractions(2)[1], Scalar(0.5), tol);
+
+    lb->setCostModel(LoadBalancer::compute_time);
+    for (unsigned int t=10; t < 50; ++t)
+        {
+        lb->update(t);
+        }
+
+    // the expensive upper domains shrink toward the balance point at a fraction of 2/3
+    Scalar frac_z = decomposition->getCumulativeFractions(2)[1];
+    UP_ASSERT(frac_z > Scalar(0.55));
+    UP_ASSERT(frac_z < Scalar(0.8));
+
+    uint3 grid_pos = decomposition->getGridPos();
+    if (grid_pos.z == 1)
+        {
+        UP_ASSERT(pdata->getN() < 512);
+        }
+    else
+        {
+        UP_ASSERT(pdata->getN() > 512);
+        }
+    }
+
 //! Tests basic particle redistribution
 UP_TEST( LoadBalancer_test_basic)
     {
@@ -395,6 +496,13 @@ UP_TEST( LoadBalancer_test_ghost)
     test_load_balancer_ghost<LoadBalancer>(exec_conf, BoxDim(1.0,-.6,.7,.5));
     }
 
+//! Tests balancing by the measured compute time
+UP_TEST( LoadBalancer_test_time)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    test_load_balancer_time<LoadBalancer>(exec_conf);
+    }
+
 #ifdef ENABLE_CUDA
 //! Tests basic particle redistribution on the GPU
 UP_TEST( LoadBalancerGPU_test_basic)
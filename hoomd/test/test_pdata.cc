@@ -17,6 +17,9 @@
 #include "hoomd/ParticleData.h"
 #include "hoomd/Initializers.h"
 #include "hoomd/SnapshotSystemData.h"
+#include "hoomd/SoAArrayHandle.h"
+#include "hoomd/SystemDefinition.h"
+#include "hoomd/SFCPackUpdater.h"
 
 using namespace std;
 
@@ -617,6 +620,248 @@ UP_TEST( ParticleData_test )
     UP_ASSERT(pdata_type_test.getTypeByName("test") == 1);
     }
 
+//! Checks that the position streams match the packed positions, element by element
+void check_soa_positions(std::shared_ptr<ParticleData> pdata)
+    {
+    // read the streams first, so that a stale mirror is not refreshed by a prior packed access
+    std::vector<Scalar4> soa(pdata->getN());
+    {
+    SoAArrayHandle h_soa(pdata->getPositions(), pdata->getPositionsSoA(), pdata->getN(), access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        soa[i] = make_scalar4(h_soa.x[i], h_soa.y[i], h_soa.z[i], h_soa.w[i]);
+    }
+
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        UP_ASSERT_EQUAL(soa[i].x, h_pos.data[i].x);
+        UP_ASSERT_EQUAL(soa[i].y, h_pos.data[i].y);
+        UP_ASSERT_EQUAL(soa[i].z, h_pos.data[i].z);
+        UP_ASSERT_EQUAL(__scalar_as_int(soa[i].w), __scalar_as_int(h_pos.data[i].w));
+        }
+    }
+
+//! Tests the structure-of-arrays view of the particle data
+UP_TEST( ParticleData_soa_test )
+    {
+    BoxDim box(10.0);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<ParticleData> pdata(new ParticleData(5, box, 2, exec_conf));
+
+    Scalar tol = Scalar(1e-6);
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::overwrite);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        h_pos.data[i] = make_scalar4(Scalar(i), Scalar(i) + Scalar(0.1), Scalar(i) + Scalar(0.2),
+                                     __int_as_scalar(i % 2));
+    }
+
+    // the streams are filled from the packed array
+    {
+    SoAArrayHandle h_pos(pdata->getPositions(), pdata->getPositionsSoA(), pdata->getN(), access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        MY_CHECK_CLOSE(h_pos.x[i], Scalar(i), tol);
+        MY_CHECK_CLOSE(h_pos.y[i], Scalar(i) + Scalar(0.1), tol);
+        MY_CHECK_CLOSE(h_pos.z[i], Scalar(i) + Scalar(0.2), tol);
+        UP_ASSERT_EQUAL(__scalar_as_int(h_pos.w[i]), int(i % 2));
+        }
+    }
+
+    // an unmodified array is not converted again
+    unsigned int write_count = pdata->getPositions().getWriteCount();
+    {
+    SoAArrayHandle h_pos(pdata->getPositions(), pdata->getPositionsSoA(), pdata->getN(), access_mode::read);
+    }
+    UP_ASSERT_EQUAL(pdata->getPositions().getWriteCount(), write_count);
+    UP_ASSERT(pdata->getPositionsSoA().source != NULL);
+    UP_ASSERT_EQUAL(pdata->getPositionsSoA().write_count, write_count);
+
+    // writes through an ArrayHandle are seen by the next read
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    h_pos.data[2].y = Scalar(-7.0);
+    }
+    UP_ASSERT(pdata->getPositions().getWriteCount() != write_count);
+
+    {
+    SoAArrayHandle h_pos(pdata->getPositions(), pdata->getPositionsSoA(), pdata->getN(), access_mode::read);
+    MY_CHECK_CLOSE(h_pos.y[2], -7.0, tol);
+    }
+
+    // modifications are written back
+    {
+    SoAArrayHandle h_pos(pdata->getPositions(), pdata->getPositionsSoA(), pdata->getN(), access_mode::readwrite);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        h_pos.x[i] = -h_pos.x[i];
+    }
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        MY_CHECK_CLOSE(h_pos.data[i].x, -Scalar(i), tol);
+        UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[i].w), int(i % 2));
+        }
+    MY_CHECK_CLOSE(h_pos.data[2].y, -7.0, tol);
+    }
+
+    // the written back streams are still current
+    check_soa_positions(pdata);
+
+    // overwrite ignores the old values
+    {
+    SoAArrayHandle h_vel(pdata->getVelocities(), pdata->getVelocitiesSoA(), pdata->getN(), access_mode::overwrite);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        h_vel.x[i] = Scalar(1.0);
+        h_vel.y[i] = Scalar(2.0);
+        h_vel.z[i] = Scalar(3.0);
+        h_vel.w[i] = Scalar(i+1);
+        }
+    }
+
+    {
+    ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        MY_CHECK_CLOSE(h_vel.data[i].x, 1.0, tol);
+        MY_CHECK_CLOSE(h_vel.data[i].y, 2.0, tol);
+        MY_CHECK_CLOSE(h_vel.data[i].z, 3.0, tol);
+        MY_CHECK_CLOSE(h_vel.data[i].w, Scalar(i+1), tol);
+        }
+    }
+
+    // swapping in a reordered copy, as the GPU particle sort does, is seen by the next read
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_pos_alt(pdata->getAltPositions(), access_location::host, access_mode::overwrite);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        h_pos_alt.data[i] = h_pos.data[pdata->getN() - 1 - i];
+    }
+    pdata->swapPositions();
+
+    {
+    SoAArrayHandle h_pos(pdata->getPositions(), pdata->getPositionsSoA(), pdata->getN(), access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        MY_CHECK_CLOSE(h_pos.x[i], -Scalar(pdata->getN() - 1 - i), tol);
+    }
+    check_soa_positions(pdata);
+
+    // swapping back to the array the mirror was filled from before is also seen
+    pdata->swapPositions();
+    check_soa_positions(pdata);
+
+    // the mirror grows with the particle data
+    for (unsigned int i = 0; i < 100; i++)
+        pdata->addParticle(0);
+    UP_ASSERT(pdata->getPositionsSoA().streams.getPitch() >= pdata->getMaxN());
+
+    {
+    SoAArrayHandle h_pos(pdata->getPositions(), pdata->getPositionsSoA(), pdata->getN(), access_mode::read);
+    MY_CHECK_CLOSE(h_pos.x[3], -3.0, tol);
+    UP_ASSERT_EQUAL(__scalar_as_int(h_pos.w[pdata->getN()-1]), 0);
+    }
+    check_soa_positions(pdata);
+    }
+
+//! Tests that the structure-of-arrays view follows the particle sort
+UP_TEST( ParticleData_soa_sort_test )
+    {
+    BoxDim box(10.0);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(64, box, 2, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    // place the particles on a lattice in the reverse of a space-filling order
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::overwrite);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        unsigned int j = pdata->getN() - 1 - i;
+        h_pos.data[i] = make_scalar4(Scalar(j % 4)*Scalar(2.5) - Scalar(3.75),
+                                     Scalar((j / 4) % 4)*Scalar(2.5) - Scalar(3.75),
+                                     Scalar(j / 16)*Scalar(2.5) - Scalar(3.75),
+                                     __int_as_scalar(i % 2));
+        }
+    }
+
+    // fill the mirror in the unsorted order
+    check_soa_positions(pdata);
+
+    std::vector<unsigned int> old_tags(pdata->getN());
+    {
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+    std::copy(h_tag.data, h_tag.data + pdata->getN(), old_tags.begin());
+    }
+
+    SFCPackUpdater sorter(sysdef);
+    sorter.update(0);
+
+    // the sort must have reordered the particles for the test to be meaningful
+    {
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+    UP_ASSERT(!std::equal(old_tags.begin(), old_tags.end(), h_tag.data));
+    }
+
+    check_soa_positions(pdata);
+    }
+
+#ifdef ENABLE_MPI
+//! Tests that the structure-of-arrays view follows the removal and addition of particles in a migration
+UP_TEST( ParticleData_soa_migrate_test )
+    {
+    BoxDim box(10.0);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<ParticleData> pdata(new ParticleData(8, box, 2, exec_conf));
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::overwrite);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        h_pos.data[i] = make_scalar4(Scalar(i), Scalar(0.5), Scalar(-0.5), __int_as_scalar(i % 2));
+    }
+
+    check_soa_positions(pdata);
+
+    // send away every other particle
+    {
+    ArrayHandle<unsigned int> h_comm_flags(pdata->getCommFlags(), access_location::host, access_mode::overwrite);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        h_comm_flags.data[i] = i % 2;
+    }
+
+    std::vector<pdata_element> out;
+    std::vector<unsigned int> comm_flags;
+    pdata->removeParticles(out, comm_flags);
+    UP_ASSERT_EQUAL(pdata->getN(), (unsigned int)4);
+    UP_ASSERT_EQUAL(out.size(), (size_t)4);
+    check_soa_positions(pdata);
+
+    {
+    SoAArrayHandle h_pos(pdata->getPositions(), pdata->getPositionsSoA(), pdata->getN(), access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        MY_CHECK_CLOSE(h_pos.x[i], Scalar(2*i), Scalar(1e-6));
+    }
+
+    // receive them back, displaced, after the particles that stayed
+    for (unsigned int k = 0; k < out.size(); k++)
+        out[k].pos.x += Scalar(0.25);
+    pdata->addParticles(out);
+    UP_ASSERT_EQUAL(pdata->getN(), (unsigned int)8);
+
+    {
+    SoAArrayHandle h_pos(pdata->getPositions(), pdata->getPositionsSoA(), pdata->getN(), access_mode::read);
+    for (unsigned int i = 0; i < 4; i++)
+        {
+        MY_CHECK_CLOSE(h_pos.x[i], Scalar(2*i), Scalar(1e-6));
+        MY_CHECK_CLOSE(h_pos.x[i+4], Scalar(2*i+1) + Scalar(0.25), Scalar(1e-6));
+        }
+    }
+    check_soa_positions(pdata);
+    }
+#endif
+
 //! Tests the RandomParticleInitializer class
 UP_TEST( Random_test )
     {
@@ -400,6 +400,8 @@ class balance(_updater):
         maxiter (int): Maximum number of iterations to attempt in a single step.
         period (int): Balancing will be attempted every \a period time steps
         phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+        cost (str): Measure of the load of a rank, ``'particles'`` or ``'time'``.
+        damping (float): Fraction of each proposed rescaling that is not applied (0 <= *damping* < 1).
 
     Every *period* steps, the boundaries of the processor domains are adjusted to distribute the particle load close
     to evenly between them. The load imbalance is defined as the number of particles owned by a rank divided by the
@@ -429,6 +431,21 @@ class balance(_updater):
     can attempt multiple iterations of balancing every *period*, and up to *maxiter* attempts can be made. The optimal
     values of *period* and *maxiter* will depend on your simulation.
 
+    When the cost per particle varies strongly across the box, for example for dense droplets in a vapor or rigid
+    bodies next to a solvent, balancing the particle count leaves the force computation unbalanced. With
+    ``cost='time'``, the load of a rank is instead its number of particles weighted by the measured wall-clock time
+    per particle that the integrator spent computing forces on that rank since the last balancing step. Particles that
+    move to another domain are counted with the time per particle measured on the domain that receives them, so several
+    balancing steps may be needed to converge. The first balancing step of a run has no measurement and balances the
+    particle count, as do all steps when the integrator does not compute forces (e.g., in HPMC).
+    Timing measurements are noisy, and a *damping* of about 0.5 avoids oscillating domain boundaries.
+
+    .. attention::
+        The measured time includes communication inside of force computes, such as the distributed FFT of
+        :py:class:`hoomd.md.charge.pppm`. A rank that finishes its share early then waits for the others and
+        appears as loaded as they are, so ``cost='time'`` balances poorly when such collectives dominate the force
+        computation.
+
     Load balancing can be performed independently and sequentially for each dimension of the simulation box. A small
     performance increase may be obtained by disabling load balancing along dimensions that are known to be homogeneous.
     For example, if there is a planar vapor-liquid interface normal to the :math:`z` axis, then it may be advantageous to
@@ -442,7 +459,7 @@ class balance(_updater):
 
     Balancing is ignored if there is no domain decomposition available (MPI is not built or is running on a single rank).
     """
-    def __init__(self, x=True, y=True, z=True, tolerance=1.02, maxiter=1, period=1000, phase=0):
+    def __init__(self, x=True, y=True, z=True, tolerance=1.02, maxiter=1, period=1000, phase=0, cost='particles', damping=0.0):
         hoomd.util.print_status_line();
 
         # initialize base class
@@ -462,16 +479,16 @@ class balance(_updater):
         self.setupUpdater(period,phase)
 
         # stash arguments to metadata
-        self.metadata_fields = ['tolerance','maxiter','period','phase']
+        self.metadata_fields = ['tolerance','maxiter','period','phase','cost','damping']
         self.period = period
         self.phase = phase
 
         # configure the parameters
         hoomd.util.quiet_status()
-        self.set_params(x,y,z,tolerance, maxiter)
+        self.set_params(x,y,z,tolerance, maxiter, cost, damping)
         hoomd.util.unquiet_status()
 
-    def set_params(self, x=None, y=None, z=None, tolerance=None, maxiter=None):
+    def set_params(self, x=None, y=None, z=None, tolerance=None, maxiter=None, cost=None, damping=None):
         R""" Change load balancing parameters.
 
         Args:
@@ -480,12 +497,15 @@ class balance(_updater):
             z (bool): If True, balance in z dimension.
             tolerance (float): Load imbalance tolerance (if <= 1.0, balance every step).
             maxiter (int): Maximum number of iterations to attempt in a single step.
+            cost (str): Measure of the load of a rank, ``'particles'`` or ``'time'``.
+            damping (float): Fraction of each proposed rescaling that is not applied (0 <= *damping* < 1).
 
 
         Examples::
 
             balance.set_params(x=True, y=False)
             balance.set_params(tolerance=0.02, maxiter=5)
+            balance.set_params(cost='time', damping=0.5)
         """
         hoomd.util.print_status_line()
         self.check_initialization()
@@ -502,6 +522,30 @@ class balance(_updater):
         if maxiter is not None:
             self.maxiter = maxiter
             self.cpp_updater.setMaxIterations(self.maxiter)
+        if cost is not None:
+            if cost == 'particles':
+                cpp_cost = _hoomd.LoadBalancer.costModel.particle_count
+            elif cost == 'time':
+                cpp_cost = _hoomd.LoadBalancer.costModel.compute_time
+            else:
+                hoomd.context.msg.error("update.balance: cost must be 'particles' or 'time'\n")
+                raise ValueError("Invalid load balancing cost model")
+            self.cost = cost
+            self.cpp_updater.setCostModel(cpp_cost)
+        if damping is not None:
+            self.damping = damping
+            self.cpp_updater.setDamping(self.damping)
+
+    ## \internal
+    # \brief Pass the current integrator to the C++ load balancer for the time measurement
+    def update_integrator(self):
+        if self.cpp_updater is None:
+            return
+
+        if hoomd.context.current.integrator is not None:
+            self.cpp_updater.setIntegrator(hoomd.context.current.integrator.cpp_integrator)
+        else:
+            self.cpp_updater.setIntegrator(None)
 
 # Global current id counter to assign updaters unique names
 _updater.cur_id = 0;